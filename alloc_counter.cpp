@@ -0,0 +1,68 @@
+// Allocation Counter Implementation
+// Replacement operator new/delete (malloc/free) with a thread-local allocation count
+
+#include "alloc_counter.h"
+
+#ifdef RUBIK_COUNT_ALLOCATIONS
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+// Zero-initialized, so it is usable before any static constructor runs
+thread_local std::uint64_t allocations = 0;
+
+void* countedAllocate(std::size_t size) {
+    allocations++;
+    return std::malloc(size ? size : 1);
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    void* pointer = countedAllocate(size);
+    if (!pointer) throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new[](std::size_t size) {
+    void* pointer = countedAllocate(size);
+    if (!pointer) throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAllocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAllocate(size);
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+
+bool allocationCountingEnabled() {
+    return true;
+}
+
+std::uint64_t threadAllocations() {
+    return allocations;
+}
+
+#else
+
+bool allocationCountingEnabled() {
+    return false;
+}
+
+std::uint64_t threadAllocations() {
+    return 0;
+}
+
+#endif
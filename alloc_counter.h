@@ -0,0 +1,31 @@
+// Allocation Counter Header
+// Optional global operator new/delete hook that counts heap allocations per thread
+//
+// Built with RUBIK_COUNT_ALLOCATIONS, alloc_counter.cpp replaces the global allocation
+// functions with ones that bump a thread-local counter. A replacement operator new is picked
+// up by any program that links the object file, whether or not it reads the counter, so
+// alloc_counter.cpp is not part of rubik_core: it is the rubik_alloc_counter object library,
+// linked into rubik_search only. Everything else keeps the default allocator.
+
+#ifndef ALLOC_COUNTER_H
+#define ALLOC_COUNTER_H
+
+#include <cstdint>
+
+// False when the hook was compiled out (the counters then always read zero)
+bool allocationCountingEnabled();
+
+// Allocations made by the calling thread since it started
+std::uint64_t threadAllocations();
+
+// Allocations made by the calling thread while the scope is alive
+class AllocationScope {
+private:
+    std::uint64_t start;
+
+public:
+    AllocationScope() : start(threadAllocations()) {}
+    std::uint64_t count() const { return threadAllocations() - start; }
+};
+
+#endif // ALLOC_COUNTER_H
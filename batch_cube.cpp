@@ -0,0 +1,237 @@
+// Batch Cube Implementation
+// Slot relabelling, bit-sliced twist arithmetic, batched solved test and hash
+
+#include "batch_cube.h"
+#include "profiler.h"
+
+namespace {
+
+// splitmix64 finalizer
+std::uint64_t mix64(std::uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+// In-place transpose of a 64x64 bit matrix (row i = word i, column j = bit j)
+void transpose64(std::uint64_t* rows) {
+    std::uint64_t mask = 0x00000000FFFFFFFFull;
+    for (int width = 32; width != 0; width >>= 1, mask ^= mask << width) {
+        // Contiguous inner runs, so the compiler can do two or four rows per vector op
+        for (int block = 0; block < 64; block += 2 * width) {
+            for (int i = block; i < block + width; i++) {
+                std::uint64_t swap = ((rows[i] >> width) ^ rows[i + width]) & mask;
+                rows[i] ^= swap << width;
+                rows[i + width] ^= swap;
+            }
+        }
+    }
+}
+
+// Two 32x32 bit matrices side by side in 32 rows (bits 0-31 and 32-63), each transposed in place
+void transpose32Pair(std::uint64_t* rows) {
+    std::uint64_t mask = 0x0000FFFF0000FFFFull;
+    for (int width = 16; width != 0; width >>= 1, mask ^= mask << width) {
+        for (int block = 0; block < 32; block += 2 * width) {
+            for (int i = block; i < block + width; i++) {
+                std::uint64_t swap = ((rows[i] >> width) ^ rows[i + width]) & mask;
+                rows[i] ^= swap << width;
+                rows[i + width] ^= swap;
+            }
+        }
+    }
+}
+
+} // namespace
+
+BatchCube::BatchCube(std::size_t laneCount)
+    : lanes(laneCount), words((laneCount + 63) / 64), planes(PLANE_COUNT * words) {
+    reset();
+}
+
+// Slot i holds cubie i with no twist; each id bit plane is all ones or all zeros
+void BatchCube::reset() {
+    for (int i = 0; i < 8; i++) {
+        cornerSlot[i] = static_cast<std::uint8_t>(i);
+        for (int bit = 0; bit < PLANES_PER_CORNER; bit++) {
+            std::uint64_t fill = (bit < CORNER_BITS && (i >> bit) & 1) ? ~0ull : 0;
+            std::uint64_t* plane = cornerPlane(i, bit);
+            for (std::size_t w = 0; w < words; w++) plane[w] = fill;
+        }
+    }
+    for (int i = 0; i < 12; i++) {
+        edgeSlot[i] = static_cast<std::uint8_t>(i);
+        for (int bit = 0; bit < PLANES_PER_EDGE; bit++) {
+            std::uint64_t fill = (bit < EDGE_BITS && (i >> bit) & 1) ? ~0ull : 0;
+            std::uint64_t* plane = edgePlane(i, bit);
+            for (std::size_t w = 0; w < words; w++) plane[w] = fill;
+        }
+    }
+}
+
+// Twist mod 3 on two planes (0 = 00, 1 = 01, 2 = 10); +1 maps (lo, hi) to (~lo & ~hi, lo)
+void BatchCube::twistCorner(int slot, int amount) {
+    std::uint64_t* lo = cornerPlane(slot, CORNER_BITS);
+    std::uint64_t* hi = cornerPlane(slot, CORNER_BITS + 1);
+    if (amount == 1) {
+        for (std::size_t w = 0; w < words; w++) {
+            std::uint64_t zero = ~(lo[w] | hi[w]);
+            hi[w] = lo[w];
+            lo[w] = zero;
+        }
+    } else {
+        for (std::size_t w = 0; w < words; w++) {
+            std::uint64_t zero = ~(lo[w] | hi[w]);
+            lo[w] = hi[w];
+            hi[w] = zero;
+        }
+    }
+}
+
+void BatchCube::flipEdge(int slot) {
+    std::uint64_t* flip = edgePlane(slot, EDGE_BITS);
+    for (std::size_t w = 0; w < words; w++) flip[w] = ~flip[w];
+}
+
+// state * M: position i takes the slot from M.cp[i], then adds M's twist there
+void BatchCube::applyMove(int move) {
+    if (move < 0 || move >= NUM_MOVES) return;
+    const CubieCube& m = moveCube(move);
+
+    std::uint8_t corners[8], edges[12];
+    for (int i = 0; i < 8; i++) corners[i] = cornerSlot[m.cp[i]];
+    for (int i = 0; i < 12; i++) edges[i] = edgeSlot[m.ep[i]];
+    for (int i = 0; i < 8; i++) {
+        cornerSlot[i] = corners[i];
+        if (m.co[i]) twistCorner(corners[i], m.co[i]);
+    }
+    for (int i = 0; i < 12; i++) {
+        edgeSlot[i] = edges[i];
+        if (m.eo[i]) flipEdge(edges[i]);
+    }
+}
+
+void BatchCube::applySequence(const int* moves, std::size_t count) {
+    PROFILE_SCOPE("BatchCube::applySequence");
+    for (std::size_t i = 0; i < count; i++) applyMove(moves[i]);
+}
+
+void BatchCube::load(std::size_t lane, const CubieCube& cube) {
+    if (lane >= lanes) return;
+    std::size_t w = lane / 64;
+    std::uint64_t bit = 1ull << (lane % 64);
+    for (int i = 0; i < 8; i++) {
+        int value = cube.cp[i] | (cube.co[i] & 1) << CORNER_BITS | (cube.co[i] >> 1) << (CORNER_BITS + 1);
+        for (int b = 0; b < PLANES_PER_CORNER; b++) {
+            std::uint64_t& word = cornerPlane(cornerSlot[i], b)[w];
+            word = ((value >> b) & 1) ? (word | bit) : (word & ~bit);
+        }
+    }
+    for (int i = 0; i < 12; i++) {
+        int value = cube.ep[i] | cube.eo[i] << EDGE_BITS;
+        for (int b = 0; b < PLANES_PER_EDGE; b++) {
+            std::uint64_t& word = edgePlane(edgeSlot[i], b)[w];
+            word = ((value >> b) & 1) ? (word | bit) : (word & ~bit);
+        }
+    }
+}
+
+void BatchCube::store(std::size_t lane, CubieCube& cube) const {
+    if (lane >= lanes) return;
+    std::size_t w = lane / 64;
+    int shift = static_cast<int>(lane % 64);
+    for (int i = 0; i < 8; i++) {
+        int value = 0;
+        for (int b = 0; b < PLANES_PER_CORNER; b++) {
+            value |= static_cast<int>((cornerPlane(cornerSlot[i], b)[w] >> shift) & 1) << b;
+        }
+        cube.cp[i] = static_cast<std::uint8_t>(value & 7);
+        cube.co[i] = static_cast<std::uint8_t>(((value >> CORNER_BITS) & 1) | (((value >> (CORNER_BITS + 1)) & 1) << 1));
+    }
+    for (int i = 0; i < 12; i++) {
+        int value = 0;
+        for (int b = 0; b < PLANES_PER_EDGE; b++) {
+            value |= static_cast<int>((edgePlane(edgeSlot[i], b)[w] >> shift) & 1) << b;
+        }
+        cube.ep[i] = static_cast<std::uint8_t>(value & 15);
+        cube.eo[i] = static_cast<std::uint8_t>(value >> EDGE_BITS);
+    }
+}
+
+bool BatchCube::load(std::size_t lane, const RubikCube& cube) {
+    CubieCube cubie;
+    if (!CubieCube::fromFacelets(cube, cubie)) return false;
+    load(lane, cubie);
+    return true;
+}
+
+void BatchCube::store(std::size_t lane, RubikCube& cube) const {
+    CubieCube cubie;
+    store(lane, cubie);
+    cubie.toFacelets(cube);
+}
+
+// A lane is solved when every position holds its own cubie untwisted: AND of plane matches
+std::size_t BatchCube::solvedMask(std::vector<std::uint64_t>& mask) const {
+    PROFILE_SCOPE("BatchCube::solvedMask");
+    mask.assign(words, ~0ull);
+    for (int i = 0; i < 8; i++) {
+        for (int b = 0; b < PLANES_PER_CORNER; b++) {
+            const std::uint64_t* plane = cornerPlane(cornerSlot[i], b);
+            std::uint64_t expect = (b < CORNER_BITS && (i >> b) & 1) ? ~0ull : 0;
+            for (std::size_t w = 0; w < words; w++) mask[w] &= ~(plane[w] ^ expect);
+        }
+    }
+    for (int i = 0; i < 12; i++) {
+        for (int b = 0; b < PLANES_PER_EDGE; b++) {
+            const std::uint64_t* plane = edgePlane(edgeSlot[i], b);
+            std::uint64_t expect = (b < EDGE_BITS && (i >> b) & 1) ? ~0ull : 0;
+            for (std::size_t w = 0; w < words; w++) mask[w] &= ~(plane[w] ^ expect);
+        }
+    }
+    if (lanes % 64) mask[words - 1] &= (1ull << (lanes % 64)) - 1;
+
+    std::size_t solved = 0;
+    for (std::uint64_t word : mask) {
+        for (; word; word &= word - 1) solved++;
+    }
+    return solved;
+}
+
+std::size_t BatchCube::countSolved() const {
+    std::vector<std::uint64_t> mask;
+    return solvedMask(mask);
+}
+
+// Gathers each lane's input bits (position by position, wherever the slots moved) into two
+// words and mixes them like CubieCube::hash mixes its packing. The last edge is implied by the
+// other eleven, which leaves 95 planes: 64 for a full transpose and 31 for a cheaper pair of
+// 32x32 transposes that put lanes l and l + 32 in the two halves of row l.
+void BatchCube::hashes(std::vector<std::uint64_t>& out) const {
+    PROFILE_SCOPE("BatchCube::hashes");
+    constexpr int HASHED_PLANES = PLANE_COUNT - PLANES_PER_EDGE;
+    static_assert(HASHED_PLANES <= 96, "hashed planes must fit one 64-row and one 32-row block");
+    const std::uint64_t* inputs[HASHED_PLANES];
+    for (int p = 0; p < EDGE_PLANE_BASE; p++) {
+        inputs[p] = cornerPlane(cornerSlot[p / PLANES_PER_CORNER], p % PLANES_PER_CORNER);
+    }
+    for (int e = 0; e < HASHED_PLANES - EDGE_PLANE_BASE; e++) {
+        inputs[EDGE_PLANE_BASE + e] = edgePlane(edgeSlot[e / PLANES_PER_EDGE], e % PLANES_PER_EDGE);
+    }
+
+    out.resize(words * 64);
+    std::uint64_t block[96];
+    for (std::size_t w = 0; w < words; w++) {
+        for (int p = 0; p < HASHED_PLANES; p++) block[p] = inputs[p][w];
+        for (int p = HASHED_PLANES; p < 96; p++) block[p] = 0;
+        // block[p] bit l = input bit p of lane l
+        transpose64(block);
+        transpose32Pair(block + 64);
+        for (int l = 0; l < 32; l++) {
+            std::uint64_t high = block[64 + l];
+            out[w * 64 + l] = mix64(block[l] ^ mix64(high & 0xFFFFFFFFull));
+            out[w * 64 + 32 + l] = mix64(block[32 + l] ^ mix64(high >> 32));
+        }
+    }
+    out.resize(lanes);
+}
@@ -0,0 +1,66 @@
+// Batch Cube Header
+// Bit-sliced simulator applying the same moves to many cube states at once
+
+#ifndef BATCH_CUBE_H
+#define BATCH_CUBE_H
+
+#include "cubie_cube.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// N cube states stored as bit planes: one bit per lane in each 64-bit word.
+// Every cubie slot holds its cubie id (3 bits corner / 4 bits edge) and orientation
+// (2-bit twist / 1-bit flip), so each plane is a column of one bit across all lanes.
+// A move only relabels which slot sits at which position and then fixes the
+// orientation planes of the turned cubies - a few word ops per 64 lanes.
+class BatchCube {
+private:
+    static constexpr int CORNER_BITS = 3;
+    static constexpr int EDGE_BITS = 4;
+    static constexpr int PLANES_PER_CORNER = CORNER_BITS + 2;
+    static constexpr int PLANES_PER_EDGE = EDGE_BITS + 1;
+    static constexpr int EDGE_PLANE_BASE = 8 * PLANES_PER_CORNER;
+    static constexpr int PLANE_COUNT = EDGE_PLANE_BASE + 12 * PLANES_PER_EDGE;
+
+    std::size_t lanes;
+    std::size_t words;
+    std::vector<std::uint64_t> planes;  // PLANE_COUNT * words, one plane after another
+    std::uint8_t cornerSlot[8];         // Slot holding the cubie data for each corner position
+    std::uint8_t edgeSlot[12];
+
+    std::uint64_t* cornerPlane(int slot, int bit) { return &planes[(slot * PLANES_PER_CORNER + bit) * words]; }
+    const std::uint64_t* cornerPlane(int slot, int bit) const { return &planes[(slot * PLANES_PER_CORNER + bit) * words]; }
+    std::uint64_t* edgePlane(int slot, int bit) { return &planes[(EDGE_PLANE_BASE + slot * PLANES_PER_EDGE + bit) * words]; }
+    const std::uint64_t* edgePlane(int slot, int bit) const { return &planes[(EDGE_PLANE_BASE + slot * PLANES_PER_EDGE + bit) * words]; }
+
+    void twistCorner(int slot, int amount);
+    void flipEdge(int slot);
+
+public:
+    explicit BatchCube(std::size_t laneCount);
+
+    std::size_t size() const { return lanes; }
+
+    // All lanes solved
+    void reset();
+
+    // Apply one move index (see NUM_MOVES) to every lane
+    void applyMove(int move);
+    void applySequence(const int* moves, std::size_t count);
+
+    // Copy single states in and out
+    void load(std::size_t lane, const CubieCube& cube);
+    void store(std::size_t lane, CubieCube& cube) const;
+    bool load(std::size_t lane, const RubikCube& cube);
+    void store(std::size_t lane, RubikCube& cube) const;
+
+    // One bit per lane (lane i is bit i % 64 of word i / 64); returns the number solved
+    std::size_t solvedMask(std::vector<std::uint64_t>& mask) const;
+    std::size_t countSolved() const;
+
+    // 64-bit hash per lane from a bit transpose and a mix; equal states give equal hashes
+    void hashes(std::vector<std::uint64_t>& out) const;
+};
+
+#endif // BATCH_CUBE_H
@@ -0,0 +1,189 @@
+// Cube Picker Implementation
+// Matrix inverse for unprojection, slab tests against the 26 outer cubies, drag inference
+
+#include "cube_picker.h"
+#include <cmath>
+#include <utility>
+
+namespace {
+
+constexpr float HALF_CUBIE = PICK_CUBIE_SIZE * 0.5f;
+constexpr float OUTER = 1.0f + HALF_CUBIE;  // Distance of the cube's sides from the center
+
+// Gauss-Jordan inverse of a column-major 4x4 matrix
+bool invert(const float* m, float* out) {
+    double a[4][8];
+    for (int r = 0; r < 4; r++) {
+        for (int c = 0; c < 4; c++) {
+            a[r][c] = m[c * 4 + r];
+            a[r][c + 4] = r == c ? 1.0 : 0.0;
+        }
+    }
+    for (int c = 0; c < 4; c++) {
+        int pivot = c;
+        for (int r = c + 1; r < 4; r++) {
+            if (std::fabs(a[r][c]) > std::fabs(a[pivot][c])) pivot = r;
+        }
+        if (std::fabs(a[pivot][c]) < 1e-12) return false;
+        if (pivot != c) {
+            for (int k = 0; k < 8; k++) std::swap(a[c][k], a[pivot][k]);
+        }
+        double scale = 1.0 / a[c][c];
+        for (int k = 0; k < 8; k++) a[c][k] *= scale;
+        for (int r = 0; r < 4; r++) {
+            if (r == c || a[r][c] == 0.0) continue;
+            double factor = a[r][c];
+            for (int k = 0; k < 8; k++) a[r][k] -= factor * a[c][k];
+        }
+    }
+    for (int r = 0; r < 4; r++) {
+        for (int c = 0; c < 4; c++) out[c * 4 + r] = static_cast<float>(a[r][c + 4]);
+    }
+    return true;
+}
+
+// Clip-space point (x, y, z, 1) back to world space
+void unproject(const float* inverse, float x, float y, float z, float* out) {
+    float v[4];
+    for (int r = 0; r < 4; r++) v[r] = inverse[r] * x + inverse[4 + r] * y + inverse[8 + r] * z + inverse[12 + r];
+    for (int i = 0; i < 3; i++) out[i] = v[i] / v[3];
+}
+
+// Slab test; on a hit returns the entry parameter and the entry axis/side
+bool intersectBox(const PickRay& ray, const float* low, const float* high, float& entry, int& axis, int& side) {
+    float near = -1e30f, far = 1e30f;
+    for (int i = 0; i < 3; i++) {
+        float d = ray.direction[i];
+        if (std::fabs(d) < 1e-12f) {
+            if (ray.origin[i] < low[i] || ray.origin[i] > high[i]) return false;
+            continue;
+        }
+        float t0 = (low[i] - ray.origin[i]) / d;
+        float t1 = (high[i] - ray.origin[i]) / d;
+        int enterSide = 1;  // Entering through the low side faces -axis
+        if (t0 > t1) {
+            std::swap(t0, t1);
+            enterSide = 0;
+        }
+        if (t0 > near) {
+            near = t0;
+            axis = i;
+            side = enterSide;
+        }
+        if (t1 < far) far = t1;
+        if (near > far || far < 0.0f) return false;
+    }
+    if (near < 0.0f) return false;  // Origin inside the box
+    entry = near;
+    return true;
+}
+
+} // namespace
+
+bool screenRay(const float* projection, const float* view, float x, float y, int width, int height, PickRay& ray) {
+    if (width <= 0 || height <= 0) return false;
+    float clip[16];
+    for (int c = 0; c < 4; c++) {
+        for (int r = 0; r < 4; r++) {
+            float sum = 0.0f;
+            for (int k = 0; k < 4; k++) sum += projection[k * 4 + r] * view[c * 4 + k];
+            clip[c * 4 + r] = sum;
+        }
+    }
+    float inverse[16];
+    if (!invert(clip, inverse)) return false;
+
+    // Pixel centers to normalized device coordinates (y up)
+    float ndcX = 2.0f * (x + 0.5f) / width - 1.0f;
+    float ndcY = 1.0f - 2.0f * (y + 0.5f) / height;
+    float nearPoint[3], farPoint[3];
+    unproject(inverse, ndcX, ndcY, -1.0f, nearPoint);
+    unproject(inverse, ndcX, ndcY, 1.0f, farPoint);
+    for (int i = 0; i < 3; i++) {
+        ray.origin[i] = nearPoint[i];
+        ray.direction[i] = farPoint[i] - nearPoint[i];
+    }
+    return true;
+}
+
+bool pickSticker(const PickRay& ray, StickerHit& hit) {
+    // Whole cube first: most rays miss it entirely
+    const float cubeLow[3] = {-OUTER, -OUTER, -OUTER};
+    const float cubeHigh[3] = {OUTER, OUTER, OUTER};
+    float entry;
+    int axis = 0, side = 0;
+    if (!intersectBox(ray, cubeLow, cubeHigh, entry, axis, side)) return false;
+
+    bool found = false;
+    for (int x = -1; x <= 1; x++) {
+        for (int y = -1; y <= 1; y++) {
+            for (int z = -1; z <= 1; z++) {
+                if (x == 0 && y == 0 && z == 0) continue;  // Hidden core
+                const int position[3] = {x, y, z};
+                float low[3], high[3];
+                for (int i = 0; i < 3; i++) {
+                    low[i] = position[i] - HALF_CUBIE;
+                    high[i] = position[i] + HALF_CUBIE;
+                }
+                if (!intersectBox(ray, low, high, entry, axis, side)) continue;
+                if (found && entry >= hit.distance) continue;
+                found = true;
+                hit.distance = entry;
+                hit.face = axis * 2 + (side == 0 ? 0 : 1);  // +X = RIGHT, -X = LEFT, ...
+                for (int i = 0; i < 3; i++) hit.cubie[i] = position[i];
+            }
+        }
+    }
+    if (!found) return false;  // Through the gaps between cubies
+
+    // Only sides on the outside of the cube carry a sticker
+    int axisOfFace = hit.face / 2;
+    int outward = hit.face % 2 == 0 ? 1 : -1;
+    if (hit.cubie[axisOfFace] != outward) return false;
+    hit.sticker = cubieSticker(hit.cubie[0], hit.cubie[1], hit.cubie[2], hit.face);
+    for (int i = 0; i < 3; i++) hit.point[i] = ray.origin[i] + ray.direction[i] * hit.distance;
+    return true;
+}
+
+bool dragTurn(const StickerHit& start, const PickRay& ray, int& face, bool& clockwise, float threshold) {
+    // Where the ray meets the plane of the picked side
+    int normalAxis = start.face / 2;
+    float normalSign = start.face % 2 == 0 ? 1.0f : -1.0f;
+    float plane = start.point[normalAxis];
+    float d = ray.direction[normalAxis];
+    if (std::fabs(d) < 1e-12f) return false;
+    float t = (plane - ray.origin[normalAxis]) / d;
+    if (t < 0.0f) return false;
+
+    // Dominant in-plane drag direction
+    int dragAxis = -1;
+    float dragAmount = 0.0f;
+    for (int i = 0; i < 3; i++) {
+        if (i == normalAxis) continue;
+        float delta = ray.origin[i] + ray.direction[i] * t - start.point[i];
+        if (std::fabs(delta) > std::fabs(dragAmount)) {
+            dragAmount = delta;
+            dragAxis = i;
+        }
+    }
+    if (dragAxis < 0 || std::fabs(dragAmount) < threshold) return false;
+
+    // Rotation axis = normal x drag, so the picked sticker moves along the drag
+    float normal[3] = {0.0f, 0.0f, 0.0f};
+    float drag[3] = {0.0f, 0.0f, 0.0f};
+    normal[normalAxis] = normalSign;
+    drag[dragAxis] = dragAmount > 0.0f ? 1.0f : -1.0f;
+    float rotation[3] = {
+        normal[1] * drag[2] - normal[2] * drag[1],
+        normal[2] * drag[0] - normal[0] * drag[2],
+        normal[0] * drag[1] - normal[1] * drag[0]
+    };
+    int rotationAxis = 3 - normalAxis - dragAxis;
+    int layer = start.cubie[rotationAxis];
+    if (layer == 0) return false;  // Middle slice
+
+    face = rotationAxis * 2 + (layer > 0 ? 0 : 1);
+    // A clockwise turn rotates the slice by sliceTurnSign(face) * +90 degrees
+    clockwise = (rotation[rotationAxis] > 0.0f) == (sliceTurnSign(face) > 0);
+    return true;
+}
@@ -0,0 +1,47 @@
+// Cube Picker Header
+// CPU ray casting against the cubie boxes: sticker under the mouse and drag-to-turn
+//
+//   PickRay ray;
+//   screenRay(projection, view, mouseX, mouseY, width, height, ray);
+//   StickerHit hit;
+//   if (pickSticker(ray, hit)) ...                     // ~100 ns, no GL selection or readback
+//   if (dragTurn(hit, rayNow, face, clockwise)) ...    // once the drag is long enough
+//
+// The boxes match both renderers: cubie centers at -1, 0, 1 on each axis, edge PICK_CUBIE_SIZE.
+// A drag is measured in the plane of the picked face; its dominant direction and the face
+// normal give the rotation axis, and the picked cubie's coordinate on that axis the layer.
+
+#ifndef CUBE_PICKER_H
+#define CUBE_PICKER_H
+
+#include "rubik_cube.h"
+
+constexpr float PICK_CUBIE_SIZE = 0.95f;
+constexpr float PICK_DRAG_THRESHOLD = 0.3f;  // World units in the face plane before a drag turns
+
+struct PickRay {
+    float origin[3];
+    float direction[3];  // Not necessarily unit length
+};
+
+struct StickerHit {
+    int cubie[3];        // Grid position, each -1..1
+    int face;            // FaceIndex of the box side that was hit (outward normal)
+    StickerRef sticker;  // Facelet shown there
+    float point[3];      // World-space hit point
+    float distance;      // Ray parameter of the hit
+};
+
+// Ray through window pixel (x, y), top-left origin, for column-major projection and view
+// matrices; false if projection * view is singular
+bool screenRay(const float* projection, const float* view, float x, float y, int width, int height, PickRay& ray);
+
+// Nearest sticker along the ray; false on a miss or when the nearest box side is an inner one
+bool pickSticker(const PickRay& ray, StickerHit& hit);
+
+// Face turn for a drag that started on `start` and is now over `ray`. False while the drag is
+// shorter than threshold, and for middle-layer drags (the game only turns faces).
+bool dragTurn(const StickerHit& start, const PickRay& ray, int& face, bool& clockwise,
+              float threshold = PICK_DRAG_THRESHOLD);
+
+#endif // CUBE_PICKER_H
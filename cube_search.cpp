@@ -0,0 +1,134 @@
+// Cube Search Implementation
+// Coordinate tables built by BFS, IDA* over a fixed per-depth coordinate stack
+
+#include "cube_search.h"
+#include "move_tables.h"
+#include "pattern_database.h"
+#include "profiler.h"
+#include <algorithm>
+
+namespace {
+
+// moveTable[coord * NUM_MOVES + move] = coordinate after applying move
+template <typename Set, typename Get>
+std::vector<std::uint16_t> buildMoveTable(int size, Set set, Get get) {
+    std::vector<std::uint16_t> table(static_cast<std::size_t>(size) * NUM_MOVES);
+    CubieCube cube;
+    for (int coord = 0; coord < size; coord++) {
+        for (int move = 0; move < NUM_MOVES; move++) {
+            set(cube, coord);
+            cube.applyMove(move);
+            table[static_cast<std::size_t>(coord) * NUM_MOVES + move] = static_cast<std::uint16_t>(get(cube));
+        }
+    }
+    return table;
+}
+
+// BFS distance to solved (coordinate 0) through a move table
+std::vector<std::uint8_t> buildDistanceTable(const std::uint16_t* moveTable, int size) {
+    std::vector<std::uint8_t> distance(size, 0xFF);
+    std::vector<int> frontier(1, 0), next;
+    distance[0] = 0;
+    for (std::uint8_t depth = 0; !frontier.empty(); depth++) {
+        next.clear();
+        for (int coord : frontier) {
+            for (int move = 0; move < NUM_MOVES; move++) {
+                int reached = moveTable[static_cast<std::size_t>(coord) * NUM_MOVES + move];
+                if (distance[reached] == 0xFF) {
+                    distance[reached] = static_cast<std::uint8_t>(depth + 1);
+                    next.push_back(reached);
+                }
+            }
+        }
+        frontier.swap(next);
+    }
+    return distance;
+}
+
+} // namespace
+
+// The orientation move tables are compile-time constants; only the permutation one is built
+CoordinateTables::CoordinateTables() : twistMove(MOVE_TABLES.twistMove), flipMove(MOVE_TABLES.flipMove) {
+    PROFILE_SCOPE("CoordinateTables::build");
+    permutationMove = buildMoveTable(CORNER_PERMUTATIONS,
+        [](CubieCube& c, int v) { c.setCornerPermutation(v); },
+        [](const CubieCube& c) { return c.cornerPermutation(); });
+    twistDistance = buildDistanceTable(twistMove, CORNER_ORIENTATIONS);
+    flipDistance = buildDistanceTable(flipMove, EDGE_ORIENTATIONS);
+    permutationDistance = buildDistanceTable(permutationMove.data(), CORNER_PERMUTATIONS);
+}
+
+const CoordinateTables& CoordinateTables::instance() {
+    static const CoordinateTables tables;
+    return tables;
+}
+
+int CoordinateTables::lowerBound(int twist, int flip, int permutation) const {
+    return std::max({twistDistance[twist], flipDistance[flip], permutationDistance[permutation]});
+}
+
+int CoordinateTables::lowerBound(const CubieCube& cube) const {
+    return lowerBound(cube.cornerOrientation(), cube.edgeOrientation(), cube.cornerPermutation());
+}
+
+CubeSearch::CubeSearch(const PatternDatabase* corners)
+    : tables(CoordinateTables::instance()), corners(corners), stack(), path(), nodes(0) {}
+
+int CubeSearch::lowerBound(const Frame& frame) const {
+    int bound = tables.lowerBound(frame.twist, frame.flip, frame.permutation);
+    if (corners) {
+        std::uint64_t index = static_cast<std::uint64_t>(frame.permutation) * CORNER_ORIENTATIONS + frame.twist;
+        bound = std::max(bound, corners->distance(index));
+    }
+    return bound;
+}
+
+// The coordinates ignore edge permutation, so a leaf with all three solved is only a
+// candidate: replay it on the real cube to confirm
+bool CubeSearch::isSolution(int length) {
+    scratch = start;
+    for (int i = 0; i < length; i++) scratch.applyMove(path[i]);
+    return scratch.isSolved();
+}
+
+bool CubeSearch::search(int depth, int limit, int lastFace) {
+    nodes++;
+    const Frame& frame = stack[depth];
+    int bound = lowerBound(frame);
+    if (depth + bound > limit) return false;
+    if (depth == limit) return isSolution(depth);
+
+    Frame& next = stack[depth + 1];
+    for (int move = 0; move < NUM_MOVES; move++) {
+        int face = move / 3;
+        // Never turn the same face twice; opposite faces commute, so only in ascending order
+        if (face == lastFace || (lastFace >= 0 && face / 2 == lastFace / 2 && face < lastFace)) continue;
+        next.twist = tables.twistMove[frame.twist * NUM_MOVES + move];
+        next.flip = tables.flipMove[frame.flip * NUM_MOVES + move];
+        next.permutation = tables.permutationMove[frame.permutation * NUM_MOVES + move];
+        path[depth] = move;
+        if (search(depth + 1, limit, face)) return true;
+    }
+    return false;
+}
+
+bool CubeSearch::solve(const CubieCube& cube, int maxDepth, SearchResult& result) {
+    PROFILE_SCOPE("CubeSearch::solve");
+    maxDepth = std::min(maxDepth, MAX_SEARCH_DEPTH);
+    start = cube;
+    nodes = 0;
+    stack[0] = {static_cast<std::uint16_t>(cube.cornerOrientation()),
+                static_cast<std::uint16_t>(cube.edgeOrientation()),
+                static_cast<std::uint16_t>(cube.cornerPermutation())};
+
+    result.length = -1;
+    for (int limit = lowerBound(stack[0]); limit <= maxDepth; limit++) {
+        if (search(0, limit, -1)) {
+            result.length = limit;
+            std::copy(path, path + limit, result.moves);
+            break;
+        }
+    }
+    result.nodes = nodes;
+    return result.length >= 0;
+}
@@ -0,0 +1,81 @@
+// Cube Search Header
+// Coordinate move / distance tables and an allocation-free IDA* solver
+//
+// The search never copies or allocates a cube per node. Each depth keeps three 16-bit
+// coordinates (corner twist, edge flip, corner permutation) in a fixed stack: a move is one
+// table lookup per coordinate into the next frame, and undoing it is popping the frame.
+// The full state is only rebuilt, by replaying the path into a preallocated cube, at leaves
+// where all three coordinates are solved. Tables are shared and built once, so solve()
+// itself does no heap allocation at all (rubik_search checks this with the allocation hook).
+//
+// An optional corners pattern database (see pattern_database.h) adds the exact corner
+// distance to the bound; its index is permutation * twist, both already in the frame.
+
+#ifndef CUBE_SEARCH_H
+#define CUBE_SEARCH_H
+
+#include "cubie_cube.h"
+#include <cstdint>
+#include <vector>
+
+constexpr int MAX_SEARCH_DEPTH = 20;
+
+class PatternDatabase;
+
+// Move tables (coordinate x move -> coordinate) and exact distances to solved per coordinate
+class CoordinateTables {
+private:
+    CoordinateTables();
+
+public:
+    const std::uint16_t* twistMove;              // CORNER_ORIENTATIONS * NUM_MOVES, in MOVE_TABLES
+    const std::uint16_t* flipMove;               // EDGE_ORIENTATIONS * NUM_MOVES, in MOVE_TABLES
+    std::vector<std::uint16_t> permutationMove;  // CORNER_PERMUTATIONS * NUM_MOVES
+    std::vector<std::uint8_t> twistDistance;
+    std::vector<std::uint8_t> flipDistance;
+    std::vector<std::uint8_t> permutationDistance;
+
+    // Built on first use (~50 ms, the corner permutation tables), then shared by every thread
+    static const CoordinateTables& instance();
+
+    // Largest of the three table distances - a lower bound on the distance to solved
+    int lowerBound(int twist, int flip, int permutation) const;
+    int lowerBound(const CubieCube& cube) const;
+};
+
+struct SearchResult {
+    int moves[MAX_SEARCH_DEPTH];
+    int length;
+    std::uint64_t nodes;
+};
+
+// One solver per thread; solve() reuses the member stacks and never allocates
+class CubeSearch {
+private:
+    struct Frame {
+        std::uint16_t twist;
+        std::uint16_t flip;
+        std::uint16_t permutation;
+    };
+
+    const CoordinateTables& tables;
+    const PatternDatabase* corners;     // Null without a corners table
+    Frame stack[MAX_SEARCH_DEPTH + 1];  // Frame d = state after path[0..d)
+    int path[MAX_SEARCH_DEPTH];
+    CubieCube start;
+    CubieCube scratch;
+    std::uint64_t nodes;
+
+    int lowerBound(const Frame& frame) const;
+    bool search(int depth, int limit, int lastFace);
+    bool isSolution(int length);
+
+public:
+    // corners: an open PATTERN_CORNERS database, or null for the coordinate tables alone
+    explicit CubeSearch(const PatternDatabase* corners = nullptr);
+
+    // Shortest solution of at most maxDepth moves (iterative deepening); false if none
+    bool solve(const CubieCube& cube, int maxDepth, SearchResult& result);
+};
+
+#endif // CUBE_SEARCH_H
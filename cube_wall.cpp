@@ -0,0 +1,309 @@
+// Cube Wall Implementation
+// Per-cube scripts and turn animation, chunked parallel update, sphere-frustum culling
+
+#include "cube_wall.h"
+#include "cubie_cube.h"
+#include "profiler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr int CUBES_PER_CHUNK = 32;
+constexpr float MIN_TURN_SPEED = 240.0f;   // Degrees per second
+constexpr float MAX_TURN_SPEED = 480.0f;
+constexpr float MIN_PAUSE = 0.4f;          // Seconds between scramble and solve
+constexpr float MAX_PAUSE = 1.5f;
+
+// Cheap deterministic per-cube randomness (no shared RNG state between threads)
+std::uint32_t mix(std::uint32_t a, std::uint32_t b, std::uint32_t c = 0) {
+    std::uint32_t h = a * 0x9E3779B1u ^ (b + 0x7F4A7C15u) * 0x85EBCA77u ^ (c + 0x165667B1u) * 0xC2B2AE3Du;
+    h ^= h >> 15;
+    h *= 0x2C1B3C6Du;
+    h ^= h >> 12;
+    h *= 0x297A2D39u;
+    h ^= h >> 15;
+    return h;
+}
+
+float unitFloat(std::uint32_t hash) {
+    return static_cast<float>(hash >> 8) / static_cast<float>(1u << 24);
+}
+
+// Turn angle of a move in degrees (R' = -90, R2 = 180)
+float moveAngle(int move) {
+    int turns = move % 3;
+    return turns == 0 ? 90.0f : (turns == 1 ? 180.0f : -90.0f);
+}
+
+// Row i of a column-major 4x4 matrix
+void matrixRow(const float* m, int i, float row[4]) {
+    for (int c = 0; c < 4; c++) row[c] = m[c * 4 + i];
+}
+
+} // namespace
+
+CubeWall::CubeWall(int count, unsigned int seed, int threads)
+    : seed(seed), columns(0), rows(0), stickerVersion(1), movesApplied(0),
+      jobChunks(0), nextChunk(0), busyWorkers(0), generation(0), stopping(false) {
+    count = std::max(count, 1);
+    columns = static_cast<int>(std::ceil(std::sqrt(count * 16.0 / 9.0)));
+    rows = (count + columns - 1) / columns;
+
+    cubes.resize(count);
+    stickers.assign(static_cast<std::size_t>(count) * WALL_TEXELS, 0);
+    chunkMoves.assign((count + CUBES_PER_CHUNK - 1) / CUBES_PER_CHUNK, 0);
+    chunkChanged.assign(chunkMoves.size(), 0);
+    for (int i = 0; i < count; i++) {
+        WallCube& wallCube = cubes[i];
+        wallCube.center[0] = (i % columns - (columns - 1) * 0.5f) * WALL_SPACING;
+        wallCube.center[1] = ((rows - 1) * 0.5f - i / columns) * WALL_SPACING;
+        wallCube.center[2] = 0.0f;
+        wallCube.speed = MIN_TURN_SPEED + (MAX_TURN_SPEED - MIN_TURN_SPEED) * unitFloat(mix(seed, i, 0xA11CEu));
+        wallCube.cycle = 0;
+        startScript(wallCube, i);
+
+        // Start somewhere inside the first scramble so the wall is out of step from frame one
+        std::size_t skip = mix(seed, i, 0x5EEDu) % WALL_SCRAMBLE_MOVES;
+        for (; wallCube.step < skip; wallCube.step++) wallCube.cube.applyMoveIndex(wallCube.script[wallCube.step]);
+        refreshStickers(i);
+    }
+
+    int threadTotal = threads > 0 ? threads : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    threadTotal = std::min(threadTotal, static_cast<int>(chunkMoves.size()));
+    for (int t = 1; t < threadTotal; t++) workers.emplace_back(&CubeWall::workerLoop, this);
+}
+
+CubeWall::~CubeWall() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) worker.join();
+}
+
+// Workers sleep until runChunks() bumps the generation, then race for chunks
+void CubeWall::workerLoop() {
+    std::uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+        drainChunks();
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--busyWorkers == 0) done.notify_one();
+    }
+}
+
+void CubeWall::drainChunks() {
+    for (;;) {
+        int chunk;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (nextChunk >= jobChunks) return;
+            chunk = nextChunk++;
+        }
+        job(chunk);
+    }
+}
+
+// Run task(0..chunks-1) on the workers and the calling thread; returns when all are done
+void CubeWall::runChunks(int chunks, const std::function<void(int)>& task) {
+    if (workers.empty()) {
+        for (int chunk = 0; chunk < chunks; chunk++) task(chunk);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = task;
+        jobChunks = chunks;
+        nextChunk = 0;
+        busyWorkers = static_cast<int>(workers.size());
+        generation++;
+    }
+    wake.notify_all();
+    drainChunks();
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&] { return busyWorkers == 0; });
+    job = nullptr;
+}
+
+// Scramble for the current cycle; the solve script is its inverse
+void CubeWall::startScript(WallCube& wallCube, unsigned int index) {
+    scrambleMoves(WALL_SCRAMBLE_MOVES, mix(seed, index, wallCube.cycle), wallCube.script);
+    wallCube.cycle++;
+    wallCube.step = 0;
+    wallCube.solving = false;
+    wallCube.move = -1;
+    wallCube.angle = 0.0f;
+    wallCube.pause = 0.0f;
+}
+
+// Advance one cube; true if its stickers changed
+bool CubeWall::updateCube(std::size_t index, float deltaTime, std::uint64_t& moves) {
+    WallCube& wallCube = cubes[index];
+    bool changed = false;
+    float remaining = deltaTime;
+    while (remaining > 0.0f) {
+        if (wallCube.pause > 0.0f) {
+            float used = std::min(wallCube.pause, remaining);
+            wallCube.pause -= used;
+            remaining -= used;
+            continue;
+        }
+        if (wallCube.move < 0) {
+            if (wallCube.step == wallCube.script.size()) {
+                float pause = MIN_PAUSE + (MAX_PAUSE - MIN_PAUSE) * unitFloat(mix(seed, index, wallCube.cycle * 2 + wallCube.solving));
+                if (wallCube.solving) {
+                    startScript(wallCube, static_cast<unsigned int>(index));
+                } else {
+                    // Undo the scramble move by move, last first
+                    std::reverse(wallCube.script.begin(), wallCube.script.end());
+                    for (int& move : wallCube.script) move = inverseMove(move);
+                    wallCube.step = 0;
+                    wallCube.solving = true;
+                }
+                wallCube.pause = pause;
+                continue;
+            }
+            wallCube.move = wallCube.script[wallCube.step];
+            wallCube.angle = 0.0f;
+        }
+
+        float target = std::fabs(moveAngle(wallCube.move));
+        float needed = (target - wallCube.angle) / wallCube.speed;
+        if (needed > remaining) {
+            wallCube.angle += wallCube.speed * remaining;
+            break;
+        }
+        remaining -= needed;
+        wallCube.cube.applyMoveIndex(wallCube.move);
+        wallCube.move = -1;
+        wallCube.angle = 0.0f;
+        wallCube.step++;
+        moves++;
+        changed = true;
+    }
+    return changed;
+}
+
+// Copy the stickers and pick each face's most common color for the box LOD
+void CubeWall::refreshStickers(std::size_t index) {
+    const auto& faces = cubes[index].cube.getFaces();
+    unsigned char* out = &stickers[index * WALL_TEXELS];
+    for (int face = 0; face < 6; face++) {
+        int counts[6] = {0, 0, 0, 0, 0, 0};
+        for (int row = 0; row < 3; row++) {
+            for (int col = 0; col < 3; col++) {
+                int color = faces[face][row][col];
+                out[face * 9 + row * 3 + col] = static_cast<unsigned char>(color);
+                if (color >= 0 && color < 6) counts[color]++;
+            }
+        }
+        int best = faces[face][1][1];  // Ties go to the center color
+        for (int color = 0; color < 6; color++) {
+            if (counts[color] > counts[best]) best = color;
+        }
+        out[54 + face] = static_cast<unsigned char>(best);
+    }
+}
+
+void CubeWall::update(float deltaTime) {
+    if (deltaTime <= 0.0f) return;
+    PROFILE_SCOPE("CubeWall::update");
+    std::size_t count = cubes.size();
+    runChunks(static_cast<int>(chunkMoves.size()), [&](int chunk) {
+        std::size_t first = static_cast<std::size_t>(chunk) * CUBES_PER_CHUNK;
+        std::size_t last = std::min(first + CUBES_PER_CHUNK, count);
+        std::uint64_t moves = 0;
+        chunkChanged[chunk] = 0;
+        for (std::size_t i = first; i < last; i++) {
+            if (updateCube(i, deltaTime, moves)) {
+                refreshStickers(i);
+                chunkChanged[chunk] = 1;
+            }
+        }
+        chunkMoves[chunk] = moves;
+    });
+    for (std::size_t chunk = 0; chunk < chunkMoves.size(); chunk++) {
+        movesApplied += chunkMoves[chunk];
+        if (chunkChanged[chunk]) stickerVersion++;
+    }
+}
+
+void CubeWall::cull(const float* projection, const float* view, float lodDistance, WallView& out) const {
+    PROFILE_SCOPE("CubeWall::cull");
+    out.detailed.clear();
+    out.distant.clear();
+    out.culled = 0;
+
+    // Frustum planes from clip = projection * view: row3 +/- row0..2, normalized
+    float clip[16];
+    for (int c = 0; c < 4; c++) {
+        for (int r = 0; r < 4; r++) {
+            float sum = 0.0f;
+            for (int k = 0; k < 4; k++) sum += projection[k * 4 + r] * view[c * 4 + k];
+            clip[c * 4 + r] = sum;
+        }
+    }
+    float planes[6][4];
+    float w[4];
+    matrixRow(clip, 3, w);
+    for (int axis = 0; axis < 3; axis++) {
+        float row[4];
+        matrixRow(clip, axis, row);
+        for (int c = 0; c < 4; c++) {
+            planes[axis * 2][c] = w[c] + row[c];
+            planes[axis * 2 + 1][c] = w[c] - row[c];
+        }
+    }
+    for (float* plane : planes) {
+        float length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+        for (int c = 0; c < 4; c++) plane[c] /= length;
+    }
+
+    float lodSquared = lodDistance * lodDistance;
+    for (std::size_t i = 0; i < cubes.size(); i++) {
+        const WallCube& wallCube = cubes[i];
+        const float* p = wallCube.center;
+        bool inside = true;
+        for (const float* plane : planes) {
+            if (plane[0] * p[0] + plane[1] * p[1] + plane[2] * p[2] + plane[3] < -WALL_CUBE_RADIUS) {
+                inside = false;
+                break;
+            }
+        }
+        if (!inside) {
+            out.culled++;
+            continue;
+        }
+
+        WallInstance instance;
+        std::copy(p, p + 3, instance.center);
+        instance.cube = static_cast<std::int32_t>(i);
+        instance.sliceActive = wallCube.move >= 0;
+        int face = wallCube.move >= 0 ? wallCube.move / 3 : 0;
+        instance.sliceAxis = face / 2;
+        instance.sliceLayer = face % 2 == 0 ? 2 : 0;
+        instance.sliceAngle = wallCube.move >= 0
+            ? sliceTurnSign(face) * (moveAngle(wallCube.move) < 0.0f ? -wallCube.angle : wallCube.angle) : 0.0f;
+
+        // View-space distance (view is a rigid transform)
+        float distanceSquared = 0.0f;
+        for (int r = 0; r < 3; r++) {
+            float v = view[r] * p[0] + view[4 + r] * p[1] + view[8 + r] * p[2] + view[12 + r];
+            distanceSquared += v * v;
+        }
+        (distanceSquared > lodSquared ? out.distant : out.detailed).push_back(instance);
+    }
+}
+
+float CubeWall::getExtent() const {
+    float halfWidth = (columns - 1) * 0.5f * WALL_SPACING + WALL_CUBE_RADIUS;
+    float halfHeight = (rows - 1) * 0.5f * WALL_SPACING + WALL_CUBE_RADIUS;
+    return std::sqrt(halfWidth * halfWidth + halfHeight * halfHeight);
+}
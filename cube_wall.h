@@ -0,0 +1,120 @@
+// Cube Wall Header
+// Grid of cubes that scramble and solve independently, for the wall display
+//
+//   CubeWall wall(500);
+//   wall.update(deltaTime);                                 // every cube, split across cores
+//   wall.cull(projection, view, WALL_LOD_DISTANCE, visible); // frustum culling + level of detail
+//
+// Cubes sit in the z = 0 plane, WALL_SPACING apart, centered on the origin. Each one plays a
+// random scramble, pauses, plays its inverse, pauses and starts over, with its own seed, turn
+// speed and starting point. cull() sorts the cubes in the view frustum into detailed ones (27
+// cubies with stickers and a turning slice) and distant ones (one flat-colored box, each face
+// showing its most common sticker color); the renderer draws each list with one instanced call.
+
+#ifndef CUBE_WALL_H
+#define CUBE_WALL_H
+
+#include "rubik_cube.h"
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+constexpr int WALL_TEXELS = 60;              // Per cube: 54 stickers (face*9 + row*3 + col), 6 box colors
+constexpr int WALL_SCRAMBLE_MOVES = 20;
+constexpr float WALL_SPACING = 4.0f;         // Between cube centers (a cube is 2.95 wide)
+constexpr float WALL_CUBE_RADIUS = 2.6f;     // Bounding sphere, 1.5 * sqrt(3), covers a turning slice
+constexpr float WALL_LOD_DISTANCE = 40.0f;   // Camera distance beyond which cubes become boxes
+
+// One visible cube as the renderer consumes it (32 bytes, uploaded as-is)
+struct WallInstance {
+    float center[3];
+    float sliceAngle;         // Degrees, already signed for the turn direction
+    std::int32_t cube;        // Row in the sticker data
+    std::int32_t sliceAxis;   // 0=X, 1=Y, 2=Z
+    std::int32_t sliceLayer;  // Cubie coordinate 0..2 on sliceAxis
+    std::int32_t sliceActive;
+};
+
+struct WallView {
+    std::vector<WallInstance> detailed;
+    std::vector<WallInstance> distant;
+    int culled;
+};
+
+struct WallCube {
+    RubikCube cube;
+    std::vector<int> script;  // Scramble, or its inverse while solving
+    std::size_t step;         // Next move in script
+    bool solving;
+    int move;                 // Turning move, -1 between moves
+    float angle;              // Degrees turned so far
+    float speed;              // Degrees per second
+    float pause;              // Seconds left before the next script starts
+    unsigned int cycle;       // Scrambles started, for per-cycle seeds
+    float center[3];
+};
+
+class CubeWall {
+private:
+    std::vector<WallCube> cubes;
+    std::vector<unsigned char> stickers;  // WALL_TEXELS per cube
+    std::vector<std::uint64_t> chunkMoves;  // Per update() chunk, summed after the parallel pass
+    std::vector<char> chunkChanged;
+    unsigned int seed;
+    int columns;
+    int rows;
+    std::uint64_t stickerVersion;         // Bumped by update() when any cube changed
+    std::uint64_t movesApplied;
+
+    // Persistent workers; the calling thread takes chunks too
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    std::function<void(int)> job;
+    int jobChunks;
+    int nextChunk;
+    int busyWorkers;
+    std::uint64_t generation;
+    bool stopping;
+
+    void workerLoop();
+    void runChunks(int chunks, const std::function<void(int)>& task);
+    void drainChunks();
+
+    void startScript(WallCube& wallCube, unsigned int index);
+    bool updateCube(std::size_t index, float deltaTime, std::uint64_t& moves);
+    void refreshStickers(std::size_t index);
+
+public:
+    // threads = 0 uses every core
+    explicit CubeWall(int count, unsigned int seed = 1, int threads = 0);
+    ~CubeWall();
+    CubeWall(const CubeWall&) = delete;
+    CubeWall& operator=(const CubeWall&) = delete;
+
+    // Advance every animation and script; safe to call with any deltaTime
+    void update(float deltaTime);
+
+    // Cubes whose bounding sphere intersects the frustum of projection * view (column-major),
+    // split at lodDistance from the camera
+    void cull(const float* projection, const float* view, float lodDistance, WallView& out) const;
+
+    int size() const { return static_cast<int>(cubes.size()); }
+    int getColumns() const { return columns; }
+    int getRows() const { return rows; }
+    int threadCount() const { return static_cast<int>(workers.size()) + 1; }
+
+    // Distance from the wall center to its farthest cube corner
+    float getExtent() const;
+
+    const RubikCube& getCube(int index) const { return cubes[index].cube; }
+    const unsigned char* stickerData() const { return stickers.data(); }
+    std::uint64_t getStickerVersion() const { return stickerVersion; }
+    std::uint64_t getMovesApplied() const { return movesApplied; }
+};
+
+#endif // CUBE_WALL_H
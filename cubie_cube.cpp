@@ -0,0 +1,310 @@
+// Cubie-Level Cube Implementation
+// Facelet conversion, cubie multiplication and coordinate ranking
+
+#include "cubie_cube.h"
+#include "move_tables.h"
+#include <utility>
+
+namespace {
+
+// Solved color of each face (RIGHT, LEFT, UP, DOWN, FRONT, BACK)
+const int FACE_COLORS[6] = {RED, ORANGE, WHITE, YELLOW, GREEN, BLUE};
+
+int cornerColor(int corner, int sticker) {
+    return FACE_COLORS[CORNER_FACELETS[corner][sticker].face];
+}
+
+int edgeColor(int edge, int sticker) {
+    return FACE_COLORS[EDGE_FACELETS[edge][sticker].face];
+}
+
+// Lehmer rank of a permutation of 0..n-1 (comparisons kept branch-free)
+template <int N>
+std::uint32_t rankPermutation(const std::uint8_t* perm) {
+    std::uint32_t rank = 0;
+    for (int i = 0; i < N; i++) {
+        std::uint32_t smaller = 0;
+        for (int j = i + 1; j < N; j++) {
+            smaller += static_cast<std::uint32_t>(perm[j] < perm[i]);
+        }
+        rank = rank * (N - i) + smaller;
+    }
+    return rank;
+}
+
+// Factorial-base digits of rank; unrolled so every divisor is a constant
+template <int N, std::size_t... I>
+void factorialDigits(std::uint32_t rank, std::uint32_t* digits, std::index_sequence<I...>) {
+    ((digits[N - 1 - I] = rank % (I + 1), rank /= (I + 1)), ...);
+}
+
+// Inverse of rankPermutation; the unused values live in a nibble-packed list
+template <int N>
+void unrankPermutation(std::uint32_t rank, std::uint8_t* perm) {
+    static_assert(N < 16, "nibble list holds at most 16 values");
+    std::uint32_t digits[N];
+    factorialDigits<N>(rank, digits, std::make_index_sequence<N>());
+
+    std::uint64_t available = 0;
+    for (int i = N - 1; i >= 0; i--) available = (available << 4) | static_cast<std::uint64_t>(i);
+    for (int i = 0; i < N; i++) {
+        int shift = 4 * static_cast<int>(digits[i]);
+        perm[i] = static_cast<std::uint8_t>((available >> shift) & 0xF);
+        std::uint64_t low = available & ((std::uint64_t(1) << shift) - 1);
+        available = low | ((available >> (shift + 4)) << shift);
+    }
+}
+
+// Number of inversions mod 2
+template <int N>
+int permutationParity(const std::uint8_t* perm) {
+    int parity = 0;
+    for (int i = 0; i < N; i++) {
+        for (int j = i + 1; j < N; j++) {
+            parity ^= static_cast<int>(perm[j] < perm[i]);
+        }
+    }
+    return parity;
+}
+
+std::uint64_t mix64(std::uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebull;
+    x ^= x >> 31;
+    return x;
+}
+
+} // namespace
+
+// Identify every cubie from its sticker colors
+bool CubieCube::fromFacelets(const RubikCube& cube, CubieCube& out) {
+    for (int i = 0; i < 8; i++) {
+        int colors[3];
+        for (int n = 0; n < 3; n++) {
+            const StickerRef& f = CORNER_FACELETS[i][n];
+            colors[n] = cube.getColor(f.face, f.row, f.col);
+        }
+        // Twist = which sticker shows the U/D color
+        int ori = 0;
+        while (ori < 3 && colors[ori] != WHITE && colors[ori] != YELLOW) ori++;
+        if (ori == 3) return false;
+
+        int first = colors[(ori + 1) % 3];
+        int second = colors[(ori + 2) % 3];
+        int corner = 0;
+        while (corner < 8 && !(cornerColor(corner, 1) == first && cornerColor(corner, 2) == second)) corner++;
+        if (corner == 8) return false;
+        out.cp[i] = static_cast<std::uint8_t>(corner);
+        out.co[i] = static_cast<std::uint8_t>(ori);
+    }
+
+    for (int i = 0; i < 12; i++) {
+        const StickerRef& a = EDGE_FACELETS[i][0];
+        const StickerRef& b = EDGE_FACELETS[i][1];
+        int first = cube.getColor(a.face, a.row, a.col);
+        int second = cube.getColor(b.face, b.row, b.col);
+        int edge = 0;
+        for (; edge < 12; edge++) {
+            if (edgeColor(edge, 0) == first && edgeColor(edge, 1) == second) {
+                out.eo[i] = 0;
+                break;
+            }
+            if (edgeColor(edge, 0) == second && edgeColor(edge, 1) == first) {
+                out.eo[i] = 1;
+                break;
+            }
+        }
+        if (edge == 12) return false;
+        out.ep[i] = static_cast<std::uint8_t>(edge);
+    }
+    return out.isValid();
+}
+
+// Write stickers for this state (centers are fixed)
+void CubieCube::toFacelets(RubikCube& cube) const {
+    cube.reset();
+    for (int i = 0; i < 8; i++) {
+        for (int n = 0; n < 3; n++) {
+            const StickerRef& f = CORNER_FACELETS[i][(n + co[i]) % 3];
+            cube.setColor(f.face, f.row, f.col, cornerColor(cp[i], n));
+        }
+    }
+    for (int i = 0; i < 12; i++) {
+        for (int n = 0; n < 2; n++) {
+            const StickerRef& f = EDGE_FACELETS[i][(n + eo[i]) % 2];
+            cube.setColor(f.face, f.row, f.col, edgeColor(ep[i], n));
+        }
+    }
+}
+
+// Compose: position i receives what other moves there from this state
+void CubieCube::multiply(const CubieCube& other) {
+    std::uint8_t newCp[8], newCo[8], newEp[12], newEo[12];
+    for (int i = 0; i < 8; i++) {
+        newCp[i] = cp[other.cp[i]];
+        newCo[i] = static_cast<std::uint8_t>((co[other.cp[i]] + other.co[i]) % 3);
+    }
+    for (int i = 0; i < 12; i++) {
+        newEp[i] = ep[other.ep[i]];
+        newEo[i] = static_cast<std::uint8_t>(eo[other.ep[i]] ^ other.eo[i]);
+    }
+    for (int i = 0; i < 8; i++) {
+        cp[i] = newCp[i];
+        co[i] = newCo[i];
+    }
+    for (int i = 0; i < 12; i++) {
+        ep[i] = newEp[i];
+        eo[i] = newEo[i];
+    }
+}
+
+void CubieCube::applyMove(int move) {
+    multiply(moveCube(move));
+}
+
+// Inverse: undo permutation, negate orientation
+CubieCube CubieCube::inverse() const {
+    CubieCube result;
+    for (int i = 0; i < 8; i++) {
+        result.cp[cp[i]] = static_cast<std::uint8_t>(i);
+    }
+    for (int i = 0; i < 8; i++) {
+        result.co[i] = static_cast<std::uint8_t>((3 - co[result.cp[i]]) % 3);
+    }
+    for (int i = 0; i < 12; i++) {
+        result.ep[ep[i]] = static_cast<std::uint8_t>(i);
+    }
+    for (int i = 0; i < 12; i++) {
+        result.eo[i] = eo[result.ep[i]];
+    }
+    return result;
+}
+
+bool CubieCube::isSolved() const {
+    return *this == CubieCube();
+}
+
+// Check the cube group invariants
+bool CubieCube::isValid() const {
+    int seenCorners = 0, seenEdges = 0, twist = 0, flip = 0;
+    for (int i = 0; i < 8; i++) {
+        if (cp[i] >= 8 || co[i] >= 3) return false;
+        seenCorners |= 1 << cp[i];
+        twist += co[i];
+    }
+    for (int i = 0; i < 12; i++) {
+        if (ep[i] >= 12 || eo[i] >= 2) return false;
+        seenEdges |= 1 << ep[i];
+        flip += eo[i];
+    }
+    return seenCorners == 0xFF && seenEdges == 0xFFF && twist % 3 == 0 && flip % 2 == 0 &&
+           permutationParity<8>(cp) == permutationParity<12>(ep);
+}
+
+bool CubieCube::operator==(const CubieCube& other) const {
+    for (int i = 0; i < 8; i++) {
+        if (cp[i] != other.cp[i] || co[i] != other.co[i]) return false;
+    }
+    for (int i = 0; i < 12; i++) {
+        if (ep[i] != other.ep[i] || eo[i] != other.eo[i]) return false;
+    }
+    return true;
+}
+
+// Twist of the first 7 corners in base 3 (the 8th is implied)
+int CubieCube::cornerOrientation() const {
+    int rank = 0;
+    for (int i = 0; i < 7; i++) rank = rank * 3 + co[i];
+    return rank;
+}
+
+void CubieCube::setCornerOrientation(int rank) {
+    int sum = 0;
+    for (int i = 6; i >= 0; i--) {
+        co[i] = static_cast<std::uint8_t>(rank % 3);
+        sum += co[i];
+        rank /= 3;
+    }
+    co[7] = static_cast<std::uint8_t>((3 - sum % 3) % 3);
+}
+
+// Flip of the first 11 edges in base 2 (the 12th is implied)
+int CubieCube::edgeOrientation() const {
+    int rank = 0;
+    for (int i = 0; i < 11; i++) rank = rank * 2 + eo[i];
+    return rank;
+}
+
+void CubieCube::setEdgeOrientation(int rank) {
+    int sum = 0;
+    for (int i = 10; i >= 0; i--) {
+        eo[i] = static_cast<std::uint8_t>(rank & 1);
+        sum += eo[i];
+        rank >>= 1;
+    }
+    eo[11] = static_cast<std::uint8_t>(sum & 1);
+}
+
+int CubieCube::cornerPermutation() const {
+    return static_cast<int>(rankPermutation<8>(cp));
+}
+
+void CubieCube::setCornerPermutation(int rank) {
+    unrankPermutation<8>(static_cast<std::uint32_t>(rank), cp);
+}
+
+std::uint32_t CubieCube::edgePermutation() const {
+    return rankPermutation<12>(ep);
+}
+
+void CubieCube::setEdgePermutation(std::uint32_t rank) {
+    unrankPermutation<12>(rank, ep);
+}
+
+// Bits 0-15 corner perm, 16-27 twist, 28-56 edge perm, 57-67 flip; little-endian
+void CubieCube::encodeRanked(std::uint8_t* out) const {
+    std::uint64_t eoRank = static_cast<std::uint64_t>(edgeOrientation());
+    std::uint64_t low = static_cast<std::uint64_t>(cornerPermutation())
+                      | static_cast<std::uint64_t>(cornerOrientation()) << 16
+                      | static_cast<std::uint64_t>(edgePermutation()) << 28
+                      | (eoRank & 0x7F) << 57;
+    for (int i = 0; i < 8; i++) {
+        out[i] = static_cast<std::uint8_t>(low >> (8 * i));
+    }
+    out[8] = static_cast<std::uint8_t>(eoRank >> 7);
+}
+
+bool CubieCube::decodeRanked(const std::uint8_t* in, CubieCube& out) {
+    std::uint64_t low = 0;
+    for (int i = 0; i < 8; i++) {
+        low |= static_cast<std::uint64_t>(in[i]) << (8 * i);
+    }
+    std::uint32_t cpRank = static_cast<std::uint32_t>(low & 0xFFFF);
+    std::uint32_t coRank = static_cast<std::uint32_t>((low >> 16) & 0xFFF);
+    std::uint32_t epRank = static_cast<std::uint32_t>((low >> 28) & 0x1FFFFFFF);
+    std::uint32_t eoRank = static_cast<std::uint32_t>(low >> 57) | (static_cast<std::uint32_t>(in[8]) << 7);
+    if (cpRank >= CORNER_PERMUTATIONS || coRank >= CORNER_ORIENTATIONS ||
+        epRank >= EDGE_PERMUTATIONS || eoRank >= EDGE_ORIENTATIONS) {
+        return false;
+    }
+    out.setCornerPermutation(static_cast<int>(cpRank));
+    out.setCornerOrientation(static_cast<int>(coRank));
+    out.setEdgePermutation(epRank);
+    out.setEdgeOrientation(static_cast<int>(eoRank));
+    return permutationParity<8>(out.cp) == permutationParity<12>(out.ep);
+}
+
+// Pack into 40 + 60 bits, then mix both words
+std::uint64_t CubieCube::hash() const {
+    std::uint64_t corners = 0, edges = 0;
+    for (int i = 0; i < 8; i++) corners = (corners << 5) | (static_cast<std::uint64_t>(cp[i]) << 2) | co[i];
+    for (int i = 0; i < 12; i++) edges = (edges << 5) | (static_cast<std::uint64_t>(ep[i]) << 1) | eo[i];
+    return mix64(corners ^ mix64(edges));
+}
+
+// Move cubes are generated at compile time (move_tables.cpp)
+const CubieCube& moveCube(int move) {
+    return MOVE_TABLES.moveCubes[move];
+}
@@ -0,0 +1,83 @@
+// Cubie-Level Cube Header
+// Compact 20-cubie representation (permutation + orientation) and coordinate ranking
+
+#ifndef CUBIE_CUBE_H
+#define CUBIE_CUBE_H
+
+#include "rubik_cube.h"
+#include <cstdint>
+
+// Corner positions (U/D sticker listed first, then clockwise)
+enum Corner { URF = 0, UFL, ULB, UBR, DFR, DLF, DBL, DRB };
+
+// Edge positions (U/D or F/B sticker listed first)
+enum Edge { UR = 0, UF, UL, UB, DR, DF, DL, DB, FR, FL, BL, BR };
+
+// Coordinate ranges
+constexpr int CORNER_ORIENTATIONS = 2187;            // 3^7
+constexpr int EDGE_ORIENTATIONS = 2048;              // 2^11
+constexpr int CORNER_PERMUTATIONS = 40320;           // 8!
+constexpr std::uint32_t EDGE_PERMUTATIONS = 479001600u;  // 12!
+
+// Bytes used by encodeRanked()
+constexpr int RANKED_STATE_BYTES = 9;
+
+// Cube state as cubie permutation and orientation.
+// cp[i] is the corner sitting at position i, co[i] its twist (0..2); same for edges (flip 0..1).
+struct CubieCube {
+    std::uint8_t cp[8];
+    std::uint8_t co[8];
+    std::uint8_t ep[12];
+    std::uint8_t eo[12];
+
+    // Solved state; constexpr so move tables can be built at compile time
+    constexpr CubieCube()
+        : cp{URF, UFL, ULB, UBR, DFR, DLF, DBL, DRB}, co{},
+          ep{UR, UF, UL, UB, DR, DF, DL, DB, FR, FL, BL, BR}, eo{} {}
+
+    // Convert from / to the sticker model; fromFacelets fails on impossible sticker layouts
+    static bool fromFacelets(const RubikCube& cube, CubieCube& out);
+    void toFacelets(RubikCube& cube) const;
+
+    // this = this * other (apply other after this)
+    void multiply(const CubieCube& other);
+
+    // Apply a move index (see NUM_MOVES)
+    void applyMove(int move);
+
+    // Inverse permutation / orientation
+    CubieCube inverse() const;
+
+    bool isSolved() const;
+
+    // Reachable from solved: valid permutations, twist sum 0 mod 3, flip sum even, equal parity
+    bool isValid() const;
+
+    bool operator==(const CubieCube& other) const;
+    bool operator!=(const CubieCube& other) const { return !(*this == other); }
+
+    // Coordinates (ranks); the setters rebuild the matching part of the state
+    int cornerOrientation() const;
+    void setCornerOrientation(int rank);
+    int edgeOrientation() const;
+    void setEdgeOrientation(int rank);
+    int cornerPermutation() const;
+    void setCornerPermutation(int rank);
+    std::uint32_t edgePermutation() const;
+    void setEdgePermutation(std::uint32_t rank);
+
+    // 9-byte ranked encoding: corner perm, corner twist, edge perm, edge flip (68 bits)
+    void encodeRanked(std::uint8_t* out) const;
+    static bool decodeRanked(const std::uint8_t* in, CubieCube& out);
+
+    // 64-bit hash of the full state
+    std::uint64_t hash() const;
+};
+
+// The 18 move cubes (compile-time, see move_tables.h)
+const CubieCube& moveCube(int move);
+
+// Inverse of a move index (R <-> R', R2 <-> R2)
+inline int inverseMove(int move) { return move - (move % 3) + (2 - move % 3); }
+
+#endif // CUBIE_CUBE_H
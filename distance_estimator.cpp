@@ -0,0 +1,418 @@
+// Distance Estimator Implementation
+// Feature extraction, batched network evaluation, LRU cache and the UI worker thread
+
+#include "distance_estimator.h"
+#include "profiler.h"
+#include <algorithm>
+
+namespace {
+
+// Trained with `rubik_estimate fit` (seed 1, 100000 samples)
+const EstimatorWeights DEFAULT_WEIGHTS = {
+    {
+        {0.038140f, 0.008581f, -0.105954f, -0.134344f, -0.061844f, -0.180665f, -0.106914f, -0.253363f, 0.233364f, -0.232937f, 0.104213f, -0.052668f, 0.212391f},
+        {0.136879f, 0.159179f, 0.108639f, -0.042027f, 0.052945f, -0.217665f, -0.031464f, -0.425322f, -0.028196f, 0.019152f, 0.918235f, 0.474160f, -3.792707f},
+        {0.305207f, 0.054497f, -0.357128f, -0.103684f, -0.244153f, -0.068565f, -0.118205f, 0.409452f, -0.135751f, 0.021772f, 0.399969f, 1.120565f, -1.394272f},
+        {0.074146f, -0.065220f, -0.319815f, 0.209664f, -0.235989f, -0.146754f, -0.011280f, -0.501665f, -0.046353f, -0.275070f, 0.093140f, -0.245954f, -0.311456f},
+        {-0.130565f, -0.041808f, 0.287442f, 0.114616f, -0.176515f, 0.521405f, 0.030621f, 0.887501f, 0.058519f, 0.011215f, -0.046859f, 0.513383f, -2.017699f},
+        {-0.490842f, 0.109583f, -0.056068f, -0.127103f, -0.070890f, 0.014343f, -0.213975f, 0.112488f, 0.048258f, -0.177220f, -0.206643f, 0.519866f, -0.051912f},
+        {-0.383836f, -0.017259f, 0.110423f, 0.185759f, -0.501480f, -0.107346f, -0.076217f, -0.736501f, 0.030187f, -0.348277f, 0.094597f, -0.099669f, 0.000993f},
+        {0.001711f, 0.089854f, -0.092889f, -0.053662f, 0.189894f, -0.277521f, -0.070954f, -0.774525f, -0.065958f, 0.024213f, 1.773103f, -0.969036f, 0.887226f},
+    },
+    {-0.053303f, 0.000740f, 0.278514f, 0.092678f, 0.797496f, -0.452785f, -0.162982f, -0.383950f},
+    {-0.019237f, 0.293467f, 0.096839f, -0.294925f, 0.214814f, 0.256762f, -0.006261f, 0.210789f},
+    0.051195f
+};
+
+float relu(float x) {
+    return x > 0.0f ? x : 0.0f;
+}
+
+int choose(int n, int k) {
+    if (k < 0 || k > n) return 0;
+    int result = 1;
+    for (int i = 1; i <= k; i++) result = result * (n - k + i) / i;
+    return result;
+}
+
+// Positions p0 < p1 < p2 < p3 of the slice edges, in the combinatorial number system
+int rankSlice(const int* positions) {
+    int rank = 0;
+    for (int i = 0; i < 4; i++) rank += choose(positions[i], i + 1);
+    return rank;
+}
+
+void unrankSlice(int rank, int* positions) {
+    for (int i = 3; i >= 0; i--) {
+        int p = i;
+        while (choose(p + 1, i + 1) <= rank) p++;
+        positions[i] = p;
+        rank -= choose(p, i + 1);
+    }
+}
+
+// Corner and edge that are neighbours on the solved cube
+const int CORNER_EDGE_PAIRS[24][2] = {
+    {URF, UR}, {URF, UF}, {URF, FR}, {UFL, UF}, {UFL, UL}, {UFL, FL},
+    {ULB, UL}, {ULB, UB}, {ULB, BL}, {UBR, UB}, {UBR, UR}, {UBR, BR},
+    {DFR, DF}, {DFR, DR}, {DFR, FR}, {DLF, DL}, {DLF, DF}, {DLF, FL},
+    {DBL, DB}, {DBL, DL}, {DBL, BL}, {DRB, DR}, {DRB, DB}, {DRB, BR}
+};
+
+// Placements (corner code pos*3+twist, edge code pos*2+flip) in which a solved neighbour pair
+// still forms a block: everything reachable by turning faces that carry both pieces together
+struct PairTables {
+    std::uint8_t intact[24][24 * 24];
+
+    PairTables() : intact() {
+        for (int pair = 0; pair < 24; pair++) {
+            std::vector<int> frontier(1, CORNER_EDGE_PAIRS[pair][0] * 3 * 24 + CORNER_EDGE_PAIRS[pair][1] * 2);
+            intact[pair][frontier[0]] = 1;
+            while (!frontier.empty()) {
+                int state = frontier.back();
+                frontier.pop_back();
+                int corner = state / 24, edge = state % 24;
+                for (int move = 0; move < NUM_MOVES; move++) {
+                    const CubieCube& turn = moveCube(move);
+                    int cornerTo = 0, edgeTo = 0;
+                    while (turn.cp[cornerTo] != corner / 3) cornerTo++;
+                    while (turn.ep[edgeTo] != edge / 2) edgeTo++;
+                    if ((cornerTo != corner / 3) != (edgeTo != edge / 2)) continue;  // Would split the pair
+                    int next = (cornerTo * 3 + (corner % 3 + turn.co[cornerTo]) % 3) * 24 +
+                               edgeTo * 2 + (edge % 2 ^ turn.eo[edgeTo]);
+                    if (!intact[pair][next]) {
+                        intact[pair][next] = 1;
+                        frontier.push_back(next);
+                    }
+                }
+            }
+        }
+    }
+};
+
+const PairTables& pairTables() {
+    static const PairTables tables;
+    return tables;
+}
+
+// BFS over coordinate pairs (orientation, slice) from the solved pair
+std::vector<std::uint8_t> buildPairDistance(const std::uint16_t* orientationMove, int orientations,
+                                            const std::vector<std::uint16_t>& sliceMove, int solvedSlice) {
+    std::vector<std::uint8_t> distance(static_cast<std::size_t>(orientations) * SLICE_POSITIONS, 0xFF);
+    std::vector<std::uint32_t> frontier(1, static_cast<std::uint32_t>(solvedSlice)), next;
+    distance[solvedSlice] = 0;
+    for (std::uint8_t depth = 0; !frontier.empty(); depth++) {
+        next.clear();
+        for (std::uint32_t index : frontier) {
+            int orientation = static_cast<int>(index / SLICE_POSITIONS);
+            int slice = static_cast<int>(index % SLICE_POSITIONS);
+            for (int move = 0; move < NUM_MOVES; move++) {
+                std::uint32_t reached = orientationMove[orientation * NUM_MOVES + move] * SLICE_POSITIONS +
+                                        sliceMove[slice * NUM_MOVES + move];
+                if (distance[reached] == 0xFF) {
+                    distance[reached] = static_cast<std::uint8_t>(depth + 1);
+                    next.push_back(reached);
+                }
+            }
+        }
+        frontier.swap(next);
+    }
+    return distance;
+}
+
+} // namespace
+
+const EstimatorWeights& defaultEstimatorWeights() {
+    return DEFAULT_WEIGHTS;
+}
+
+// SlicePatternTables
+SlicePatternTables::SlicePatternTables() {
+    PROFILE_SCOPE("SlicePatternTables::build");
+    sliceMove.resize(SLICE_POSITIONS * NUM_MOVES);
+    for (int rank = 0; rank < SLICE_POSITIONS; rank++) {
+        int positions[4];
+        unrankSlice(rank, positions);
+        for (int move = 0; move < NUM_MOVES; move++) {
+            // Only which positions hold slice edges matters, so the other edges can go anywhere
+            CubieCube cube;
+            int slice = FR, other = UR;
+            for (int i = 0; i < 12; i++) {
+                bool inSlice = std::find(positions, positions + 4, i) != positions + 4;
+                cube.ep[i] = static_cast<std::uint8_t>(inSlice ? slice++ : other++);
+            }
+            cube.applyMove(move);
+            sliceMove[rank * NUM_MOVES + move] = static_cast<std::uint16_t>(sliceCoordinate(cube));
+        }
+    }
+    const CoordinateTables& tables = CoordinateTables::instance();
+    int solved = sliceCoordinate(CubieCube());
+    flipSliceDistance = buildPairDistance(tables.flipMove, EDGE_ORIENTATIONS, sliceMove, solved);
+    twistSliceDistance = buildPairDistance(tables.twistMove, CORNER_ORIENTATIONS, sliceMove, solved);
+}
+
+const SlicePatternTables& SlicePatternTables::instance() {
+    static const SlicePatternTables tables;
+    return tables;
+}
+
+int SlicePatternTables::sliceCoordinate(const CubieCube& cube) {
+    int positions[4], found = 0;
+    for (int i = 0; i < 12; i++) {
+        if (cube.ep[i] >= FR) positions[found++] = i;
+    }
+    return rankSlice(positions);
+}
+
+int estimatorFeatures(const CubieCube& cube, float* features) {
+    const CoordinateTables& tables = CoordinateTables::instance();
+    const SlicePatternTables& patterns = SlicePatternTables::instance();
+    int twist = tables.twistDistance[cube.cornerOrientation()];
+    int flip = tables.flipDistance[cube.edgeOrientation()];
+    int permutation = tables.permutationDistance[cube.cornerPermutation()];
+    int slice = SlicePatternTables::sliceCoordinate(cube);
+    int flipSlice = patterns.flipSliceDistance[cube.edgeOrientation() * SLICE_POSITIONS + slice];
+    int twistSlice = patterns.twistSliceDistance[cube.cornerOrientation() * SLICE_POSITIONS + slice];
+
+    int cornerCode[8], edgeCode[12];
+    int misplacedCorners = 0, twistedCorners = 0, solvedPieces = 0, parity = 0;
+    for (int i = 0; i < 8; i++) {
+        cornerCode[cube.cp[i]] = i * 3 + cube.co[i];
+        misplacedCorners += cube.cp[i] != i;
+        twistedCorners += cube.co[i] != 0;
+        solvedPieces += cube.cp[i] == i && cube.co[i] == 0;
+        for (int j = i + 1; j < 8; j++) parity ^= static_cast<int>(cube.cp[j] < cube.cp[i]);
+    }
+    int misplacedEdges = 0, flippedEdges = 0, sliceOutside = 0;
+    for (int i = 0; i < 12; i++) {
+        edgeCode[cube.ep[i]] = i * 2 + cube.eo[i];
+        misplacedEdges += cube.ep[i] != i;
+        flippedEdges += cube.eo[i] != 0;
+        solvedPieces += cube.ep[i] == i && cube.eo[i] == 0;
+        sliceOutside += cube.ep[i] >= FR && i < FR;
+    }
+    const PairTables& pairs = pairTables();
+    int intactPairs = 0;
+    for (int pair = 0; pair < 24; pair++) {
+        intactPairs += pairs.intact[pair][cornerCode[CORNER_EDGE_PAIRS[pair][0]] * 24 + edgeCode[CORNER_EDGE_PAIRS[pair][1]]];
+    }
+
+    features[0] = twist / 6.0f;
+    features[1] = flip / 7.0f;
+    features[2] = permutation / 7.0f;
+    features[3] = misplacedCorners / 8.0f;
+    features[4] = twistedCorners / 8.0f;
+    features[5] = misplacedEdges / 12.0f;
+    features[6] = flippedEdges / 12.0f;
+    features[7] = solvedPieces / 20.0f;
+    features[8] = sliceOutside / 4.0f;
+    features[9] = static_cast<float>(parity);
+    features[10] = flipSlice / 9.0f;
+    features[11] = twistSlice / 9.0f;
+    features[12] = intactPairs / 24.0f;
+    return std::max({twist, flip, permutation, flipSlice, twistSlice});
+}
+
+// EstimateCache - doubly linked list threaded through the entry array
+EstimateCache::EstimateCache(std::size_t capacity)
+    : capacity(std::max<std::size_t>(capacity, 1)), head(NONE), tail(NONE) {
+    entries.reserve(this->capacity);
+    index.reserve(this->capacity);
+}
+
+void EstimateCache::unlink(std::uint32_t slot) {
+    Entry& entry = entries[slot];
+    if (entry.prev != NONE) entries[entry.prev].next = entry.next; else head = entry.next;
+    if (entry.next != NONE) entries[entry.next].prev = entry.prev; else tail = entry.prev;
+}
+
+void EstimateCache::pushFront(std::uint32_t slot) {
+    Entry& entry = entries[slot];
+    entry.prev = NONE;
+    entry.next = head;
+    if (head != NONE) entries[head].prev = slot;
+    head = slot;
+    if (tail == NONE) tail = slot;
+}
+
+bool EstimateCache::find(std::uint64_t key, DistanceEstimate& value) {
+    auto it = index.find(key);
+    if (it == index.end()) return false;
+    if (it->second != head) {
+        unlink(it->second);
+        pushFront(it->second);
+    }
+    value = entries[it->second].value;
+    return true;
+}
+
+void EstimateCache::insert(std::uint64_t key, const DistanceEstimate& value) {
+    auto it = index.find(key);
+    if (it != index.end()) {
+        entries[it->second].value = value;
+        return;
+    }
+    std::uint32_t slot;
+    if (entries.size() < capacity) {
+        slot = static_cast<std::uint32_t>(entries.size());
+        entries.push_back(Entry());
+    } else {
+        // Reuse the least recently used slot
+        slot = tail;
+        unlink(slot);
+        index.erase(entries[slot].key);
+    }
+    entries[slot].key = key;
+    entries[slot].value = value;
+    pushFront(slot);
+    index.emplace(key, slot);
+}
+
+void EstimateCache::clear() {
+    entries.clear();
+    index.clear();
+    head = tail = NONE;
+}
+
+// DistanceEstimator
+DistanceEstimator::DistanceEstimator(std::size_t cacheCapacity)
+    : weights(DEFAULT_WEIGHTS), cache(cacheCapacity), hits(0), misses(0) {
+    SlicePatternTables::instance();  // Build the tables here rather than in the first estimate
+    pairTables();
+}
+
+void DistanceEstimator::setWeights(const EstimatorWeights& newWeights) {
+    std::lock_guard<std::mutex> lock(mutex);
+    weights = newWeights;
+    cache.clear();
+}
+
+// Evaluate the cubes listed in batchMisses: features for all rows first, then each layer
+// over the whole batch so every weight row is loaded once per batch instead of once per cube
+void DistanceEstimator::evaluateMisses(const CubieCube* cubes, DistanceEstimate* out) {
+    std::size_t count = batchMisses.size();
+    batchFeatures.resize(count * ESTIMATOR_FEATURES);
+    batchHidden.resize(count * ESTIMATOR_HIDDEN);
+
+    for (std::size_t row = 0; row < count; row++) {
+        out[batchMisses[row]].lowerBound =
+            estimatorFeatures(cubes[batchMisses[row]], &batchFeatures[row * ESTIMATOR_FEATURES]);
+    }
+    for (int h = 0; h < ESTIMATOR_HIDDEN; h++) {
+        const float* w = weights.hidden[h];
+        for (std::size_t row = 0; row < count; row++) {
+            const float* x = &batchFeatures[row * ESTIMATOR_FEATURES];
+            float sum = weights.hiddenBias[h];
+            for (int f = 0; f < ESTIMATOR_FEATURES; f++) sum += w[f] * x[f];
+            batchHidden[row * ESTIMATOR_HIDDEN + h] = relu(sum);
+        }
+    }
+    for (std::size_t row = 0; row < count; row++) {
+        const float* hidden = &batchHidden[row * ESTIMATOR_HIDDEN];
+        float sum = weights.outputBias;
+        for (int h = 0; h < ESTIMATOR_HIDDEN; h++) sum += weights.output[h] * hidden[h];
+
+        // All three coordinates solved with edges still permuted is at least one move away
+        const CubieCube& cube = cubes[batchMisses[row]];
+        DistanceEstimate& estimate = out[batchMisses[row]];
+        if (cube.isSolved()) {
+            estimate.moves = 0.0f;
+        } else {
+            estimate.lowerBound = std::max(estimate.lowerBound, 1);
+            estimate.moves = std::min(std::max(sum * ESTIMATOR_SCALE, static_cast<float>(estimate.lowerBound)),
+                                      static_cast<float>(MAX_SEARCH_DEPTH));
+        }
+        cache.insert(cube.hash(), estimate);
+    }
+}
+
+DistanceEstimate DistanceEstimator::estimate(const CubieCube& cube) {
+    DistanceEstimate result;
+    estimateBatch(&cube, 1, &result);
+    return result;
+}
+
+bool DistanceEstimator::estimate(const RubikCube& cube, DistanceEstimate& out) {
+    CubieCube cubie;
+    if (!CubieCube::fromFacelets(cube, cubie)) return false;
+    out = estimate(cubie);
+    return true;
+}
+
+void DistanceEstimator::estimateBatch(const CubieCube* cubes, std::size_t count, DistanceEstimate* out) {
+    PROFILE_SCOPE("DistanceEstimator::estimateBatch");
+    std::lock_guard<std::mutex> lock(mutex);
+    batchMisses.clear();
+    for (std::size_t i = 0; i < count; i++) {
+        if (!cache.find(cubes[i].hash(), out[i])) batchMisses.push_back(i);
+    }
+    hits += count - batchMisses.size();
+    misses += batchMisses.size();
+    if (!batchMisses.empty()) evaluateMisses(cubes, out);
+}
+
+// AsyncEstimator
+AsyncEstimator::AsyncEstimator() : hasPending(false), busy(false), hasResult(false), stopping(false), result() {
+    worker = std::thread(&AsyncEstimator::run, this);
+}
+
+AsyncEstimator::~AsyncEstimator() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    worker.join();
+}
+
+void AsyncEstimator::run() {
+    DistanceEstimator estimator;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [this] { return hasPending || stopping; });
+        if (stopping) return;
+        CubieCube cube = pending;
+        hasPending = false;
+        busy = true;
+
+        lock.unlock();
+        DistanceEstimate estimate = estimator.estimate(cube);
+        lock.lock();
+        // A state posted meanwhile makes this estimate stale; only the newest one is published
+        if (!hasPending) {
+            result = estimate;
+            hasResult = true;
+        }
+        busy = false;
+        done.notify_all();
+    }
+}
+
+void AsyncEstimator::post(const RubikCube& cube) {
+    CubieCube cubie;
+    if (!CubieCube::fromFacelets(cube, cubie)) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending = cubie;
+        hasPending = true;
+        hasResult = false;
+    }
+    wake.notify_one();
+}
+
+bool AsyncEstimator::wait(DistanceEstimate& out) {
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return !hasPending && !busy; });
+    if (!hasResult) return false;
+    out = result;
+    hasResult = false;
+    return true;
+}
+
+bool AsyncEstimator::poll(DistanceEstimate& out) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!hasResult || hasPending || busy) return false;
+    out = result;
+    hasResult = false;
+    return true;
+}
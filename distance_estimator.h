@@ -0,0 +1,150 @@
+// Distance Estimator Header
+// "How far from solved" estimates: coordinate lower bounds, a small regressor, an LRU cache
+//
+// The estimate is max(lower bound, regressor output). The lower bound is the largest of five
+// pattern database distances: the three CoordinateTables ones plus (edge flip x middle-slice
+// edge positions) and (corner twist x middle-slice positions), about 1 MB each. The regressor
+// is a 13-8-1 ReLU network over those distances, cheap piece statistics and the number of
+// solved corner-edge neighbour pairs still joined as blocks, trained by
+// `rubik_estimate fit`. Results are memoized by CubieCube::hash(), so the same state reached
+// by different move orders hits the cache.
+
+#ifndef DISTANCE_ESTIMATOR_H
+#define DISTANCE_ESTIMATOR_H
+
+#include "cube_search.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+constexpr int ESTIMATOR_FEATURES = 13;
+constexpr int ESTIMATOR_HIDDEN = 8;
+constexpr float ESTIMATOR_SCALE = 20.0f;  // Network output is moves / ESTIMATOR_SCALE
+constexpr int SLICE_POSITIONS = 495;      // 12 choose 4 places for the FR/FL/BL/BR edges
+
+struct DistanceEstimate {
+    float moves;     // Best guess of the optimal (half-turn metric) distance
+    int lowerBound;  // Proven lower bound
+};
+
+// Regressor parameters; defaultEstimatorWeights() holds the ones shipped with the game
+struct EstimatorWeights {
+    float hidden[ESTIMATOR_HIDDEN][ESTIMATOR_FEATURES];
+    float hiddenBias[ESTIMATOR_HIDDEN];
+    float output[ESTIMATOR_HIDDEN];
+    float outputBias;
+};
+
+const EstimatorWeights& defaultEstimatorWeights();
+
+// Distance tables pairing an orientation coordinate with the middle-slice edge positions
+class SlicePatternTables {
+private:
+    SlicePatternTables();
+
+public:
+    std::vector<std::uint16_t> sliceMove;          // SLICE_POSITIONS * NUM_MOVES
+    std::vector<std::uint8_t> flipSliceDistance;   // [flip * SLICE_POSITIONS + slice]
+    std::vector<std::uint8_t> twistSliceDistance;  // [twist * SLICE_POSITIONS + slice]
+
+    // Built on first use (~0.2 s), then shared
+    static const SlicePatternTables& instance();
+
+    static int sliceCoordinate(const CubieCube& cube);
+};
+
+// Network input for one cube (all features roughly in 0..1); returns the lower bound
+int estimatorFeatures(const CubieCube& cube, float* features);
+
+// Fixed-capacity LRU map from state hash to estimate (entries linked by index, no per-use allocation)
+class EstimateCache {
+private:
+    static constexpr std::uint32_t NONE = 0xFFFFFFFFu;
+
+    struct Entry {
+        std::uint64_t key;
+        DistanceEstimate value;
+        std::uint32_t prev;
+        std::uint32_t next;
+    };
+
+    std::vector<Entry> entries;
+    std::unordered_map<std::uint64_t, std::uint32_t> index;
+    std::size_t capacity;
+    std::uint32_t head;  // Most recently used
+    std::uint32_t tail;  // Next to evict
+
+    void unlink(std::uint32_t slot);
+    void pushFront(std::uint32_t slot);
+
+public:
+    explicit EstimateCache(std::size_t capacity);
+
+    // Marks the entry most recently used
+    bool find(std::uint64_t key, DistanceEstimate& value);
+    void insert(std::uint64_t key, const DistanceEstimate& value);
+
+    std::size_t size() const { return index.size(); }
+    void clear();
+};
+
+// Thread-safe estimator; batch calls take the lock once and run the network layer by layer
+class DistanceEstimator {
+private:
+    EstimatorWeights weights;
+    EstimateCache cache;
+    std::mutex mutex;
+    std::vector<float> batchFeatures;  // Reused scratch for misses
+    std::vector<float> batchHidden;
+    std::vector<std::size_t> batchMisses;
+    std::uint64_t hits;
+    std::uint64_t misses;
+
+    void evaluateMisses(const CubieCube* cubes, DistanceEstimate* out);
+
+public:
+    explicit DistanceEstimator(std::size_t cacheCapacity = 1 << 16);
+
+    void setWeights(const EstimatorWeights& newWeights);
+
+    DistanceEstimate estimate(const CubieCube& cube);
+    bool estimate(const RubikCube& cube, DistanceEstimate& out);  // False for impossible sticker layouts
+    void estimateBatch(const CubieCube* cubes, std::size_t count, DistanceEstimate* out);
+
+    std::uint64_t cacheHits() const { return hits; }
+    std::uint64_t cacheMisses() const { return misses; }
+};
+
+// Background estimates for the UI: post() never blocks on evaluation, the newest posted state
+// wins, and poll() returns each finished result once. Tables are built on the worker thread.
+class AsyncEstimator {
+private:
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    std::thread worker;
+    CubieCube pending;
+    bool hasPending;
+    bool busy;
+    bool hasResult;
+    bool stopping;
+    DistanceEstimate result;
+
+    void run();
+
+public:
+    AsyncEstimator();
+    ~AsyncEstimator();
+
+    void post(const RubikCube& cube);
+    bool poll(DistanceEstimate& out);
+
+    // Block until the last posted state is estimated; false if there is nothing to wait for
+    bool wait(DistanceEstimate& out);
+};
+
+#endif // DISTANCE_ESTIMATOR_H
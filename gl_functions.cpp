@@ -0,0 +1,30 @@
+// OpenGL Function Loader Implementation
+// Looks up every entry point through SFML's context
+
+#include "gl_functions.h"
+#include <SFML/Window.hpp>
+#include <cstdio>
+#include <iostream>
+
+GLCoreFunctions glCore = {};
+
+// Resolve all functions listed in RUBIK_GL_FUNCTIONS
+bool loadGLCoreFunctions() {
+    bool complete = true;
+#define RUBIK_GL_LOAD(ret, name, params) \
+    glCore.name = reinterpret_cast<ret (APIENTRY *) params>(sf::Context::getFunction("gl" #name)); \
+    if (!glCore.name) { \
+        std::cerr << "Warning: OpenGL function gl" #name " not available." << std::endl; \
+        complete = false; \
+    }
+    RUBIK_GL_FUNCTIONS(RUBIK_GL_LOAD)
+#undef RUBIK_GL_LOAD
+    return complete;
+}
+
+// Parse "major.minor" from the version string of the current context
+bool getGLVersion(int& major, int& minor) {
+    const char* version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+    if (!version) return false;
+    return std::sscanf(version, "%d.%d", &major, &minor) == 2;
+}
@@ -0,0 +1,118 @@
+// OpenGL Function Loader Header
+// Resolves the OpenGL 3.3 entry points used by the shader renderer
+
+#ifndef GL_FUNCTIONS_H
+#define GL_FUNCTIONS_H
+
+#include <SFML/OpenGL.hpp>
+#include <cstddef>
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+// Types and enums missing from OpenGL 1.1 headers (e.g. Windows gl.h)
+typedef char GLchar;
+typedef std::ptrdiff_t GLsizeiptr;
+typedef std::ptrdiff_t GLintptr;
+
+#ifndef GL_ARRAY_BUFFER
+#define GL_ARRAY_BUFFER 0x8892
+#endif
+#ifndef GL_ELEMENT_ARRAY_BUFFER
+#define GL_ELEMENT_ARRAY_BUFFER 0x8893
+#endif
+#ifndef GL_UNIFORM_BUFFER
+#define GL_UNIFORM_BUFFER 0x8A11
+#endif
+#ifndef GL_STATIC_DRAW
+#define GL_STATIC_DRAW 0x88E4
+#endif
+#ifndef GL_STREAM_DRAW
+#define GL_STREAM_DRAW 0x88E0
+#endif
+#ifndef GL_DYNAMIC_DRAW
+#define GL_DYNAMIC_DRAW 0x88E8
+#endif
+#ifndef GL_VERTEX_SHADER
+#define GL_VERTEX_SHADER 0x8B31
+#endif
+#ifndef GL_FRAGMENT_SHADER
+#define GL_FRAGMENT_SHADER 0x8B30
+#endif
+#ifndef GL_COMPILE_STATUS
+#define GL_COMPILE_STATUS 0x8B81
+#endif
+#ifndef GL_LINK_STATUS
+#define GL_LINK_STATUS 0x8B82
+#endif
+#ifndef GL_INFO_LOG_LENGTH
+#define GL_INFO_LOG_LENGTH 0x8B84
+#endif
+#ifndef GL_TEXTURE0
+#define GL_TEXTURE0 0x84C0
+#endif
+#ifndef GL_R8UI
+#define GL_R8UI 0x8232
+#endif
+#ifndef GL_RED_INTEGER
+#define GL_RED_INTEGER 0x8D94
+#endif
+#ifndef GL_PROGRAM_POINT_SIZE
+#define GL_PROGRAM_POINT_SIZE 0x8642
+#endif
+#ifndef GL_INVALID_INDEX
+#define GL_INVALID_INDEX 0xFFFFFFFFu
+#endif
+
+// Entry point list: return type, name (without "gl" prefix), parameter list
+#define RUBIK_GL_FUNCTIONS(X) \
+    X(GLuint, CreateShader, (GLenum type)) \
+    X(void, ShaderSource, (GLuint shader, GLsizei count, const GLchar* const* source, const GLint* length)) \
+    X(void, CompileShader, (GLuint shader)) \
+    X(void, GetShaderiv, (GLuint shader, GLenum pname, GLint* params)) \
+    X(void, GetShaderInfoLog, (GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog)) \
+    X(void, DeleteShader, (GLuint shader)) \
+    X(GLuint, CreateProgram, (void)) \
+    X(void, AttachShader, (GLuint program, GLuint shader)) \
+    X(void, LinkProgram, (GLuint program)) \
+    X(void, GetProgramiv, (GLuint program, GLenum pname, GLint* params)) \
+    X(void, GetProgramInfoLog, (GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog)) \
+    X(void, DeleteProgram, (GLuint program)) \
+    X(void, UseProgram, (GLuint program)) \
+    X(GLint, GetUniformLocation, (GLuint program, const GLchar* name)) \
+    X(GLuint, GetUniformBlockIndex, (GLuint program, const GLchar* name)) \
+    X(void, UniformBlockBinding, (GLuint program, GLuint blockIndex, GLuint binding)) \
+    X(void, Uniform1i, (GLint location, GLint v0)) \
+    X(void, GenVertexArrays, (GLsizei n, GLuint* arrays)) \
+    X(void, BindVertexArray, (GLuint array)) \
+    X(void, DeleteVertexArrays, (GLsizei n, const GLuint* arrays)) \
+    X(void, GenBuffers, (GLsizei n, GLuint* buffers)) \
+    X(void, BindBuffer, (GLenum target, GLuint buffer)) \
+    X(void, BindBufferBase, (GLenum target, GLuint index, GLuint buffer)) \
+    X(void, BufferData, (GLenum target, GLsizeiptr size, const void* data, GLenum usage)) \
+    X(void, BufferSubData, (GLenum target, GLintptr offset, GLsizeiptr size, const void* data)) \
+    X(void, DeleteBuffers, (GLsizei n, const GLuint* buffers)) \
+    X(void, EnableVertexAttribArray, (GLuint index)) \
+    X(void, VertexAttribPointer, (GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer)) \
+    X(void, VertexAttribIPointer, (GLuint index, GLint size, GLenum type, GLsizei stride, const void* pointer)) \
+    X(void, VertexAttribDivisor, (GLuint index, GLuint divisor)) \
+    X(void, DrawElementsInstanced, (GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instancecount)) \
+    X(void, ActiveTexture, (GLenum texture))
+
+// Table of loaded function pointers, called as glCore.CreateShader(...)
+struct GLCoreFunctions {
+#define RUBIK_GL_DECLARE(ret, name, params) ret (APIENTRY *name) params;
+    RUBIK_GL_FUNCTIONS(RUBIK_GL_DECLARE)
+#undef RUBIK_GL_DECLARE
+};
+
+extern GLCoreFunctions glCore;
+
+// Load all entry points from the current context; returns false if any is missing
+bool loadGLCoreFunctions();
+
+// Major/minor version of the current context (parsed from GL_VERSION)
+bool getGLVersion(int& major, int& minor);
+
+#endif // GL_FUNCTIONS_H
@@ -0,0 +1,188 @@
+// Headless Script Implementation
+// Script parsing, phase statistics and the JSON report
+
+#include "headless_script.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+struct KeyName {
+    const char* name;
+    sf::Keyboard::Key key;
+};
+
+const KeyName KEY_NAMES[] = {
+    {"Q", sf::Keyboard::Q}, {"W", sf::Keyboard::W}, {"E", sf::Keyboard::E}, {"R", sf::Keyboard::R},
+    {"T", sf::Keyboard::T}, {"Y", sf::Keyboard::Y}, {"S", sf::Keyboard::S}, {"H", sf::Keyboard::H},
+    {"I", sf::Keyboard::I}, {"Space", sf::Keyboard::Space}, {"F4", sf::Keyboard::F4}, {"F5", sf::Keyboard::F5}
+};
+
+// The frame-time overlay draws wall-clock measurements, which would change the image checksum
+const char* const UNSCRIPTABLE_KEY = "F3";
+
+const char* const PHASE_NAMES[HEADLESS_PHASES] = {"input", "update", "estimate", "render", "finish"};
+
+bool parseKey(const std::string& name, sf::Keyboard::Key& key) {
+    for (const KeyName& entry : KEY_NAMES) {
+        if (name == entry.name) {
+            key = entry.key;
+            return true;
+        }
+    }
+    return false;
+}
+
+struct PhaseStats {
+    double total, mean, p50, p99, max;
+};
+
+PhaseStats phaseStats(std::vector<float> samples) {
+    PhaseStats stats = {};
+    if (samples.empty()) return stats;
+    for (float ms : samples) stats.total += ms;
+    std::sort(samples.begin(), samples.end());
+    auto at = [&](double fraction) {
+        return samples[std::min(samples.size() - 1, static_cast<std::size_t>(fraction * samples.size()))];
+    };
+    stats.mean = stats.total / samples.size();
+    stats.p50 = at(0.5);
+    stats.p99 = at(0.99);
+    stats.max = samples.back();
+    return stats;
+}
+
+std::string jsonString(const std::string& text) {
+    std::string out = "\"";
+    for (char c : text) {
+        unsigned char code = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (c == '\n') {
+            out += "\\n";
+        } else if (c == '\t') {
+            out += "\\t";
+        } else if (code < 0x20) {
+            const char* digits = "0123456789abcdef";
+            out += "\\u00";
+            out += digits[code >> 4];
+            out += digits[code & 0xF];
+        } else {
+            out += c;
+        }
+    }
+    return out + "\"";
+}
+
+std::string hex(std::uint64_t value) {
+    std::ostringstream text;
+    text << std::hex << std::setw(16) << std::setfill('0') << value;
+    return text.str();
+}
+
+} // namespace
+
+bool loadHeadlessScript(const std::string& path, std::vector<ScriptCommand>& commands, std::string& error) {
+    std::ifstream in(path);
+    if (!in) {
+        error = "cannot open " + path;
+        return false;
+    }
+    std::string line;
+    int number = 0;
+    while (std::getline(in, line)) {
+        number++;
+        std::size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+        std::istringstream words(line);
+        std::string verb;
+        if (!(words >> verb)) continue;
+
+        ScriptCommand command = {SCRIPT_IDLE, sf::Keyboard::Unknown, false, 0, 0, 0};
+        bool valid = true;
+        if (verb == "key") {
+            std::string name, modifier;
+            command.type = SCRIPT_KEY;
+            if (words >> name && name == UNSCRIPTABLE_KEY) {
+                error = "line " + std::to_string(number) + ": " + name +
+                        " is not scriptable, its overlay shows wall-clock frame times";
+                return false;
+            }
+            valid = !name.empty() && parseKey(name, command.key);
+            if (valid && words >> modifier) {
+                command.shift = modifier == "shift";
+                valid = command.shift;
+            }
+        } else if (verb == "press" || verb == "move") {
+            command.type = verb == "press" ? SCRIPT_PRESS : SCRIPT_MOVE;
+            valid = static_cast<bool>(words >> command.x >> command.y);
+        } else if (verb == "release") {
+            command.type = SCRIPT_RELEASE;
+        } else if (verb == "wheel") {
+            command.type = SCRIPT_WHEEL;
+            valid = static_cast<bool>(words >> command.x);
+        } else if (verb == "frames") {
+            command.type = SCRIPT_FRAMES;
+            valid = static_cast<bool>(words >> command.count) && command.count > 0;
+        } else if (verb == "idle") {
+            command.type = SCRIPT_IDLE;
+        } else {
+            valid = false;
+        }
+        std::string extra;
+        if (!valid || words >> extra) {
+            error = "line " + std::to_string(number) + ": cannot parse \"" + line + "\"";
+            return false;
+        }
+        commands.push_back(command);
+    }
+    return true;
+}
+
+const char* headlessPhaseName(HeadlessPhase phase) {
+    return phase >= 0 && phase < HEADLESS_PHASES ? PHASE_NAMES[phase] : "unknown";
+}
+
+bool writeHeadlessReport(const std::string& path, const HeadlessReport& report) {
+    std::ofstream out(path);
+    if (!out) return false;
+    out << std::fixed << std::setprecision(3);
+    out << "{\n"
+        << "  \"script\": " << jsonString(report.script) << ",\n"
+        << "  \"frames\": " << report.frames << ",\n"
+        << "  \"virtual_seconds\": " << report.virtualSeconds << ",\n"
+        << "  \"wall_seconds\": " << report.wallSeconds << ",\n"
+        << "  \"moves\": " << report.moves << ",\n"
+        << "  \"phases_ms\": {\n";
+    for (int phase = 0; phase < HEADLESS_PHASES; phase++) {
+        PhaseStats stats = phaseStats(report.phaseMs[phase]);
+        out << "    " << jsonString(PHASE_NAMES[phase]) << ": {\"total\": " << stats.total << ", \"mean\": " << stats.mean
+            << ", \"p50\": " << stats.p50 << ", \"p99\": " << stats.p99 << ", \"max\": " << stats.max << "}"
+            << (phase + 1 < HEADLESS_PHASES ? ",\n" : "\n");
+    }
+    out << "  },\n"
+        << "  \"solved\": " << (report.solved ? "true" : "false") << ",\n"
+        << "  \"state_checksum\": \"" << hex(report.stateChecksum) << "\",\n"
+        << "  \"image_checksum\": \"" << hex(report.imageChecksum) << "\",\n"
+        << "  \"image_size\": [" << report.width << ", " << report.height << "]\n"
+        << "}\n";
+    return static_cast<bool>(out);
+}
+
+void printHeadlessSummary(const HeadlessReport& report) {
+    std::cout << std::fixed << std::setprecision(2) << "Headless: " << report.frames << " frames ("
+              << report.virtualSeconds << " s virtual) in " << report.wallSeconds << " s, " << report.moves
+              << " moves" << std::endl;
+    for (int phase = 0; phase < HEADLESS_PHASES; phase++) {
+        PhaseStats stats = phaseStats(report.phaseMs[phase]);
+        std::cout << "  " << std::left << std::setw(9) << PHASE_NAMES[phase] << std::right << std::setw(10) << stats.total
+                  << " ms total  p50 " << std::setprecision(3) << stats.p50 << "  p99 " << stats.p99 << " ms"
+                  << std::setprecision(2) << std::endl;
+    }
+    std::cout << "  state " << hex(report.stateChecksum) << (report.solved ? " (solved)" : "") << "  image "
+              << hex(report.imageChecksum) << " (" << report.width << "x" << report.height << ")" << std::endl;
+}
@@ -0,0 +1,80 @@
+// Headless Script Header
+// Scripted input and the timing report for deterministic headless runs (RubikGame --headless)
+//
+// Script: one command per line, '#' starts a comment. Input commands are delivered at the start
+// of the next frame; frames and idle advance the virtual clock by 1/60 s per frame.
+//   key <name> [shift]   key press: Q W E R T Y S H I Space F4 F5 (not F3: its overlay shows
+//                        wall-clock times, so the image would differ from run to run)
+//   press <x> <y>        left button down at a pixel of the 1400 x 1000 frame
+//   move <x> <y>         mouse move
+//   release              left button up
+//   wheel <delta>        mouse wheel
+//   frames <n>           run n frames
+//   idle                 run frames until no turn is animating or queued and the replay is done
+// The end of the script is an implicit idle. As in the window, keys are ignored while a turn
+// animates, so put idle between turns.
+
+#ifndef HEADLESS_SCRIPT_H
+#define HEADLESS_SCRIPT_H
+
+#include <SFML/Window/Keyboard.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum ScriptCommandType {
+    SCRIPT_KEY,
+    SCRIPT_PRESS,
+    SCRIPT_MOVE,
+    SCRIPT_RELEASE,
+    SCRIPT_WHEEL,
+    SCRIPT_FRAMES,
+    SCRIPT_IDLE
+};
+
+struct ScriptCommand {
+    ScriptCommandType type;
+    sf::Keyboard::Key key;
+    bool shift;
+    int x, y;       // Pixel for press / move, delta for wheel in x
+    int count;      // Frames
+};
+
+// Parse a script; on failure error holds "line N: ..." and commands is incomplete
+bool loadHeadlessScript(const std::string& path, std::vector<ScriptCommand>& commands, std::string& error);
+
+// Per-frame phases of a headless run
+enum HeadlessPhase {
+    PHASE_INPUT = 0,     // Script commands through the input handlers
+    PHASE_UPDATE = 1,    // Replay, animation, move queue, wall, resources
+    PHASE_ESTIMATE = 2,  // Waiting for the distance estimate the window would pick up later
+    PHASE_RENDER = 3,    // Cube / wall and UI draw calls
+    PHASE_FINISH = 4,    // display() + glFinish: the GPU (or software rasterizer) catching up
+    HEADLESS_PHASES = 5
+};
+
+const char* headlessPhaseName(HeadlessPhase phase);
+
+struct HeadlessReport {
+    std::string script;
+    std::uint64_t frames;
+    double virtualSeconds;
+    double wallSeconds;
+    std::uint64_t moves;
+    std::vector<float> phaseMs[HEADLESS_PHASES];  // One sample per frame
+    bool solved;
+    std::uint64_t stateChecksum;   // FNV-1a over the stickers
+    std::uint64_t imageChecksum;   // FNV-1a over the final frame's RGBA pixels
+    unsigned int width, height;
+
+    HeadlessReport() : frames(0), virtualSeconds(0.0), wallSeconds(0.0), moves(0), solved(false),
+                       stateChecksum(0), imageChecksum(0), width(0), height(0) {}
+};
+
+// JSON report: counts, per-phase total / mean / p50 / p99 / max in ms, checksums as hex strings
+bool writeHeadlessReport(const std::string& path, const HeadlessReport& report);
+
+// Short human-readable version for stdout
+void printHeadlessSummary(const HeadlessReport& report);
+
+#endif // HEADLESS_SCRIPT_H
@@ -0,0 +1,347 @@
+// Human Solver Implementation
+// Piece-code move tables, the cross distance table, F2L case tables and last-layer lookups
+
+#include "human_solver.h"
+#include "move_sequence.h"
+#include "profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <queue>
+
+namespace {
+
+// A piece is tracked as a code: position * 2 + flip for edges, position * 3 + twist for corners
+const int PIECE_CODES = 24;
+const int CROSS_STATES = PIECE_CODES * PIECE_CODES * PIECE_CODES * PIECE_CODES;
+const int PAIR_STATES = PIECE_CODES * PIECE_CODES;
+const std::uint8_t UNKNOWN = 0xFF;
+
+// Pair k: corner DFR + k with edge FR + k (slot names follow the edge)
+const char* const PAIR_NAMES[4] = {"FR", "FL", "BL", "BR"};
+
+// Slot trigger: X U^a X^-1 for a short X of side-face turns (R U R', F' U2 F, R B U B' R', ...)
+// that leaves the cross alone and disturbs only the U layer and one slot. Plain U turns are
+// triggers without a slot. Triggers of an open slot never touch a placed pair.
+struct Trigger {
+    std::vector<int> moves;
+    int slot;      // Slot it disturbs, -1 for a U turn
+    int inverse;   // Index of the trigger undoing it
+    std::uint8_t edgeMap[PIECE_CODES];
+    std::uint8_t cornerMap[PIECE_CODES];
+};
+
+struct StageTables {
+    std::uint8_t edgeMove[PIECE_CODES][NUM_MOVES];
+    std::uint8_t cornerMove[PIECE_CODES][NUM_MOVES];
+    std::vector<std::uint8_t> cross;  // Exact distance of the four D edges
+    std::vector<Trigger> triggers;
+    // F2L case table per pair and set of placed pairs, indexed by corner code * 24 + edge code:
+    // moves left to insert the pair, and the trigger to take next
+    std::uint8_t pairCost[4][16][PAIR_STATES];
+    std::uint16_t pairStep[4][16][PAIR_STATES];
+};
+
+int crossIndex(const std::uint8_t* edges) {
+    return ((edges[0] * PIECE_CODES + edges[1]) * PIECE_CODES + edges[2]) * PIECE_CODES + edges[3];
+}
+
+int pairSolved(int pair) {
+    return (DFR + pair) * 3 * PIECE_CODES + (FR + pair) * 2;
+}
+
+bool crossIntact(const CubieCube& cube) {
+    for (int e = DR; e <= DB; e++) {
+        if (cube.ep[e] != e || cube.eo[e] != 0) return false;
+    }
+    return true;
+}
+
+bool slotIntact(const CubieCube& cube, int slot) {
+    return cube.cp[DFR + slot] == DFR + slot && cube.co[DFR + slot] == 0 &&
+           cube.ep[FR + slot] == FR + slot && cube.eo[FR + slot] == 0;
+}
+
+void addTrigger(StageTables& tables, const std::vector<int>& moves, std::vector<std::uint64_t>& seen) {
+    CubieCube cube;
+    for (int move : moves) cube.applyMove(move);
+    if (!crossIntact(cube)) return;
+    int slot = -1;
+    for (int j = 0; j < 4; j++) {
+        if (slotIntact(cube, j)) continue;
+        if (slot >= 0) return;
+        slot = j;
+    }
+    if (std::find(seen.begin(), seen.end(), cube.hash()) != seen.end()) return;
+    seen.push_back(cube.hash());
+
+    Trigger trigger;
+    trigger.moves = moves;
+    trigger.slot = slot;
+    trigger.inverse = -1;
+    for (int code = 0; code < PIECE_CODES; code++) {
+        int edge = code, corner = code;
+        for (int move : moves) {
+            edge = tables.edgeMove[edge][move];
+            corner = tables.cornerMove[corner][move];
+        }
+        trigger.edgeMap[code] = static_cast<std::uint8_t>(edge);
+        trigger.cornerMap[code] = static_cast<std::uint8_t>(corner);
+    }
+    tables.triggers.push_back(trigger);
+}
+
+void buildTriggers(StageTables& tables) {
+    const int MOVE_U = 6;
+    const int SIDE_FACES[4] = {RIGHT, LEFT, FRONT, BACK};
+    std::vector<std::vector<int>> setups;
+    for (int f = 0; f < 4; f++) {
+        for (int t = 0; t < 3; t++) setups.push_back(std::vector<int>(1, SIDE_FACES[f] * 3 + t));
+    }
+    for (std::size_t i = 0, single = setups.size(); i < single; i++) {
+        for (std::size_t j = 0; j < single; j++) {
+            if (setups[i][0] / 3 == setups[j][0] / 3) continue;
+            setups.push_back({setups[i][0], setups[j][0]});
+        }
+    }
+
+    // Shorter setups first, so a duplicate effect keeps the shortest trigger
+    std::vector<std::uint64_t> seen;
+    for (int a = 0; a < 3; a++) addTrigger(tables, std::vector<int>(1, MOVE_U + a), seen);
+    for (const std::vector<int>& setup : setups) {
+        for (int a = 0; a < 3; a++) {
+            std::vector<int> moves = setup;
+            moves.push_back(MOVE_U + a);
+            for (auto it = setup.rbegin(); it != setup.rend(); ++it) moves.push_back(inverseMove(*it));
+            addTrigger(tables, moves, seen);
+        }
+    }
+
+    for (Trigger& trigger : tables.triggers) {
+        for (std::size_t j = 0; j < tables.triggers.size() && trigger.inverse < 0; j++) {
+            bool undoes = true;
+            for (int code = 0; code < PIECE_CODES && undoes; code++) {
+                undoes = tables.triggers[j].edgeMap[trigger.edgeMap[code]] == code &&
+                         tables.triggers[j].cornerMap[trigger.cornerMap[code]] == code;
+            }
+            if (undoes) trigger.inverse = static_cast<int>(j);
+        }
+    }
+}
+
+// Dijkstra by move count from the inserted pair over triggers of open slots; the trigger set
+// is closed under inverses, so stepping back along the search tree solves a case
+void buildPairTable(StageTables& tables, int pair, int placed) {
+    std::uint8_t* cost = tables.pairCost[pair][placed];
+    std::uint16_t* step = tables.pairStep[pair][placed];
+    std::fill(cost, cost + PAIR_STATES, UNKNOWN);
+    std::vector<bool> done(PAIR_STATES, false);
+    typedef std::pair<int, int> Entry;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+    cost[pairSolved(pair)] = 0;
+    queue.push(Entry(0, pairSolved(pair)));
+    while (!queue.empty()) {
+        Entry top = queue.top();
+        queue.pop();
+        int state = top.second;
+        if (done[state]) continue;
+        done[state] = true;
+        for (std::size_t t = 0; t < tables.triggers.size(); t++) {
+            const Trigger& trigger = tables.triggers[t];
+            if (trigger.slot >= 0 && (placed & (1 << trigger.slot))) continue;
+            int target = trigger.cornerMap[state / PIECE_CODES] * PIECE_CODES + trigger.edgeMap[state % PIECE_CODES];
+            int total = top.first + static_cast<int>(trigger.moves.size());
+            if (cost[target] == UNKNOWN || total < cost[target]) {
+                cost[target] = static_cast<std::uint8_t>(total);
+                step[target] = static_cast<std::uint16_t>(trigger.inverse);
+                queue.push(Entry(total, target));
+            }
+        }
+    }
+}
+
+StageTables buildTables() {
+    PROFILE_SCOPE("HumanSolver::buildTables");
+    StageTables tables;
+    // Piece at position p moves to the position q whose source (cp / ep) is p
+    for (int m = 0; m < NUM_MOVES; m++) {
+        const CubieCube& move = moveCube(m);
+        for (int q = 0; q < 12; q++) {
+            for (int flip = 0; flip < 2; flip++) {
+                tables.edgeMove[move.ep[q] * 2 + flip][m] = static_cast<std::uint8_t>(q * 2 + (flip ^ move.eo[q]));
+            }
+        }
+        for (int q = 0; q < 8; q++) {
+            for (int twist = 0; twist < 3; twist++) {
+                tables.cornerMove[move.cp[q] * 3 + twist][m] =
+                    static_cast<std::uint8_t>(q * 3 + (twist + move.co[q]) % 3);
+            }
+        }
+    }
+
+    // Cross: breadth-first from solved over the codes of DR, DF, DL, DB
+    tables.cross.assign(CROSS_STATES, UNKNOWN);
+    const std::uint8_t crossSolved[4] = {DR * 2, DF * 2, DL * 2, DB * 2};
+    std::vector<int> frontier(1, crossIndex(crossSolved)), following;
+    tables.cross[frontier[0]] = 0;
+    for (int depth = 1; !frontier.empty(); depth++) {
+        following.clear();
+        for (int state : frontier) {
+            for (int m = 0; m < NUM_MOVES; m++) {
+                std::uint8_t edges[4];
+                for (int i = 3, rest = state; i >= 0; i--, rest /= PIECE_CODES) {
+                    edges[i] = tables.edgeMove[rest % PIECE_CODES][m];
+                }
+                int target = crossIndex(edges);
+                if (tables.cross[target] != UNKNOWN) continue;
+                tables.cross[target] = static_cast<std::uint8_t>(depth);
+                following.push_back(target);
+            }
+        }
+        frontier.swap(following);
+    }
+
+    buildTriggers(tables);
+    for (int pair = 0; pair < 4; pair++) {
+        for (int placed = 0; placed < 16; placed++) {
+            if (!(placed & (1 << pair))) buildPairTable(tables, pair, placed);
+        }
+    }
+    return tables;
+}
+
+const StageTables& stageTables() {
+    static const StageTables tables = buildTables();
+    return tables;
+}
+
+// Code of every piece of the first two layers
+struct F2LState {
+    std::uint8_t cross[4];   // DR, DF, DL, DB
+    std::uint8_t corner[4];  // DFR, DLF, DBL, DRB
+    std::uint8_t edge[4];    // FR, FL, BL, BR
+};
+
+F2LState f2lState(const CubieCube& cube) {
+    F2LState state;
+    for (int q = 0; q < 12; q++) {
+        int code = q * 2 + cube.eo[q];
+        if (cube.ep[q] >= DR && cube.ep[q] <= DB) state.cross[cube.ep[q] - DR] = static_cast<std::uint8_t>(code);
+        if (cube.ep[q] >= FR) state.edge[cube.ep[q] - FR] = static_cast<std::uint8_t>(code);
+    }
+    for (int q = 0; q < 8; q++) {
+        if (cube.cp[q] >= DFR) state.corner[cube.cp[q] - DFR] = static_cast<std::uint8_t>(q * 3 + cube.co[q]);
+    }
+    return state;
+}
+
+// "OLL" + "Sune" -> "OLL Sune"; unnamed cases already carry the prefix ("OLL class 12", "PLL 3")
+std::string stageName(const std::string& stage, const std::string& name) {
+    return name.compare(0, stage.size(), stage) == 0 ? name : stage + " " + name;
+}
+
+double microsecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+void addStage(std::vector<SolveStage>& stages, const std::string& name, const std::vector<int>& moves,
+              std::chrono::steady_clock::time_point start, std::uint64_t nodes, CubieCube& cube) {
+    SolveStage stage;
+    stage.name = name;
+    stage.moves = moves;
+    stage.nodes = nodes;
+    stage.microseconds = microsecondsSince(start);
+    for (int move : moves) cube.applyMove(move);
+    stages.push_back(stage);
+}
+
+} // namespace
+
+HumanSolver::HumanSolver(const LastLayerDatabase* database) : lastLayer(database) {}
+
+void HumanSolver::warmUp() {
+    stageTables();
+}
+
+bool HumanSolver::solve(const CubieCube& start, std::vector<SolveStage>& stages) const {
+    PROFILE_SCOPE("HumanSolver::solve");
+    stages.clear();
+    if (!start.isValid() || !lastLayer || !lastLayer->isReady()) return false;
+    const StageTables& tables = stageTables();
+    CubieCube cube = start;
+
+    // Cross: the table is exact, so any move that lowers the distance is on an optimal path
+    auto clock = std::chrono::steady_clock::now();
+    F2LState state = f2lState(cube);
+    std::vector<int> moves;
+    std::uint64_t probes = 0;
+    for (int distance = tables.cross[crossIndex(state.cross)]; distance > 0; distance--) {
+        for (int m = 0; m < NUM_MOVES; m++) {
+            std::uint8_t edges[4];
+            for (int i = 0; i < 4; i++) edges[i] = tables.edgeMove[state.cross[i]][m];
+            probes++;
+            if (tables.cross[crossIndex(edges)] < distance) {
+                std::copy(edges, edges + 4, state.cross);
+                moves.push_back(m);
+                break;
+            }
+        }
+    }
+    addStage(stages, "Cross", moves, clock, probes, cube);
+
+    // F2L: insert the pair whose case is shortest, four times
+    int placed = 0;
+    for (int n = 0; n < 4; n++) {
+        clock = std::chrono::steady_clock::now();
+        state = f2lState(cube);
+        int pair = -1, position = 0;
+        probes = 0;
+        for (int k = 0; k < 4; k++) {
+            if (placed & (1 << k)) continue;
+            int candidate = state.corner[k] * PIECE_CODES + state.edge[k];
+            probes++;
+            if (pair < 0 || tables.pairCost[k][placed][candidate] < tables.pairCost[pair][placed][position]) {
+                pair = k;
+                position = candidate;
+            }
+        }
+        if (tables.pairCost[pair][placed][position] == UNKNOWN) return false;
+
+        moves.clear();
+        while (position != pairSolved(pair)) {
+            const Trigger& trigger = tables.triggers[tables.pairStep[pair][placed][position]];
+            moves.insert(moves.end(), trigger.moves.begin(), trigger.moves.end());
+            position = trigger.cornerMap[position / PIECE_CODES] * PIECE_CODES + trigger.edgeMap[position % PIECE_CODES];
+            probes++;
+        }
+        placed |= 1 << pair;
+        addStage(stages, std::string("F2L ") + PAIR_NAMES[pair], canonicalizeSequence(moves), clock, probes, cube);
+    }
+
+    // Last layer: orient from the OLL class's algorithm, then solve the PLL case
+    clock = std::chrono::steady_clock::now();
+    LastLayerMatch match;
+    if (!lastLayer->recognize(cube, match)) return false;
+    match.orientation(moves);
+    addStage(stages, match.oll == 0 ? "OLL skip" : stageName("OLL", lastLayer->ollName(match.oll)),
+             moves, clock, 1, cube);
+
+    clock = std::chrono::steady_clock::now();
+    if (!lastLayer->recognize(cube, match) || match.pll == NO_LAST_LAYER_CLASS) return false;
+    match.solution(moves);
+    std::string name = match.pll != 0 ? stageName("PLL", lastLayer->pllName(match.pll))
+                                      : (moves.empty() ? "PLL skip" : "AUF");
+    addStage(stages, name, moves, clock, 1, cube);
+    return cube.isSolved();
+}
+
+bool HumanSolver::solve(const RubikCube& cube, std::vector<SolveStage>& stages) const {
+    CubieCube cubie;
+    stages.clear();
+    return CubieCube::fromFacelets(cube, cubie) && solve(cubie, stages);
+}
+
+std::vector<int> flattenStages(const std::vector<SolveStage>& stages) {
+    std::vector<int> moves;
+    for (const SolveStage& stage : stages) moves.insert(moves.end(), stage.moves.begin(), stage.moves.end());
+    return moves;
+}
@@ -0,0 +1,49 @@
+// Human Solver Header
+// Step-by-step CFOP solve (cross, four F2L pairs, OLL, PLL) with per-stage timing
+//
+// Each stage is solved the way a person would, one goal at a time, from a small stage-specific
+// table: the cross by descending an exact distance table of the four D edges, each F2L pair
+// from a case table of slot triggers (R U R', F' U2 F, ...) that never disturb a placed pair,
+// and the last layer by two lookups in the last-layer database (orient, then permute).
+// Solutions run ~60 moves instead of ~20, but every stage can be shown to a player on its own.
+
+#ifndef HUMAN_SOLVER_H
+#define HUMAN_SOLVER_H
+
+#include "cubie_cube.h"
+#include "last_layer.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// One labeled stage of a solution
+struct SolveStage {
+    std::string name;         // "Cross", "F2L FR", "OLL Sune", "PLL T-perm", ...
+    std::vector<int> moves;   // Move indices, already simplified
+    double microseconds;      // Time spent solving this stage
+    std::uint64_t nodes;      // Table probes spent on this stage
+};
+
+class HumanSolver {
+private:
+    const LastLayerDatabase* lastLayer;
+
+public:
+    // The cross and F2L tables are shared and built on first use (see warmUp)
+    explicit HumanSolver(const LastLayerDatabase* lastLayer = nullptr);
+
+    // OLL and PLL need a ready last-layer database
+    void setLastLayer(const LastLayerDatabase* database) { lastLayer = database; }
+
+    // Build the shared tables now rather than inside the first solve
+    static void warmUp();
+
+    // Solve stage by stage; false for invalid states or without a last-layer database
+    bool solve(const CubieCube& cube, std::vector<SolveStage>& stages) const;
+    bool solve(const RubikCube& cube, std::vector<SolveStage>& stages) const;
+};
+
+// All stage moves in order
+std::vector<int> flattenStages(const std::vector<SolveStage>& stages);
+
+#endif // HUMAN_SOLVER_H
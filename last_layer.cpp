@@ -0,0 +1,640 @@
+// Last Layer Database Implementation
+// Case search over known algorithms, AUF classes and the mapped lookup table
+
+#include "last_layer.h"
+#include "move_sequence.h"
+#include "profiler.h"
+#include <cstdio>
+#include <cstring>
+#include <queue>
+#include <set>
+
+namespace {
+
+const char DB_MAGIC[8] = {'R', 'B', 'K', 'L', 'L', 'D', 'B', '1'};
+const std::uint32_t DB_VERSION = 3;
+const std::size_t HEADER_SIZE = 40;
+const std::size_t STATE_ENTRY_SIZE = 8;
+const std::size_t CASE_ENTRY_SIZE = 8;
+const std::size_t VARIANT_ENTRY_SIZE = 8;
+const std::size_t OLL_ENTRY_SIZE = 8;
+const int MOVE_U = 6;  // U, U2, U' are 6, 7, 8
+
+// Algorithm set the search composes; each is also used mirrored, inverted and from all four sides
+struct Generator {
+    const char* name;
+    const char* moves;
+};
+
+const Generator GENERATORS[] = {
+    // PLL
+    {"Ua-perm", "R U' R U R U R U' R' U' R2"},
+    {"Ub-perm", "R2 U R U R' U' R' U' R' U R'"},
+    {"H-perm", "R2 U2 R U2 R2 U2 R2 U2 R U2 R2"},
+    {"Z-perm", "R' U' R U' R U R U' R' U R U R2 U' R'"},
+    {"Aa-perm", "R' F R' B2 R F' R' B2 R2"},
+    {"Ab-perm", "R2 B2 R F R' B2 R F' R"},
+    {"E-perm", "R' U L' D2 L U' R L' U R' D2 R U' L"},
+    {"T-perm", "R U R' U' R' F R2 U' R' U' R U R' F'"},
+    {"F-perm", "R' U' F' R U R' U' R' F R2 U' R' U' R U R' U R"},
+    {"Ja-perm", "L' U' L F L' U' L U L F' L2 U L"},
+    {"Jb-perm", "R U R' F' R U R' U' R' F R2 U' R' U'"},
+    {"Ra-perm", "R U' R' U' R U R D R' U' R D' R' U2 R'"},
+    {"Rb-perm", "R2 F R U R U' R' F' R U2 R' U2 R"},
+    {"Y-perm", "F R U' R' U' R U R' F' R U R' U' R' F R F'"},
+    {"V-perm", "R' U R' U' B' R' B2 U' B' U B' R B R"},
+    {"Na-perm", "R U R' U R U R' F' R U R' U' R' F R2 U' R' U2 R U' R'"},
+    {"Nb-perm", "R' U R U' R' F' U' F R U R' F R' F' R U' R"},
+    {"Ga-perm", "R2 U R' U R' U' R U' R2 D U' R' U R D'"},
+    {"Gb-perm", "R' U' R U D' R2 U R' U R U' R U' R2 D"},
+    {"Gc-perm", "R2 U' R U' R U R' U R2 D' U R U' R' D"},
+    {"Gd-perm", "R U R' U' D R2 U' R U' R' U R' U R2 D'"},
+    // OLL
+    {"Sune", "R U R' U R U2 R'"},
+    {"Antisune", "R U2 R' U' R U' R'"},
+    {"H", "R U R' U R U' R' U R U2 R'"},
+    {"Pi", "R U2 R2 U' R2 U' R2 U2 R"},
+    {"U", "R2 D R' U2 R D' R' U2 R'"},
+    {"T", "R U R' U' R' F R F'"},
+    {"L", "F R' F' R U R U' R'"},
+    {"Line", "F R U R' U' F'"},
+    {"Small L", "F U R U' R' F'"},
+    {"", "R U' L' U R' U' L U"},  // Corner 3-cycle: a search macro only, names no case
+};
+
+// Face after a y-turn of the solver's viewpoint (U and D stay)
+const int Y_FACE[6] = {BACK, FRONT, UP, DOWN, RIGHT, LEFT};
+// Face seen in a mirror through the R/L plane
+const int MIRROR_FACE[6] = {LEFT, RIGHT, UP, DOWN, FRONT, BACK};
+
+int turnU(int quarterTurns) {
+    quarterTurns &= 3;
+    return quarterTurns ? MOVE_U + quarterTurns - 1 : -1;
+}
+
+void putU16(std::uint8_t* out, std::uint32_t value) {
+    out[0] = static_cast<std::uint8_t>(value);
+    out[1] = static_cast<std::uint8_t>(value >> 8);
+}
+
+void putU32(std::uint8_t* out, std::uint32_t value) {
+    for (int i = 0; i < 4; i++) out[i] = static_cast<std::uint8_t>(value >> (8 * i));
+}
+
+std::uint32_t getU16(const std::uint8_t* in) {
+    return static_cast<std::uint32_t>(in[0]) | static_cast<std::uint32_t>(in[1]) << 8;
+}
+
+std::uint32_t getU32(const std::uint8_t* in) {
+    std::uint32_t value = 0;
+    for (int i = 0; i < 4; i++) value |= static_cast<std::uint32_t>(in[i]) << (8 * i);
+    return value;
+}
+
+int rank4(const std::uint8_t* perm) {
+    int rank = 0;
+    for (int i = 0; i < 4; i++) {
+        int smaller = 0;
+        for (int j = i + 1; j < 4; j++) smaller += perm[j] < perm[i];
+        rank = rank * (4 - i) + smaller;
+    }
+    return rank;
+}
+
+void unrank4(int rank, std::uint8_t* perm) {
+    int digits[4] = {rank / 6, rank / 2 % 3, rank % 2, 0};
+    std::uint8_t available[4] = {0, 1, 2, 3};
+    int remaining = 4;
+    for (int i = 0; i < 4; i++) {
+        perm[i] = available[digits[i]];
+        for (int j = digits[i]; j + 1 < remaining; j++) available[j] = available[j + 1];
+        remaining--;
+    }
+}
+
+int parity4(const std::uint8_t* perm) {
+    int parity = 0;
+    for (int i = 0; i < 4; i++) {
+        for (int j = i + 1; j < 4; j++) parity ^= perm[j] < perm[i];
+    }
+    return parity;
+}
+
+// U-turn conjugations and AUFs as cubes
+CubieCube withAuf(int pre, const CubieCube& cube, int post) {
+    CubieCube result;
+    if (turnU(pre) >= 0) result.applyMove(turnU(pre));
+    result.multiply(cube);
+    if (turnU(post) >= 0) result.applyMove(turnU(post));
+    return result;
+}
+
+// Orientation pattern of the U layer
+int orientationKey(const CubieCube& cube) {
+    int key = 0;
+    for (int i = 0; i < 4; i++) key = key * 3 + cube.co[i];
+    for (int i = 0; i < 4; i++) key = key * 2 + cube.eo[i];
+    return key;
+}
+
+// Smallest pattern over the four U-conjugates (the class's reference pattern);
+// a conjugate U^a X U^-a shows the same pattern as X U^-a
+int orientationClassKey(const CubieCube& cube) {
+    int best = -1;
+    for (int a = 0; a < 4; a++) {
+        int key = orientationKey(withAuf(a, cube, 4 - a));
+        if (best < 0 || key < best) best = key;
+    }
+    return best;
+}
+
+// A macro is an optional AUF followed by one algorithm variant
+struct Macro {
+    std::vector<int> moves;
+    CubieCube cube;
+    int generator;  // Index into GENERATORS, -1 for a plain U turn
+};
+
+std::vector<Macro> buildMacros() {
+    std::vector<Macro> macros;
+    std::set<std::vector<int>> seen;
+    for (int u = 1; u < 4; u++) {
+        Macro macro;
+        macro.moves.push_back(turnU(u));
+        macro.cube.applyMove(turnU(u));
+        macro.generator = -1;
+        macros.push_back(macro);
+    }
+
+    int generatorCount = static_cast<int>(sizeof(GENERATORS) / sizeof(GENERATORS[0]));
+    for (int g = 0; g < generatorCount; g++) {
+        std::vector<int> base;
+        parseSequence(GENERATORS[g].moves, base);
+        for (int variant = 0; variant < 16; variant++) {
+            bool mirror = (variant & 1) != 0;
+            bool inverse = (variant & 2) != 0;
+            int yTurns = variant >> 2;
+
+            std::vector<int> moves;
+            for (int move : base) {
+                int face = move / 3;
+                int turns = move % 3;
+                if (mirror) {
+                    face = MIRROR_FACE[face];
+                    turns = 2 - turns;
+                }
+                for (int y = 0; y < yTurns; y++) face = Y_FACE[face];
+                moves.push_back(face * 3 + turns);
+            }
+            if (inverse) {
+                std::vector<int> reversed;
+                for (auto it = moves.rbegin(); it != moves.rend(); ++it) reversed.push_back(inverseMove(*it));
+                moves.swap(reversed);
+            }
+
+            for (int pre = 0; pre < 4; pre++) {
+                Macro macro;
+                if (turnU(pre) >= 0) macro.moves.push_back(turnU(pre));
+                macro.moves.insert(macro.moves.end(), moves.begin(), moves.end());
+                macro.moves = canonicalizeSequence(macro.moves);
+                if (!seen.insert(macro.moves).second) continue;
+                for (int move : macro.moves) macro.cube.applyMove(move);
+                // Skip variants that would disturb the first two layers
+                if (lastLayerIndex(macro.cube) < 0) continue;
+                macro.generator = g;
+                macros.push_back(macro);
+            }
+        }
+    }
+    return macros;
+}
+
+// Dijkstra by move count over all last-layer states, starting from every source at cost 0
+struct MacroSearch {
+    std::vector<int> cost;
+    std::vector<int> parent;  // -1 for sources
+    std::vector<int> via;     // Macro taken from the parent
+};
+
+void searchMacros(const std::vector<Macro>& macros, const std::vector<int>& sources, MacroSearch& search) {
+    search.cost.assign(LAST_LAYER_STATES, -1);
+    search.parent.assign(LAST_LAYER_STATES, -1);
+    search.via.assign(LAST_LAYER_STATES, -1);
+    std::vector<bool> done(LAST_LAYER_STATES, false);
+    typedef std::pair<int, int> Entry;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+    for (int source : sources) {
+        search.cost[source] = 0;
+        queue.push(Entry(0, source));
+    }
+    while (!queue.empty()) {
+        Entry top = queue.top();
+        queue.pop();
+        int index = top.second;
+        if (done[index]) continue;
+        done[index] = true;
+        CubieCube state = lastLayerState(index);
+        for (std::size_t m = 0; m < macros.size(); m++) {
+            CubieCube next = state;
+            next.multiply(macros[m].cube);
+            int target = lastLayerIndex(next);
+            int total = top.first + static_cast<int>(macros[m].moves.size());
+            if (search.cost[target] < 0 || total < search.cost[target]) {
+                search.cost[target] = total;
+                search.parent[target] = index;
+                search.via[target] = static_cast<int>(m);
+                queue.push(Entry(total, target));
+            }
+        }
+    }
+}
+
+// U^-post, algorithm, U^-pre with the AUFs merged into it
+std::vector<int> withAufMoves(int pre, const std::vector<int>& algorithm, int post) {
+    std::vector<int> moves;
+    if (turnU(-post) >= 0) moves.push_back(turnU(-post));
+    moves.insert(moves.end(), algorithm.begin(), algorithm.end());
+    if (turnU(-pre) >= 0) moves.push_back(turnU(-pre));
+    return canonicalizeSequence(moves);
+}
+
+// Moves taking a state back to its source: the path from the source, inverted
+std::vector<int> solutionOf(const std::vector<Macro>& macros, const MacroSearch& search, int index) {
+    std::vector<int> path;
+    for (int at = index; search.parent[at] >= 0; at = search.parent[at]) {
+        const std::vector<int>& moves = macros[search.via[at]].moves;
+        path.insert(path.begin(), moves.begin(), moves.end());
+    }
+    std::vector<int> inverse;
+    for (auto it = path.rbegin(); it != path.rend(); ++it) inverse.push_back(inverseMove(*it));
+    return canonicalizeSequence(inverse);
+}
+
+} // namespace
+
+void LastLayerMatch::orientation(std::vector<int>& moves) const {
+    moves.clear();
+    if (turnU(ollAuf) >= 0) moves.push_back(turnU(ollAuf));
+    moves.insert(moves.end(), ollAlgorithm, ollAlgorithm + ollAlgorithmLength);
+    moves = canonicalizeSequence(moves);
+}
+
+void LastLayerMatch::solution(std::vector<int>& moves) const {
+    moves = withAufMoves(preAuf, std::vector<int>(algorithm, algorithm + algorithmLength), postAuf);
+}
+
+int lastLayerIndex(const CubieCube& cube) {
+    for (int i = 4; i < 8; i++) {
+        if (cube.cp[i] != i || cube.co[i] != 0) return -1;
+    }
+    for (int i = 4; i < 12; i++) {
+        if (cube.ep[i] != i || cube.eo[i] != 0) return -1;
+    }
+    int cpRank = rank4(cube.cp);
+    int coRank = cube.co[0] * 9 + cube.co[1] * 3 + cube.co[2];
+    int epRank = rank4(cube.ep);
+    int eoRank = cube.eo[0] * 4 + cube.eo[1] * 2 + cube.eo[2];
+    // Ranks 2k and 2k+1 differ by an odd swap, so parity leaves one of them
+    return ((cpRank * 27 + coRank) * 12 + epRank / 2) * 8 + eoRank;
+}
+
+CubieCube lastLayerState(int index) {
+    CubieCube cube;
+    int eoRank = index % 8;
+    int epHalf = index / 8 % 12;
+    int coRank = index / 96 % 27;
+    int cpRank = index / 2592;
+
+    unrank4(cpRank, cube.cp);
+    unrank4(epHalf * 2, cube.ep);
+    if (parity4(cube.ep) != parity4(cube.cp)) unrank4(epHalf * 2 + 1, cube.ep);
+    cube.co[0] = static_cast<std::uint8_t>(coRank / 9);
+    cube.co[1] = static_cast<std::uint8_t>(coRank / 3 % 3);
+    cube.co[2] = static_cast<std::uint8_t>(coRank % 3);
+    cube.co[3] = static_cast<std::uint8_t>((6 - cube.co[0] - cube.co[1] - cube.co[2]) % 3);
+    cube.eo[0] = static_cast<std::uint8_t>(eoRank >> 2);
+    cube.eo[1] = static_cast<std::uint8_t>(eoRank >> 1 & 1);
+    cube.eo[2] = static_cast<std::uint8_t>(eoRank & 1);
+    cube.eo[3] = static_cast<std::uint8_t>((cube.eo[0] + cube.eo[1] + cube.eo[2]) & 1);
+    return cube;
+}
+
+LastLayerDatabase::LastLayerDatabase()
+    : base(nullptr), caseCount(0), ollCount(0), pllCount(0), variantCount(0),
+      states(nullptr), cases(nullptr), variants(nullptr), olls(nullptr), names(nullptr), algorithms(nullptr), nameBlob(nullptr) {}
+
+void LastLayerDatabase::build() {
+    PROFILE_SCOPE("LastLayerDatabase::build");
+    mapping.close();
+    std::vector<Macro> macros = buildMacros();
+
+    // Full solutions: shortest paths from solved
+    MacroSearch search;
+    searchMacros(macros, std::vector<int>(1, 0), search);
+    const std::vector<int>& cost = search.cost;
+
+    // Group states into cases: X ~ U^a X U^b, represented by the member cheapest to solve
+    std::vector<int> caseOf(LAST_LAYER_STATES, -1), preOf(LAST_LAYER_STATES), postOf(LAST_LAYER_STATES);
+    std::vector<int> caseRep;
+    for (int s = 0; s < LAST_LAYER_STATES; s++) {
+        if (caseOf[s] >= 0) continue;
+        CubieCube state = lastLayerState(s);
+        int members[16];
+        int rep = 0;
+        for (int k = 0; k < 16; k++) {
+            members[k] = lastLayerIndex(withAuf(k >> 2, state, k & 3));
+            if (cost[members[k]] < cost[members[rep]]) rep = k;
+        }
+        int id = static_cast<int>(caseRep.size());
+        caseRep.push_back(members[rep]);
+        // member k = U^a s U^b and rep = U^a0 s U^b0, so member = U^(a-a0) rep U^(b-b0)
+        for (int k = 0; k < 16; k++) {
+            if (caseOf[members[k]] >= 0) continue;
+            caseOf[members[k]] = id;
+            preOf[members[k]] = ((k >> 2) - (rep >> 2)) & 3;
+            postOf[members[k]] = ((k & 3) - (rep & 3)) & 3;
+        }
+    }
+
+    // Orientation classes and permutation cases
+    std::vector<int> ollOf(LAST_LAYER_STATES), pllOfCase(caseRep.size(), NO_LAST_LAYER_CLASS);
+    std::vector<int> ollKeys, ollAufOf(LAST_LAYER_STATES), orientedStates;
+    std::vector<std::string> ollNames, pllNames;
+    for (int s = 0; s < LAST_LAYER_STATES; s++) {
+        CubieCube state = lastLayerState(s);
+        int key = orientationClassKey(state);
+        std::size_t id = 0;
+        while (id < ollKeys.size() && ollKeys[id] != key) id++;
+        if (id == ollKeys.size()) {
+            ollKeys.push_back(key);
+            ollNames.push_back(s == 0 ? "Oriented" : "");
+        }
+        ollOf[s] = static_cast<int>(id);
+        ollAufOf[s] = 0;
+        while (orientationKey(withAuf(0, state, ollAufOf[s])) != key) ollAufOf[s]++;
+        if (id == 0) orientedStates.push_back(s);
+    }
+    for (std::size_t c = 0; c < caseRep.size(); c++) {
+        if (ollOf[caseRep[c]] != 0) continue;
+        pllOfCase[c] = static_cast<int>(pllNames.size());
+        pllNames.push_back(c == 0 ? "Solved" : "");
+    }
+
+    // Orienting algorithms: shortest paths from any oriented state. An algorithm that orients
+    // one state of a pattern orients every state with that pattern, whatever the permutation,
+    // so each class keeps the cheapest state showing its reference pattern.
+    MacroSearch orient;
+    searchMacros(macros, orientedStates, orient);
+    std::vector<int> ollRep(ollKeys.size(), -1);
+    for (int s = 0; s < LAST_LAYER_STATES; s++) {
+        if (ollAufOf[s] != 0) continue;
+        int& rep = ollRep[ollOf[s]];
+        if (rep < 0 || orient.cost[s] < orient.cost[rep]) rep = s;
+    }
+
+    // Name each PLL case or OLL class after the first generator that solves it; the rest get
+    // the database's own class index, which is not the standard OLL 1-57 numbering
+    for (const Generator& generator : GENERATORS) {
+        std::vector<int> moves;
+        parseSequence(generator.moves, moves);
+        CubieCube solvedBy;
+        for (auto it = moves.rbegin(); it != moves.rend(); ++it) solvedBy.applyMove(inverseMove(*it));
+        int index = lastLayerIndex(solvedBy);
+        if (index < 0) continue;
+        std::string& name = ollOf[index] == 0 ? pllNames[pllOfCase[caseOf[index]]] : ollNames[ollOf[index]];
+        if (name.empty() && generator.name[0]) name = generator.name;
+    }
+    for (std::size_t i = 0; i < ollNames.size(); i++) {
+        if (ollNames[i].empty()) ollNames[i] = "OLL class " + std::to_string(i);
+    }
+    for (std::size_t i = 0; i < pllNames.size(); i++) {
+        if (pllNames[i].empty()) pllNames[i] = "PLL " + std::to_string(i);
+    }
+
+    // Algorithm variants: every member of a case brings its own shortest algorithm, and each
+    // slot takes the one that is shortest once wrapped in the slot's AUFs. Candidates are tried
+    // representative first, so a variant is only kept when some slot solves shorter with it.
+    std::vector<std::vector<int>> membersOf(caseRep.size());
+    for (int s = 0; s < LAST_LAYER_STATES; s++) membersOf[caseOf[s]].push_back(s);
+    std::vector<int> variantOf(LAST_LAYER_STATES), firstVariant(caseRep.size()), variantCountOf(caseRep.size());
+    std::vector<std::vector<int>> variantAlgorithms;
+    for (std::size_t c = 0; c < caseRep.size(); c++) {
+        std::vector<int> sources(1, caseRep[c]);
+        for (int member : membersOf[c]) {
+            if (member != caseRep[c]) sources.push_back(member);
+        }
+        std::vector<std::vector<int>> candidates;
+        for (int source : sources) candidates.push_back(solutionOf(macros, search, source));
+
+        // member = U^pre * source * U^post, from both states' AUFs relative to the representative
+        std::vector<int> chosen(membersOf[c].size(), 0), kept(sources.size(), -1);
+        for (std::size_t i = 0; i < membersOf[c].size(); i++) {
+            int member = membersOf[c][i];
+            std::size_t bestLength = 0;
+            for (std::size_t j = 0; j < sources.size(); j++) {
+                int pre = (preOf[member] - preOf[sources[j]]) & 3;
+                int post = (postOf[member] - postOf[sources[j]]) & 3;
+                std::size_t length = withAufMoves(pre, candidates[j], post).size();
+                if (j == 0 || length < bestLength) {
+                    bestLength = length;
+                    chosen[i] = static_cast<int>(j);
+                }
+            }
+        }
+        firstVariant[c] = static_cast<int>(variantAlgorithms.size());
+        std::vector<int> pre(membersOf[c].size()), post(membersOf[c].size());
+        for (std::size_t i = 0; i < membersOf[c].size(); i++) {
+            int j = chosen[i];
+            if (kept[j] < 0) {
+                kept[j] = static_cast<int>(variantAlgorithms.size()) - firstVariant[c];
+                variantAlgorithms.push_back(candidates[j]);
+            }
+            int member = membersOf[c][i];
+            variantOf[member] = kept[j];
+            pre[i] = (preOf[member] - preOf[sources[j]]) & 3;
+            post[i] = (postOf[member] - postOf[sources[j]]) & 3;
+        }
+        // Rebased only now: the sources' own AUFs are still needed above
+        for (std::size_t i = 0; i < membersOf[c].size(); i++) {
+            preOf[membersOf[c][i]] = pre[i];
+            postOf[membersOf[c][i]] = post[i];
+        }
+        variantCountOf[c] = static_cast<int>(variantAlgorithms.size()) - firstVariant[c];
+    }
+
+    // Serialize the image
+    std::uint32_t algorithmBytes = 0;
+    for (const std::vector<int>& algorithm : variantAlgorithms) {
+        algorithmBytes += static_cast<std::uint32_t>(algorithm.size());
+    }
+    std::vector<std::vector<int>> ollAlgorithms;
+    for (int rep : ollRep) {
+        ollAlgorithms.push_back(solutionOf(macros, orient, rep));
+        algorithmBytes += static_cast<std::uint32_t>(ollAlgorithms.back().size());
+    }
+    std::string nameData;
+    std::vector<std::uint32_t> nameOffsets;
+    for (const std::vector<std::string>* list : {&ollNames, &pllNames}) {
+        for (const std::string& name : *list) {
+            nameOffsets.push_back(static_cast<std::uint32_t>(nameData.size()));
+            nameData += name;
+            nameData += '\0';
+        }
+    }
+
+    std::size_t size = HEADER_SIZE + LAST_LAYER_STATES * STATE_ENTRY_SIZE + caseRep.size() * CASE_ENTRY_SIZE +
+                       variantAlgorithms.size() * VARIANT_ENTRY_SIZE + ollNames.size() * OLL_ENTRY_SIZE +
+                       nameOffsets.size() * 4 + algorithmBytes + nameData.size();
+    image.assign(size, 0);
+    std::uint8_t* out = image.data();
+    std::memcpy(out, DB_MAGIC, 8);
+    putU32(out + 8, DB_VERSION);
+    putU32(out + 12, LAST_LAYER_STATES);
+    putU32(out + 16, static_cast<std::uint32_t>(caseRep.size()));
+    putU32(out + 20, static_cast<std::uint32_t>(ollNames.size()));
+    putU32(out + 24, static_cast<std::uint32_t>(pllNames.size()));
+    putU32(out + 28, algorithmBytes);
+    putU32(out + 32, static_cast<std::uint32_t>(nameData.size()));
+    putU32(out + 36, static_cast<std::uint32_t>(variantAlgorithms.size()));
+
+    std::uint8_t* stateOut = out + HEADER_SIZE;
+    for (int s = 0; s < LAST_LAYER_STATES; s++, stateOut += STATE_ENTRY_SIZE) {
+        putU16(stateOut, static_cast<std::uint32_t>(caseOf[s]));
+        stateOut[2] = static_cast<std::uint8_t>(preOf[s]);
+        stateOut[3] = static_cast<std::uint8_t>(postOf[s]);
+        stateOut[4] = static_cast<std::uint8_t>(ollOf[s]);
+        stateOut[5] = static_cast<std::uint8_t>(pllOfCase[caseOf[s]]);
+        stateOut[6] = static_cast<std::uint8_t>(ollAufOf[s]);
+        stateOut[7] = static_cast<std::uint8_t>(variantOf[s]);
+    }
+    std::uint8_t* caseOut = stateOut;
+    std::uint8_t* variantOut = caseOut + caseRep.size() * CASE_ENTRY_SIZE;
+    std::uint8_t* ollOut = variantOut + variantAlgorithms.size() * VARIANT_ENTRY_SIZE;
+    std::uint8_t* nameOut = ollOut + ollNames.size() * OLL_ENTRY_SIZE;
+    std::uint8_t* algorithmOut = nameOut + nameOffsets.size() * 4;
+    std::uint32_t offset = 0;
+    for (std::size_t c = 0; c < caseRep.size(); c++, caseOut += CASE_ENTRY_SIZE) {
+        putU32(caseOut, static_cast<std::uint32_t>(firstVariant[c]));
+        putU16(caseOut + 4, static_cast<std::uint32_t>(variantCountOf[c]));
+        caseOut[6] = static_cast<std::uint8_t>(ollOf[caseRep[c]]);
+        caseOut[7] = static_cast<std::uint8_t>(pllOfCase[c]);
+    }
+    for (const std::vector<int>& algorithm : variantAlgorithms) {
+        putU32(variantOut, offset);
+        putU16(variantOut + 4, static_cast<std::uint32_t>(algorithm.size()));
+        variantOut += VARIANT_ENTRY_SIZE;
+        for (int move : algorithm) algorithmOut[offset++] = static_cast<std::uint8_t>(move);
+    }
+    for (std::size_t i = 0; i < ollAlgorithms.size(); i++, ollOut += OLL_ENTRY_SIZE) {
+        putU32(ollOut, offset);
+        putU16(ollOut + 4, static_cast<std::uint32_t>(ollAlgorithms[i].size()));
+        for (int move : ollAlgorithms[i]) algorithmOut[offset++] = static_cast<std::uint8_t>(move);
+    }
+    for (std::size_t i = 0; i < nameOffsets.size(); i++) putU32(nameOut + 4 * i, nameOffsets[i]);
+    std::memcpy(algorithmOut + algorithmBytes, nameData.data(), nameData.size());
+
+    attach(image.data(), image.size());
+}
+
+// Check the header and that every section fits, then set the section pointers
+bool LastLayerDatabase::attach(const std::uint8_t* data, std::size_t size) {
+    base = nullptr;
+    if (size < HEADER_SIZE || std::memcmp(data, DB_MAGIC, 8) != 0 || getU32(data + 8) != DB_VERSION ||
+        getU32(data + 12) != LAST_LAYER_STATES) {
+        return false;
+    }
+    caseCount = getU32(data + 16);
+    ollCount = getU32(data + 20);
+    pllCount = getU32(data + 24);
+    std::size_t algorithmBytes = getU32(data + 28);
+    std::size_t nameBytes = getU32(data + 32);
+    variantCount = getU32(data + 36);
+    std::size_t expected = HEADER_SIZE + LAST_LAYER_STATES * STATE_ENTRY_SIZE + caseCount * CASE_ENTRY_SIZE +
+                           variantCount * VARIANT_ENTRY_SIZE + ollCount * OLL_ENTRY_SIZE + (ollCount + pllCount) * 4 +
+                           algorithmBytes + nameBytes;
+    if (expected != size || nameBytes == 0 || data[size - 1] != 0) return false;
+
+    states = data + HEADER_SIZE;
+    cases = states + LAST_LAYER_STATES * STATE_ENTRY_SIZE;
+    variants = cases + caseCount * CASE_ENTRY_SIZE;
+    olls = variants + variantCount * VARIANT_ENTRY_SIZE;
+    names = olls + ollCount * OLL_ENTRY_SIZE;
+    algorithms = names + (ollCount + pllCount) * 4;
+    nameBlob = algorithms + algorithmBytes;
+    for (std::uint32_t i = 0; i < ollCount + pllCount; i++) {
+        if (getU32(names + 4 * i) >= nameBytes) return false;
+    }
+    // recognize() trusts the slots, so every case and variant they name has to exist
+    for (std::uint32_t c = 0; c < caseCount; c++) {
+        const std::uint8_t* entry = cases + static_cast<std::size_t>(c) * CASE_ENTRY_SIZE;
+        if (static_cast<std::uint64_t>(getU32(entry)) + getU16(entry + 4) > variantCount) return false;
+    }
+    for (std::uint32_t v = 0; v < variantCount; v++) {
+        const std::uint8_t* entry = variants + static_cast<std::size_t>(v) * VARIANT_ENTRY_SIZE;
+        if (static_cast<std::uint64_t>(getU32(entry)) + getU16(entry + 4) > algorithmBytes) return false;
+    }
+    for (int s = 0; s < LAST_LAYER_STATES; s++) {
+        const std::uint8_t* slot = states + static_cast<std::size_t>(s) * STATE_ENTRY_SIZE;
+        if (getU16(slot) >= caseCount || slot[7] >= getU16(cases + getU16(slot) * CASE_ENTRY_SIZE + 4)) return false;
+    }
+    base = data;
+    return true;
+}
+
+bool LastLayerDatabase::save(const std::string& path) const {
+    if (!base) return false;
+    const std::uint8_t* data = image.empty() ? mapping.data() : image.data();
+    std::size_t size = image.empty() ? mapping.size() : image.size();
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+    bool ok = std::fwrite(data, 1, size, file) == size;
+    return (std::fclose(file) == 0) && ok;
+}
+
+bool LastLayerDatabase::open(const std::string& path) {
+    image.clear();
+    base = nullptr;
+    if (!mapping.open(path)) return false;
+    if (!attach(mapping.data(), mapping.size())) {
+        mapping.close();
+        return false;
+    }
+    return true;
+}
+
+const char* LastLayerDatabase::ollName(int oll) const {
+    if (!base || oll < 0 || oll >= static_cast<int>(ollCount)) return "";
+    return reinterpret_cast<const char*>(nameBlob + getU32(names + 4 * oll));
+}
+
+const char* LastLayerDatabase::pllName(int pll) const {
+    if (!base || pll < 0 || pll >= static_cast<int>(pllCount)) return "";
+    return reinterpret_cast<const char*>(nameBlob + getU32(names + 4 * (ollCount + pll)));
+}
+
+bool LastLayerDatabase::recognize(const CubieCube& cube, LastLayerMatch& match) const {
+    int index = base ? lastLayerIndex(cube) : -1;
+    if (index < 0) return false;
+
+    const std::uint8_t* slot = states + static_cast<std::size_t>(index) * STATE_ENTRY_SIZE;
+    const std::uint8_t* entry = cases + static_cast<std::size_t>(getU16(slot)) * CASE_ENTRY_SIZE;
+    const std::uint8_t* variant = variants + static_cast<std::size_t>(getU32(entry) + slot[7]) * VARIANT_ENTRY_SIZE;
+    match.caseId = static_cast<int>(getU16(slot));
+    match.preAuf = slot[2];
+    match.postAuf = slot[3];
+    match.oll = slot[4];
+    match.pll = slot[5];
+    match.edgesOriented = (cube.eo[0] | cube.eo[1] | cube.eo[2] | cube.eo[3]) == 0;
+    match.algorithm = algorithms + getU32(variant);
+    match.algorithmLength = static_cast<int>(getU16(variant + 4));
+    const std::uint8_t* oll = olls + static_cast<std::size_t>(match.oll) * OLL_ENTRY_SIZE;
+    match.ollAuf = slot[6];
+    match.ollAlgorithm = algorithms + getU32(oll);
+    match.ollAlgorithmLength = static_cast<int>(getU16(oll + 4));
+    return true;
+}
+
+bool LastLayerDatabase::recognize(const RubikCube& cube, LastLayerMatch& match) const {
+    CubieCube cubie;
+    return CubieCube::fromFacelets(cube, cubie) && recognize(cubie, match);
+}
@@ -0,0 +1,105 @@
+// Last Layer Database Header
+// Precomputed last-layer cases (OLL / PLL / full 1LLL) with constant-time recognition
+//
+// Every state with the first two layers solved is ranked by a perfect hash of its U-layer
+// pattern (corner perm 4!, twist 3^3, edge perm 4!/2 under the parity rule, flip 2^3 = 62208
+// slots). Each slot names its case - the class of states equal up to a U turn before and after
+// (AUF) - and one of the case's algorithm variants with the AUFs relating the slot to it. A case
+// keeps a variant only when some slot solves shorter with it than with the earlier ones, so
+// every slot gets the shortest solution the search found over all AUF conjugates.
+//
+// Each OLL class also stores an orienting algorithm for its reference pattern, so a two-look
+// solve (orient, then recognize the PLL) needs no search either.
+//
+// File layout (little-endian, mapped read-only):
+//   header   "RBKLLDB1", u32 version, u32 state count, u32 case count, u32 OLL count,
+//            u32 PLL count, u32 algorithm bytes, u32 name bytes, u32 variant count
+//   states   per slot: u16 case, u8 pre-AUF, u8 post-AUF, u8 OLL, u8 PLL, u8 OLL AUF, u8 variant
+//   cases    per case: u32 first variant, u16 variant count, u8 OLL, u8 PLL
+//   variants per variant: u32 algorithm offset, u16 algorithm length, u16 reserved
+//   olls     per OLL class: u32 algorithm offset, u16 algorithm length, u16 reserved
+//   names    u32 offset per OLL then per PLL into the name blob
+//   blobs    algorithm moves (move indices), then null-terminated names
+
+#ifndef LAST_LAYER_H
+#define LAST_LAYER_H
+
+#include "cubie_cube.h"
+#include "mapped_file.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+constexpr int LAST_LAYER_STATES = 62208;
+constexpr int NO_LAST_LAYER_CLASS = 0xFF;  // PLL of a state whose last layer is not oriented
+
+// Recognition result; algorithm points into the database
+struct LastLayerMatch {
+    int caseId;
+    int oll;            // Orientation class (0 = oriented)
+    int pll;            // Permutation case, NO_LAST_LAYER_CLASS unless oriented (0 = solved)
+    int preAuf;         // State = U^pre * (state the algorithm solves) * U^post
+    int postAuf;
+    bool edgesOriented; // ZBLL (and PLL) cases
+    const std::uint8_t* algorithm;
+    int algorithmLength;
+    int ollAuf;         // State * U^ollAuf shows the OLL class's reference pattern
+    const std::uint8_t* ollAlgorithm;
+    int ollAlgorithmLength;
+
+    // Full solution for the state: U^-post, algorithm, U^-pre (AUFs merged)
+    void solution(std::vector<int>& moves) const;
+
+    // Orientation only: U^ollAuf, then the OLL algorithm (leaves a PLL case)
+    void orientation(std::vector<int>& moves) const;
+};
+
+// Perfect hash of the U layer; -1 if the first two layers are not solved
+int lastLayerIndex(const CubieCube& cube);
+
+// Inverse of lastLayerIndex for 0 <= index < LAST_LAYER_STATES
+CubieCube lastLayerState(int index);
+
+class LastLayerDatabase {
+private:
+    std::vector<std::uint8_t> image;  // Built in memory
+    MappedFile mapping;               // Or mapped from a file
+    const std::uint8_t* base;
+    std::uint32_t caseCount;
+    std::uint32_t ollCount;
+    std::uint32_t pllCount;
+    std::uint32_t variantCount;
+    const std::uint8_t* states;
+    const std::uint8_t* cases;
+    const std::uint8_t* variants;
+    const std::uint8_t* olls;
+    const std::uint8_t* names;
+    const std::uint8_t* algorithms;
+    const std::uint8_t* nameBlob;
+
+    bool attach(const std::uint8_t* data, std::size_t size);
+
+public:
+    LastLayerDatabase();
+
+    // Search every last-layer state: shortest compositions of the built-in algorithm set
+    // (plus mirrors, inverses, y-conjugates and AUFs), then group states into cases and give
+    // each slot the shortest of its case members' algorithms once wrapped in AUFs
+    void build();
+
+    bool save(const std::string& path) const;
+    bool open(const std::string& path);
+    bool isReady() const { return base != nullptr; }
+
+    std::uint32_t size() const { return caseCount; }
+    std::uint32_t ollCases() const { return ollCount; }
+    std::uint32_t pllCases() const { return pllCount; }
+    const char* ollName(int oll) const;
+    const char* pllName(int pll) const;
+
+    // O(1): rank the U layer and read one slot; false if F2L is not solved
+    bool recognize(const CubieCube& cube, LastLayerMatch& match) const;
+    bool recognize(const RubikCube& cube, LastLayerMatch& match) const;
+};
+
+#endif // LAST_LAYER_H
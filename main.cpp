@@ -4,36 +4,148 @@
 #include <SFML/Graphics.hpp>
 #include <SFML/OpenGL.hpp>
 #include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <random>
+#include <cstring>
+#include <cstdlib>
+#include <deque>
+#include <chrono>
+#include <memory>
 #include "rubik_cube.h"
 #include "renderer.h"
+#include "profiler.h"
+#include "session_log.h"
+#include "last_layer.h"
+#include "human_solver.h"
+#include "distance_estimator.h"
+#include "solver_service.h"
+#include "resource_loader.h"
+#include "cube_wall.h"
+#include "move_sequence.h"
+#include "headless_script.h"
 
 constexpr int WINDOW_WIDTH = 1400;
 constexpr int WINDOW_HEIGHT = 1000;
+constexpr int SCRAMBLE_MOVES = 25;
+constexpr std::uint32_t MAX_REPLAY_SCRAMBLE_MOVES = 1000;  // Larger counts in a log are corrupt
+constexpr int DEFAULT_WALL_CUBES = 500;
+constexpr float VIRTUAL_FRAME_SECONDS = 1.0f / 60.0f;  // Headless clock step
+constexpr std::uint64_t HEADLESS_MAX_IDLE_FRAMES = 1000000;
+
+// Taken during static initialization - the reference point for time-to-first-frame
+static const std::chrono::steady_clock::time_point PROCESS_START = std::chrono::steady_clock::now();
+
+static double millisecondsSinceStart() {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - PROCESS_START).count();
+}
+
+// Command-line options
+struct GameOptions {
+    std::string recordPath;     // Session log to append to (--record; empty = no recording)
+    std::string replayPath;     // Session log to replay (disables recording)
+    bool replayUnlimited;       // Replay everything at once instead of in real time
+    std::string lastLayerPath;  // Last-layer case database (optional, see rubik_lldb)
+    std::string solverSocket;   // rubik_solverd socket for step-by-step solves (empty = in-process)
+    std::string executablePath; // argv[0], for assets bundled next to the executable
+    int wallCubes;              // Start in wall mode with this many cubes (0 = single cube)
+    std::uint32_t seed;         // Scramble seeds come from this (0 = random device)
+    std::string headlessScript; // Run the script offscreen on a virtual clock, then exit
+    std::string reportPath;     // Headless JSON report
+    std::string framePath;      // Headless: save the final frame as an image
+    
+    GameOptions()
+        : replayUnlimited(false), lastLayerPath("last_layer.db"), wallCubes(0),
+          seed(0), reportPath("rubik_headless.json") {}
+};
+
+// FNV-1a over all stickers - compact fingerprint for replay verification
+static std::uint64_t stateChecksum(const RubikCube& cube) {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (const auto& face : cube.getFaces()) {
+        for (const auto& row : face) {
+            for (int color : row) {
+                hash = (hash ^ static_cast<std::uint64_t>(color)) * 1099511628211ull;
+            }
+        }
+    }
+    return hash;
+}
+
+// FNV-1a over the RGBA pixels of a rendered frame
+static std::uint64_t imageChecksum(const sf::Image& image) {
+    std::uint64_t hash = 14695981039346656037ull;
+    const sf::Uint8* pixels = image.getPixelsPtr();
+    std::size_t bytes = static_cast<std::size_t>(image.getSize().x) * image.getSize().y * 4;
+    for (std::size_t i = 0; i < bytes; i++) {
+        hash = (hash ^ pixels[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+// Quarter turn waiting in the move queue, tagged with the solve stage it belongs to
+struct QueuedMove {
+    int face;
+    bool clockwise;
+    int stage;
+};
 
 // Main game class - manages cube, renderer, UI, and input
 class RubikGame {
 private:
     RubikCube cube;
     Renderer renderer;
+    // Font and table warm-up load in the background; declared before the font so the
+    // buffer sf::Font was loaded from outlives it
+    ResourceLoader resources;
     sf::Font font;
     sf::Text statusText;
     sf::Text instructionText;
+    sf::Text profilerText;
     bool isDragging;
     sf::Vector2i lastMousePos;
+    bool isTurning;               // Drag started on a sticker: turns a layer instead of the camera
+    StickerHit turnStart;
     bool showInstructions;
+    bool showProfiler;
     AnimationState animation;
     sf::Clock animationClock;
-    const float ANIMATION_SPEED = 300.0f; // degrees per second
     
-    bool loadFont() {
-        if (!font.loadFromFile("C:/Windows/Fonts/arial.ttf")) {
-            if (!font.loadFromFile("C:/Windows/Fonts/calibri.ttf")) {
-                std::cerr << "Warning: Could not load font. Text may not display correctly." << std::endl;
-                return false;
-            }
-        }
-        return true;
-    }
+    // Session recording and replay
+    SessionRecorder recorder;
+    SessionReader replayReader;
+    SessionEvent replayEvent;     // Next event to apply
+    bool replaying;
+    bool replayHasEvent;
+    double replayClock;           // Microseconds since the replayed session started
+    std::uint64_t replayedEvents;
+    std::uint64_t replayedMoves;
+    
+    // Last-layer hints once the first two layers are solved
+    LastLayerDatabase lastLayer;
+    
+    // Step-by-step solve played back through the move queue
+    HumanSolver humanSolver;
+    std::vector<SolveStage> solveStages;
+    std::deque<QueuedMove> moveQueue;
+    int playingStage;
+    SolverClient solverClient;    // Connected when --solver is given and the daemon is running
+    
+    // Distance-to-solved estimate, evaluated off the render thread
+    AsyncEstimator estimator;
+    DistanceEstimate estimate;
+    bool hasEstimate;
+    // Wall of independently scrambling cubes (F5), created on first use
+    std::unique_ptr<CubeWall> wall;
+    int wallSize;
+    bool showWall;
+    
+    bool fontApplied;
+    double firstFrameMs;           // Process start to the first presented frame
+    std::mt19937 seedSource;       // Scramble seeds when --seed (or --headless) fixes them
+    bool fixedSeeds;
+    std::uint64_t movesApplied;
+    const float ANIMATION_SPEED = 300.0f; // degrees per second
 
  // In game text   
     void setupUI() {
@@ -49,15 +161,26 @@ private:
             instructionText.setPosition(10, 50);
             instructionText.setString(
                 "Mouse Drag: Rotate camera\n"
+                "Drag a sticker: Turn its face\n"
                 "Mouse Wheel: Zoom in/out\n"
                   "\n"
                 "Q/W/E/R/T/Y: Rotate clockwise\n"
                 "Shift+Q/W/E/R/T/Y: Rotate counter-clockwise\n"
                   "\n"
                 "S: Scramble\n"
+                "H: Solve step by step (cross, F2L, OLL, PLL)\n"
                 "Space: Reset\n"
-                "I: Toggle UI"
+                "I: Toggle UI\n"
+                "F5: Wall of cubes\n"
+#ifdef RUBIK_ENABLE_PROFILER
+                "F3: Profiler overlay\n"
+                "F4: Export trace"
+#endif
             );
+            
+            profilerText.setFont(font);
+            profilerText.setCharacterSize(16);
+            profilerText.setFillColor(sf::Color::Yellow);
         }
         updateUI();
     }
@@ -67,25 +190,188 @@ private:
         if (font.getInfo().family == "") return;
         
         std::string status = "";
-        if (cube.isSolved()) {
+        LastLayerMatch match;
+        if (showWall) {
+            status = "Wall: " + std::to_string(wall->size()) + " cubes, " + std::to_string(wall->threadCount()) +
+                     " update threads   (F5: back to the cube)";
+            statusText.setString(status);
+            return;
+        }
+        if (playingStage >= 0) {
+            const SolveStage& stage = solveStages[playingStage];
+            status += stage.name + " (" + std::to_string(playingStage + 1) + "/" + std::to_string(solveStages.size()) +
+                      ")   " + sequenceToString(stage.moves);
+        } else if (cube.isSolved()) {
             status += "Solved";
+        } else if (lastLayer.isReady() && lastLayer.recognize(cube, match)) {
+            std::vector<int> moves;
+            match.solution(moves);
+            status += std::string("OLL: ") + lastLayer.ollName(match.oll);
+            if (match.pll != NO_LAST_LAYER_CLASS) {
+                status += std::string("   PLL: ") + lastLayer.pllName(match.pll);
+            }
+            status += "   " + sequenceToString(moves);
+        }
+        if (hasEstimate && !cube.isSolved()) {
+            std::ostringstream distance;
+            distance << std::fixed << std::setprecision(0) << (status.empty() ? "" : "   ") << "~" << estimate.moves
+                     << " moves from solved (at least " << estimate.lowerBound << ")";
+            status += distance.str();
         }
         statusText.setString(status);
     }
     
 // Constructor, sets up game's initial state.
 public:
-    RubikGame() : isDragging(false), showInstructions(true) {
-        loadFont();
+    explicit RubikGame(const GameOptions& options)
+        : isDragging(false), isTurning(false), showInstructions(true), showProfiler(false),
+          replaying(false), replayHasEvent(false), replayClock(0.0), replayedEvents(0), replayedMoves(0),
+          humanSolver(&lastLayer), playingStage(-1), estimate(), hasEstimate(false),
+          wallSize(options.wallCubes > 0 ? options.wallCubes : DEFAULT_WALL_CUBES), showWall(false),
+          fontApplied(false), firstFrameMs(0.0), seedSource(options.seed), fixedSeeds(options.seed != 0),
+          movesApplied(0) {
+        if (!options.solverSocket.empty()) {
+            if (solverClient.connect(options.solverSocket)) {
+                std::cout << "Using solver daemon at " << options.solverSocket << std::endl;
+            } else {
+                std::cerr << "Warning: No solver daemon at " << options.solverSocket << ", solving in-process" << std::endl;
+            }
+        }
+        // With a daemon the tables stay in the daemon; the database is still mapped for the hints
+        bool warmUp = lastLayer.open(options.lastLayerPath) && !solverClient.isConnected();
+        resources.start(options.executablePath, warmUp ? std::function<void()>(HumanSolver::warmUp) : nullptr);
+        // Headless runs start with the font and tables in place so every run draws the same frames
+        if (!options.headlessScript.empty()) resources.wait();
         setupUI();
         renderer.initialize();
-        cube.scramble();
+        
+        if (!options.replayPath.empty()) {
+            startReplay(options.replayPath, options.replayUnlimited);
+        } else {
+            if (!options.recordPath.empty() && !recorder.open(options.recordPath)) {
+                std::cerr << "Warning: Could not open session log " << options.recordPath << std::endl;
+            }
+            scrambleCube();
+        }
+        if (options.wallCubes > 0) {
+            toggleWall();
+        }
+        updateUI();
+    }
+    
+// Cube state changes - every change goes through here so it can be recorded
+    void applyMoveToCube(int move) {
+        cube.applyMoveIndex(move);
+        recorder.logMove(move);
+        movesApplied++;
+        PROFILE_COUNT(COUNTER_MOVES, 1);
+        cubeChanged();
+    }
+    
+    // Queue the new state for an estimate (shown by updateEstimate when ready) and refresh the UI
+    void cubeChanged() {
+        estimator.post(cube);
         updateUI();
     }
+    
+    void scrambleCube() {
+        stopSolve();
+        std::uint32_t seed = fixedSeeds ? static_cast<std::uint32_t>(seedSource()) : std::random_device()();
+        cube.scramble(SCRAMBLE_MOVES, seed);
+        recorder.logScramble(seed, SCRAMBLE_MOVES);
+        cubeChanged();
+    }
+    
+    void resetCube() {
+        stopSolve();
+        cube.reset();
+        animation.isAnimating = false;
+        recorder.logReset();
+        cubeChanged();
+    }
+    
+// Replay - feeds a session log back through the same move path
+    void startReplay(const std::string& path, bool unlimited) {
+        if (!replayReader.open(path)) {
+            std::cerr << "Error: Could not read session log " << path << std::endl;
+            return;
+        }
+        std::cout << "Replaying " << path << (unlimited ? " (unlimited speed)" : " (1x)") << std::endl;
+        replaying = true;
+        replayHasEvent = replayReader.next(replayEvent);
+        
+        if (unlimited) {
+            while (replayHasEvent) {
+                applyReplayEvent(replayEvent, false);
+                replayHasEvent = replayReader.next(replayEvent);
+            }
+            finishReplay();
+        }
+    }
+    
+    void applyReplayEvent(const SessionEvent& event, bool animate) {
+        switch (event.type) {
+            case EVENT_MOVE:
+                // Quarter turns animate at 1x; anything else is applied directly
+                if (animate && event.move % 3 != 1) {
+                    startAnimation(event.move / 3, event.move % 3 == 0);
+                } else {
+                    applyMoveToCube(event.move);
+                }
+                replayedMoves++;
+                break;
+            case EVENT_SCRAMBLE:
+                if (event.count > MAX_REPLAY_SCRAMBLE_MOVES) {
+                    std::cerr << "Warning: skipping scramble of " << event.count << " moves in session log" << std::endl;
+                    break;
+                }
+                cube.scramble(static_cast<int>(event.count), event.seed);
+                cubeChanged();
+                break;
+            case EVENT_RESET:
+                resetCube();
+                break;
+            case EVENT_CAMERA:
+                renderer.setCamera(event.camera[0], event.camera[1], event.camera[2]);
+                break;
+            case EVENT_SESSION_START:
+                // Each recorded session started from a solved cube
+                cube.reset();
+                replayClock = 0.0;
+                cubeChanged();
+                break;
+        }
+        replayedEvents++;
+    }
+    
+    // Apply every event whose timestamp has passed, one turn animation at a time
+    void updateReplay(float deltaTime) {
+        if (!replaying) return;
+        PROFILE_SCOPE("RubikGame::updateReplay");
+        
+        replayClock += deltaTime * 1000000.0;
+        // Every event waits for the running turn, so it lands on the state it was recorded on
+        while (replayHasEvent && replayEvent.time <= replayClock && !animation.isAnimating) {
+            applyReplayEvent(replayEvent, true);
+            replayHasEvent = replayReader.next(replayEvent);
+        }
+        // The last move may still be animating; the checksum has to include it
+        if (!replayHasEvent && !animation.isAnimating && moveQueue.empty()) {
+            finishReplay();
+        }
+    }
+    
+    void finishReplay() {
+        replaying = false;
+        std::cout << "Replay finished: " << replayedEvents << " events, " << replayedMoves << " moves, "
+                  << (cube.isSolved() ? "solved" : "unsolved") << ", state checksum "
+                  << std::hex << stateChecksum(cube) << std::dec << std::endl;
+    }
 
 // Animation methods    
     void updateAnimation(float deltaTime) {
         if (!animation.isAnimating) return;
+        PROFILE_SCOPE("RubikGame::updateAnimation");
         
         float angleDelta = ANIMATION_SPEED * deltaTime;
         if (animation.clockwise) {
@@ -119,41 +405,151 @@ public:
     }
     
     void applyRotationToCube() {
-        switch (animation.face) {
-            case RIGHT:
-                if (animation.clockwise) cube.rotateR();
-                else cube.rotateRPrime();
-                break;
-            case LEFT:
-                if (animation.clockwise) cube.rotateL();
-                else cube.rotateLPrime();
-                break;
-            case UP:
-                if (animation.clockwise) cube.rotateU();
-                else cube.rotateUPrime();
-                break;
-            case DOWN:
-                if (animation.clockwise) cube.rotateD();
-                else cube.rotateDPrime();
-                break;
-            case FRONT:
-                if (animation.clockwise) cube.rotateF();
-                else cube.rotateFPrime();
-                break;
-            case BACK:
-                if (animation.clockwise) cube.rotateB();
-                else cube.rotateBPrime();
-                break;
+        if (animation.face < RIGHT || animation.face > BACK) return;
+        // Clockwise quarter turn = face * 3, counter-clockwise = face * 3 + 2
+        applyMoveToCube(animation.face * 3 + (animation.clockwise ? 0 : 2));
+    }
+    
+// Step-by-step solve - stages are queued as quarter turns and played one per animation
+    void startSolve() {
+        bool solved = false;
+        if (solverClient.isConnected()) {
+            CubieCube state;
+            solved = CubieCube::fromFacelets(cube, state) && solverClient.solve(state, solveStages);
+            if (!solved) {
+                std::cerr << "Solver daemon " << (solverClient.isConnected() ? "could not solve" : "went away or timed out")
+                          << ", solving in-process" << std::endl;
+            }
+        }
+        if (!solved && !lastLayer.isReady()) {
+            std::cerr << "Step-by-step solve needs a last-layer database (rubik_lldb build last_layer.db)" << std::endl;
+            return;
+        }
+        if (!solved && !humanSolver.solve(cube, solveStages)) {
+            std::cerr << "Step-by-step solve failed" << std::endl;
+            return;
+        }
+        double microseconds = 0.0;
+        for (int s = 0; s < static_cast<int>(solveStages.size()); s++) {
+            microseconds += solveStages[s].microseconds;
+            for (int move : solveStages[s].moves) {
+                QueuedMove quarter = {move / 3, move % 3 != 2, s};
+                moveQueue.push_back(quarter);
+                if (move % 3 == 1) moveQueue.push_back(quarter); // Half turn = two quarter turns
+            }
+        }
+        std::cout << "Step-by-step solve: " << flattenStages(solveStages).size() << " moves in "
+                  << solveStages.size() << " stages (" << microseconds << " us)" << std::endl;
+    }
+    
+    // Apply the font once the loader has read it (sf::Font parses from the loader's buffer)
+    void updateResources() {
+        if (fontApplied || !resources.fontReady()) return;
+        fontApplied = true;
+        const FontAsset& asset = resources.getFont();
+        if (asset.path.empty() || !font.loadFromMemory(asset.data.data(), asset.data.size())) {
+            std::cerr << "Warning: Could not load a font (set RUBIK_FONT or add assets/fonts/ui.ttf). "
+                      << "Text will not be shown." << std::endl;
+            return;
+        }
+        std::cout << "Font " << asset.path << " ready after " << millisecondsSinceStart() << " ms ("
+                  << asset.milliseconds << " ms on the loader thread)" << std::endl;
+        setupUI();
+    }
+    
+    void setFirstFrameTime(double milliseconds) {
+        firstFrameMs = milliseconds;
+    }
+    
+    // Switch between the single cube and the wall; the wall only updates while shown, so
+    // switching back resumes where it stopped
+    void toggleWall() {
+        if (!wall) {
+            PROFILE_SCOPE("RubikGame::createWall");
+            wall.reset(new CubeWall(wallSize));
+        }
+        showWall = !showWall;
+        if (showWall) {
+            renderer.setCamera(10.0f, 0.0f, 8.0f);  // Facing the wall
+        } else {
+            renderer.resetCamera();
         }
         updateUI();
     }
     
+    void updateWall(float deltaTime) {
+        if (showWall) wall->update(deltaTime);
+    }
+    
+    // Pick up a finished estimate; the frame never waits for one
+    void updateEstimate() {
+        if (estimator.poll(estimate)) {
+            hasEstimate = true;
+            updateUI();
+        }
+    }
+    
+    // Headless: take the estimate for the current state now instead of whenever the thread finishes
+    void waitForEstimate() {
+        if (estimator.wait(estimate)) {
+            hasEstimate = true;
+            updateUI();
+        }
+    }
+    
+    // No turn animating or queued and no replay events left
+    bool isIdle() const {
+        return !animation.isAnimating && moveQueue.empty() && !replaying;
+    }
+    
+    const RubikCube& getCube() const { return cube; }
+    std::uint64_t getMovesApplied() const { return movesApplied; }
+    
+    void stopSolve() {
+        moveQueue.clear();
+        playingStage = -1;
+    }
+    
+    // Start the next queued turn once the previous animation has finished
+    void updateMoveQueue() {
+        if (animation.isAnimating) return;
+        if (moveQueue.empty()) {
+            if (playingStage >= 0) {
+                playingStage = -1;
+                updateUI();
+            }
+            return;
+        }
+        QueuedMove next = moveQueue.front();
+        moveQueue.pop_front();
+        if (next.stage != playingStage) {
+            playingStage = next.stage;
+            updateUI();
+        }
+        startAnimation(next.face, next.clockwise);
+    }
+    
 // Input handling
-    void handleKeyPress(sf::Keyboard::Key key) {
-        if (animation.isAnimating) return; // Ignore input during animation
+    void handleKeyPress(sf::Keyboard::Key key, bool shift) {
+        if (key == sf::Keyboard::F5) {
+            toggleWall();
+            return;
+        }
+        // The cube is hidden behind the wall, or owned by a replay; only the view keys apply there
+        bool viewKey = key == sf::Keyboard::I || key == sf::Keyboard::F3 || key == sf::Keyboard::F4;
+        if ((showWall || replaying) && !viewKey) return;
         
-        bool shift = sf::Keyboard::isKeyPressed(sf::Keyboard::LShift) || 
-                     sf::Keyboard::isKeyPressed(sf::Keyboard::RShift);
+        // H starts a step-by-step solve, or stops the one playing
+        if (key == sf::Keyboard::H) {
+            if (playingStage >= 0 || !moveQueue.empty()) {
+                stopSolve();
+                updateUI();
+            } else if (!animation.isAnimating) {
+                startSolve();
+            }
+            return;
+        }
+        if (animation.isAnimating || !moveQueue.empty()) return; // Ignore input during animation
         
         switch (key) {
             case sf::Keyboard::Q:
@@ -175,32 +571,57 @@ public:
                 startAnimation(BACK, !shift);
                 break;
             case sf::Keyboard::S:
-                cube.scramble();
-                updateUI();
+                scrambleCube();
                 break;
             case sf::Keyboard::Space:
-                cube.reset();
-                animation.isAnimating = false;
-                updateUI();
+                resetCube();
                 break;
             case sf::Keyboard::I:
                 showInstructions = !showInstructions;
                 break;
+#ifdef RUBIK_ENABLE_PROFILER
+            case sf::Keyboard::F3:
+                showProfiler = !showProfiler;
+                break;
+            case sf::Keyboard::F4:
+                if (Profiler::instance().exportChromeTrace("rubik_trace.json")) {
+                    std::cout << "Trace written to rubik_trace.json" << std::endl;
+                }
+                break;
+#endif
             default:
                 break;
         }
     }
     
+    // A press on a sticker starts a turn drag, anywhere else a camera drag
     void handleMouseButtonPressed(sf::Vector2i mousePos) {
+        bool idle = !showWall && !replaying && !animation.isAnimating && moveQueue.empty();
+        if (idle && renderer.pickSticker(mousePos.x, mousePos.y, turnStart)) {
+            isTurning = true;
+            return;
+        }
         isDragging = true;
         lastMousePos = mousePos;
     }
     
     void handleMouseButtonReleased() {
+        if (isDragging) {
+            recorder.logCamera(renderer.getCameraAngleX(), renderer.getCameraAngleY(), renderer.getCameraDistance());
+        }
         isDragging = false;
+        isTurning = false;
     }
     
     void handleMouseMove(sf::Vector2i mousePos) {
+        // One turn per drag, as soon as the drag is long enough to tell its direction
+        int face;
+        bool clockwise;
+        if (isTurning && renderer.dragTurn(turnStart, mousePos.x, mousePos.y, face, clockwise)) {
+            isTurning = false;
+            if (!animation.isAnimating && moveQueue.empty()) startAnimation(face, clockwise);
+            return;
+        }
         if (isDragging) {
             int deltaX = mousePos.x - lastMousePos.x;
             int deltaY = mousePos.y - lastMousePos.y;
@@ -211,37 +632,268 @@ public:
     
     void handleMouseWheel(int delta) {
         renderer.handleMouseWheel(delta);
+        recorder.logCamera(renderer.getCameraAngleX(), renderer.getCameraAngleY(), renderer.getCameraDistance());
     }
     
-    // Render 3D cube and 2D UI overlay
-    void render(sf::RenderWindow& window) {
-        // Render 3D cube using OpenGL
-        renderer.render(cube, window.getSize().x, window.getSize().y, animation);
+#ifdef RUBIK_ENABLE_PROFILER
+    // Frame-time graph (last 240 frames, p50/p99 guides) and per-frame counters
+    void drawProfilerOverlay(sf::RenderTarget& window) {
+        PROFILE_SCOPE("RubikGame::drawProfilerOverlay");
+        Profiler& profiler = Profiler::instance();
+        FrameStats stats = profiler.getStats();
+        std::vector<float> history = profiler.getFrameHistory();
         
-        // Switch to SFML 2D rendering for UI text
-        window.pushGLStates();
+        const float graphWidth = 480.0f;
+        const float graphHeight = 120.0f;
+        const float scaleMs = 33.3f; // Top of graph = two 60 Hz frames
+        float left = window.getSize().x - graphWidth - 10.0f;
+        float bottom = graphHeight + 10.0f;
         
-        if (font.getInfo().family != "") {
-            window.draw(statusText);
-            if (showInstructions) {
-                window.draw(instructionText);
-            }
+        sf::RectangleShape background(sf::Vector2f(graphWidth, graphHeight));
+        background.setPosition(left, bottom - graphHeight);
+        background.setFillColor(sf::Color(0, 0, 0, 160));
+        window.draw(background);
+        
+        auto toY = [&](float ms) { return bottom - std::min(ms / scaleMs, 1.0f) * graphHeight; };
+        sf::VertexArray guides(sf::Lines, 4);
+        guides[0] = sf::Vertex(sf::Vector2f(left, toY(stats.p50Ms)), sf::Color::Green);
+        guides[1] = sf::Vertex(sf::Vector2f(left + graphWidth, toY(stats.p50Ms)), sf::Color::Green);
+        guides[2] = sf::Vertex(sf::Vector2f(left, toY(stats.p99Ms)), sf::Color::Red);
+        guides[3] = sf::Vertex(sf::Vector2f(left + graphWidth, toY(stats.p99Ms)), sf::Color::Red);
+        window.draw(guides);
+        
+        sf::VertexArray graph(sf::LineStrip, history.size());
+        for (size_t i = 0; i < history.size(); i++) {
+            float x = left + graphWidth * i / 240.0f;
+            graph[i] = sf::Vertex(sf::Vector2f(x, toY(history[i])), sf::Color::White);
         }
+        window.draw(graph);
         
-        window.popGLStates();
-        window.display();
+        std::ostringstream text;
+        text << std::fixed << std::setprecision(2)
+             << "Frame p50 " << stats.p50Ms << " ms  p99 " << stats.p99Ms << " ms\n"
+             << "Draw calls " << stats.counters[COUNTER_DRAW_CALLS]
+             << "  Vertices " << stats.counters[COUNTER_VERTICES] << "\n"
+             << std::setprecision(1) << "Moves/sec " << stats.movesPerSecond << "\n"
+             << "First frame " << firstFrameMs << " ms";
+        if (showWall) {
+            const WallView& visible = renderer.getWallView();
+            text << "\nWall " << visible.detailed.size() << " detailed  " << visible.distant.size()
+                 << " boxes  " << visible.culled << " culled";
+        }
+        profilerText.setString(text.str());
+        profilerText.setPosition(left, bottom + 5.0f);
+        window.draw(profilerText);
+    }
+#endif
+    
+    // Render 3D cube and 2D UI overlay; the caller presents the frame
+    void render(sf::RenderTarget& window) {
+        PROFILE_SCOPE("RubikGame::render");
+        // Render 3D cube (or the wall) using OpenGL
+        if (showWall) {
+            renderer.renderWall(*wall, window.getSize().x, window.getSize().y);
+        } else {
+            renderer.render(cube, window.getSize().x, window.getSize().y, animation);
+        }
+        
+        // Switch to SFML 2D rendering for UI text
+        {
+            PROFILE_SCOPE("RubikGame::drawText");
+            window.pushGLStates();
+            
+            if (font.getInfo().family != "") {
+                window.draw(statusText);
+                if (showInstructions) {
+                    window.draw(instructionText);
+                }
+#ifdef RUBIK_ENABLE_PROFILER
+                if (showProfiler) {
+                    drawProfilerOverlay(window);
+                }
+#endif
+            }
+            
+            window.popGLStates();
+        }
     }
 };
 
+// Parse --record <file>, --replay <file>, --fast, --lldb <file>, --solver [socket], --wall [cubes],
+// --seed <n>, --headless <script>, --report <file> and --save-frame <image>
+static bool parseOptions(int argc, char* argv[], GameOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            options.recordPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            options.replayPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--fast") == 0) {
+            options.replayUnlimited = true;
+        } else if (std::strcmp(argv[i], "--lldb") == 0 && i + 1 < argc) {
+            options.lastLayerPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--solver") == 0) {
+            // Socket path is optional
+            options.solverSocket = (i + 1 < argc && argv[i + 1][0] != '-') ? argv[++i] : DEFAULT_SOLVER_SOCKET;
+        } else if (std::strcmp(argv[i], "--wall") == 0) {
+            // Cube count is optional
+            options.wallCubes = (i + 1 < argc && argv[i + 1][0] != '-') ? std::atoi(argv[++i]) : DEFAULT_WALL_CUBES;
+            if (options.wallCubes <= 0) options.wallCubes = DEFAULT_WALL_CUBES;
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            options.seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--headless") == 0 && i + 1 < argc) {
+            options.headlessScript = argv[++i];
+        } else if (std::strcmp(argv[i], "--report") == 0 && i + 1 < argc) {
+            options.reportPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--save-frame") == 0 && i + 1 < argc) {
+            options.framePath = argv[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--record <log>] [--replay <log> [--fast]] [--lldb <db>]"
+                      << " [--solver [socket]] [--wall [cubes]] [--seed <n>]\n"
+                      << "       [--headless <script> [--report <json>] [--save-frame <png>]]" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+static double millisecondsBetween(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to) {
+    return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+// Deterministic run for regression tests: the script drives the input handlers, every frame
+// advances a virtual clock by 1/60 s, and frames go to an offscreen target as fast as they
+// render (no window, so no VSync or frame limit). Recording is off, scrambles use --seed
+// (default 1), and each frame waits for the distance estimate so the UI text, and with it
+// the image, does not depend on thread timing. The state checksum is exact everywhere; the
+// image checksum also depends on the GL driver, so compare it on the same CI image.
+static int runHeadless(GameOptions options, const sf::ContextSettings& settings) {
+    std::vector<ScriptCommand> commands;
+    std::string error;
+    if (!loadHeadlessScript(options.headlessScript, commands, error)) {
+        std::cerr << "Error: Script " << error << std::endl;
+        return 1;
+    }
+    options.recordPath.clear();
+    if (options.seed == 0) options.seed = 1;
+    
+    sf::RenderTexture target;
+    if (!target.create(WINDOW_WIDTH, WINDOW_HEIGHT, settings)) {
+        std::cerr << "Error: Could not create a " << WINDOW_WIDTH << "x" << WINDOW_HEIGHT << " offscreen target" << std::endl;
+        return 1;
+    }
+    target.setActive(true);
+    
+    RubikGame game(options);
+    HeadlessReport report;
+    report.script = options.headlessScript;
+    std::size_t next = 0;
+    int framesLeft = 0;
+    bool waitIdle = false;
+    bool scriptDone = false;
+    std::uint64_t idleFrames = 0;
+    auto runStart = std::chrono::steady_clock::now();
+    
+    while (true) {
+        PROFILE_FRAME_BEGIN();
+        auto inputStart = std::chrono::steady_clock::now();
+        // Deliver input up to the next frames / idle command; the end of the script is an idle
+        while (framesLeft == 0 && !waitIdle && !scriptDone) {
+            if (next == commands.size()) {
+                waitIdle = true;
+                scriptDone = true;
+                break;
+            }
+            const ScriptCommand& command = commands[next++];
+            switch (command.type) {
+                case SCRIPT_KEY: game.handleKeyPress(command.key, command.shift); break;
+                case SCRIPT_PRESS: game.handleMouseButtonPressed(sf::Vector2i(command.x, command.y)); break;
+                case SCRIPT_MOVE: game.handleMouseMove(sf::Vector2i(command.x, command.y)); break;
+                case SCRIPT_RELEASE: game.handleMouseButtonReleased(); break;
+                case SCRIPT_WHEEL: game.handleMouseWheel(command.x); break;
+                case SCRIPT_FRAMES: framesLeft = command.count; break;
+                case SCRIPT_IDLE: waitIdle = true; break;
+            }
+        }
+        
+        auto updateStart = std::chrono::steady_clock::now();
+        game.updateReplay(VIRTUAL_FRAME_SECONDS);
+        game.updateAnimation(VIRTUAL_FRAME_SECONDS);
+        game.updateMoveQueue();
+        game.updateWall(VIRTUAL_FRAME_SECONDS);
+        game.updateResources();
+        auto estimateStart = std::chrono::steady_clock::now();
+        game.waitForEstimate();
+        auto renderStart = std::chrono::steady_clock::now();
+        game.render(target);
+        auto finishStart = std::chrono::steady_clock::now();
+        target.display();
+        glFinish();
+        auto frameEnd = std::chrono::steady_clock::now();
+        PROFILE_FRAME_END();
+        
+        report.phaseMs[PHASE_INPUT].push_back(static_cast<float>(millisecondsBetween(inputStart, updateStart)));
+        report.phaseMs[PHASE_UPDATE].push_back(static_cast<float>(millisecondsBetween(updateStart, estimateStart)));
+        report.phaseMs[PHASE_ESTIMATE].push_back(static_cast<float>(millisecondsBetween(estimateStart, renderStart)));
+        report.phaseMs[PHASE_RENDER].push_back(static_cast<float>(millisecondsBetween(renderStart, finishStart)));
+        report.phaseMs[PHASE_FINISH].push_back(static_cast<float>(millisecondsBetween(finishStart, frameEnd)));
+        report.frames++;
+        
+        if (framesLeft > 0) framesLeft--;
+        if (waitIdle) {
+            if (game.isIdle()) {
+                waitIdle = false;
+                idleFrames = 0;
+                if (scriptDone) break;
+            } else if (++idleFrames > HEADLESS_MAX_IDLE_FRAMES) {
+                std::cerr << "Error: Still busy after " << HEADLESS_MAX_IDLE_FRAMES << " frames of idle" << std::endl;
+                return 1;
+            }
+        }
+    }
+    
+    report.wallSeconds = millisecondsBetween(runStart, std::chrono::steady_clock::now()) / 1000.0;
+    report.virtualSeconds = report.frames * static_cast<double>(VIRTUAL_FRAME_SECONDS);
+    report.moves = game.getMovesApplied();
+    report.solved = game.getCube().isSolved();
+    report.stateChecksum = stateChecksum(game.getCube());
+    sf::Image frame = target.getTexture().copyToImage();
+    report.imageChecksum = imageChecksum(frame);
+    report.width = frame.getSize().x;
+    report.height = frame.getSize().y;
+    
+    printHeadlessSummary(report);
+    if (!options.framePath.empty() && !frame.saveToFile(options.framePath)) {
+        std::cerr << "Warning: Could not save the final frame to " << options.framePath << std::endl;
+    }
+    if (!writeHeadlessReport(options.reportPath, report)) {
+        std::cerr << "Error: Could not write " << options.reportPath << std::endl;
+        return 1;
+    }
+    std::cout << "Report written to " << options.reportPath << std::endl;
+    return 0;
+}
+
 // Main entry point - initializes window and runs game loop
-int main() {
+int main(int argc, char* argv[]) {
+    GameOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+    options.executablePath = argv[0];
+    
     // Configure OpenGL settings
     sf::ContextSettings settings;
     settings.depthBits = 24;
     settings.stencilBits = 8;
     settings.antialiasingLevel = 4;
-    settings.majorVersion = 2;
-    settings.minorVersion = 1;
+    // GL 3.3 for the shader renderer; compatibility profile (no Core flag)
+    // because SFML's text overlay still uses the fixed-function pipeline
+    settings.majorVersion = 3;
+    settings.minorVersion = 3;
+    
+    if (!options.headlessScript.empty()) {
+        return runHeadless(options, settings);
+    }
     
     // In game, create SFML window with OpenGL context.
     sf::RenderWindow window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), 
@@ -252,40 +904,67 @@ int main() {
     window.setVerticalSyncEnabled(true);
     window.setActive(true);
     
-    RubikGame game;
+    double windowMs = millisecondsSinceStart();
+    
+    RubikGame game(options);
+    double setupMs = millisecondsSinceStart();
+    bool firstFrame = true;
     sf::Clock frameClock;
     
     // Main game loop - handle events and render
     while (window.isOpen()) {
+        PROFILE_FRAME_BEGIN();
         float deltaTime = frameClock.restart().asSeconds();
         
-        sf::Event event;
-        while (window.pollEvent(event)) {
-            if (event.type == sf::Event::Closed) {
-                window.close();
-            } else if (event.type == sf::Event::KeyPressed) {
-                game.handleKeyPress(event.key.code);
-            } else if (event.type == sf::Event::MouseButtonPressed) {
-                if (event.mouseButton.button == sf::Mouse::Left) {
-                    game.handleMouseButtonPressed(sf::Vector2i(event.mouseButton.x, event.mouseButton.y));
-                }
-            } else if (event.type == sf::Event::MouseButtonReleased) {
-                if (event.mouseButton.button == sf::Mouse::Left) {
-                    game.handleMouseButtonReleased();
+        // Handle input events
+        {
+            PROFILE_SCOPE("Events");
+            sf::Event event;
+            while (window.pollEvent(event)) {
+                if (event.type == sf::Event::Closed) {
+                    window.close();
+                } else if (event.type == sf::Event::KeyPressed) {
+                    game.handleKeyPress(event.key.code, event.key.shift);
+                } else if (event.type == sf::Event::MouseButtonPressed) {
+                    if (event.mouseButton.button == sf::Mouse::Left) {
+                        game.handleMouseButtonPressed(sf::Vector2i(event.mouseButton.x, event.mouseButton.y));
+                    }
+                } else if (event.type == sf::Event::MouseButtonReleased) {
+                    if (event.mouseButton.button == sf::Mouse::Left) {
+                        game.handleMouseButtonReleased();
+                    }
+                } else if (event.type == sf::Event::MouseMoved) {
+                    game.handleMouseMove(sf::Vector2i(event.mouseMove.x, event.mouseMove.y));
+                } else if (event.type == sf::Event::MouseWheelScrolled) {
+                    game.handleMouseWheel(static_cast<int>(event.mouseWheelScroll.delta));
+                } else if (event.type == sf::Event::Resized) {
+                    glViewport(0, 0, event.size.width, event.size.height);
                 }
-            } else if (event.type == sf::Event::MouseMoved) {
-                game.handleMouseMove(sf::Vector2i(event.mouseMove.x, event.mouseMove.y));
-            } else if (event.type == sf::Event::MouseWheelScrolled) {
-                game.handleMouseWheel(static_cast<int>(event.mouseWheelScroll.delta));
-            } else if (event.type == sf::Event::Resized) {
-                glViewport(0, 0, event.size.width, event.size.height);
             }
         }
         
-        // Update animation
+        // Feed replayed events, then update animation and start the next queued turn
+        game.updateReplay(deltaTime);
         game.updateAnimation(deltaTime);
+        game.updateMoveQueue();
+        game.updateWall(deltaTime);
+        game.updateEstimate();
+        game.updateResources();
         
         game.render(window);
+        {
+            PROFILE_SCOPE("Display");
+            window.display();
+        }
+        if (firstFrame) {
+            firstFrame = false;
+            double firstFrameMs = millisecondsSinceStart();
+            game.setFirstFrameTime(firstFrameMs);
+            std::cout << "Time to first frame: " << firstFrameMs << " ms (window " << windowMs
+                      << " ms, game setup " << setupMs - windowMs << " ms, first render "
+                      << firstFrameMs - setupMs << " ms)" << std::endl;
+        }
+        PROFILE_FRAME_END();
     }
     
     return 0;
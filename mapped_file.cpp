@@ -0,0 +1,95 @@
+// Memory-Mapped File Implementation
+// Platform-specific mapping code
+
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+MappedFile::MappedFile() : bytes(nullptr), length(0), opened(false), fileHandle(nullptr), mappingHandle(nullptr) {}
+#else
+MappedFile::MappedFile() : bytes(nullptr), length(0), opened(false), descriptor(-1) {}
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+// Map the whole file read-only
+bool MappedFile::open(const std::string& path) {
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    length = static_cast<std::size_t>(fileSize.QuadPart);
+    opened = true;
+    if (length == 0) return true;
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        close();
+        return false;
+    }
+    mappingHandle = mapping;
+    bytes = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+    descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) return false;
+    struct stat info;
+    if (fstat(descriptor, &info) != 0) {
+        close();
+        return false;
+    }
+    length = static_cast<std::size_t>(info.st_size);
+    opened = true;
+    if (length == 0) return true;
+
+    void* address = mmap(nullptr, length, PROT_READ, MAP_SHARED, descriptor, 0);
+    if (address == MAP_FAILED) {
+        close();
+        return false;
+    }
+    // Scans are mostly front-to-back
+    madvise(address, length, MADV_SEQUENTIAL);
+    bytes = static_cast<const unsigned char*>(address);
+#endif
+    if (!bytes) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+// Release the mapping and file handle
+void MappedFile::close() {
+#ifdef _WIN32
+    if (bytes) UnmapViewOfFile(bytes);
+    if (mappingHandle) CloseHandle(static_cast<HANDLE>(mappingHandle));
+    if (fileHandle) CloseHandle(static_cast<HANDLE>(fileHandle));
+    fileHandle = nullptr;
+    mappingHandle = nullptr;
+#else
+    if (bytes) munmap(const_cast<unsigned char*>(bytes), length);
+    if (descriptor >= 0) ::close(descriptor);
+    descriptor = -1;
+#endif
+    bytes = nullptr;
+    length = 0;
+    opened = false;
+}
@@ -0,0 +1,38 @@
+// Memory-Mapped File Header
+// Read-only file mapping for logs and data files (POSIX mmap / Win32 views)
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+// Read-only mapping of a whole file; the mapping is released on close or destruction
+class MappedFile {
+private:
+    const unsigned char* bytes;
+    std::size_t length;
+    bool opened;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#else
+    int descriptor;
+#endif
+
+public:
+    MappedFile();
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Map the file; returns false if it cannot be opened (empty files map to size 0)
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return opened; }
+    const unsigned char* data() const { return bytes; }
+    std::size_t size() const { return length; }
+};
+
+#endif // MAPPED_FILE_H
@@ -0,0 +1,193 @@
+// Move Sequence Implementation
+// Same-axis merging, canonical ordering and optimal-window replacement
+
+#include "move_sequence.h"
+#include "profiler.h"
+#include <sstream>
+
+namespace {
+
+// States within each depth of solved (cumulative), used to size the table
+const std::size_t STATES_WITHIN_DEPTH[] = {1, 19, 262, 3502, 46741, 621649, 8240087};
+
+int moveFace(int move) { return move / 3; }
+int moveAxis(int move) { return move / 6; }
+int moveTurns(int move) { return move % 3 + 1; }
+
+// Canonical successor rule: no face twice in a row, opposite faces only in ascending order
+bool allowedAfter(int previous, int move) {
+    if (previous < 0) return true;
+    if (moveFace(previous) == moveFace(move)) return false;
+    return !(moveAxis(previous) == moveAxis(move) && moveFace(move) < moveFace(previous));
+}
+
+std::uint64_t tableKey(const CubieCube& state) {
+    std::uint64_t key = state.hash();
+    return key ? key : 1;
+}
+
+} // namespace
+
+bool parseSequence(const std::string& text, std::vector<int>& moves) {
+    moves.clear();
+    std::istringstream stream(text);
+    std::string token;
+    while (stream >> token) {
+        int move = parseMove(token);
+        if (move < 0) return false;
+        moves.push_back(move);
+    }
+    return true;
+}
+
+std::string sequenceToString(const std::vector<int>& moves) {
+    std::string text;
+    for (int move : moves) {
+        if (!text.empty()) text += ' ';
+        text += moveToString(move);
+    }
+    return text;
+}
+
+SequenceTable::SequenceTable() : mask(0), entries(0), depth(0) {}
+
+// Open addressing with linear probing; duplicate keys keep the first (shallowest) sequence
+bool SequenceTable::insert(std::uint64_t key, std::uint32_t value) {
+    for (std::uint64_t slot = key & mask;; slot = (slot + 1) & mask) {
+        if (keys[slot] == key) return false;
+        if (keys[slot] == 0) {
+            keys[slot] = key;
+            values[slot] = value;
+            entries++;
+            return true;
+        }
+    }
+}
+
+void SequenceTable::build(int maxDepth) {
+    PROFILE_SCOPE("SequenceTable::build");
+    depth = maxDepth < 0 ? 0 : (maxDepth > MAX_DEPTH ? MAX_DEPTH : maxDepth);
+
+    std::size_t slots = 1;
+    while (slots < 2 * STATES_WITHIN_DEPTH[depth]) slots <<= 1;
+    keys.assign(slots, 0);
+    values.assign(slots, 0);
+    mask = slots - 1;
+    entries = 0;
+
+    struct Node {
+        CubieCube state;
+        std::uint32_t packed;
+        int last;
+    };
+    std::vector<Node> frontier(1, Node{CubieCube(), 0, -1}), next;
+    insert(tableKey(CubieCube()), 0);
+
+    for (int d = 0; d < depth; d++) {
+        next.clear();
+        for (const Node& node : frontier) {
+            for (int move = 0; move < NUM_MOVES; move++) {
+                if (!allowedAfter(node.last, move)) continue;
+                Node child{node.state, node.packed | static_cast<std::uint32_t>(move + 1) << (5 * d), move};
+                child.state.multiply(moveCube(move));
+                // The last level only needs inserting, not expanding
+                if (insert(tableKey(child.state), child.packed) && d + 1 < depth) {
+                    next.push_back(child);
+                }
+            }
+        }
+        frontier.swap(next);
+    }
+}
+
+// Unpack the candidate and confirm it really reaches `state` (guards against hash collisions)
+bool SequenceTable::lookup(const CubieCube& state, std::vector<int>& moves) const {
+    if (keys.empty()) return false;
+    std::uint64_t key = tableKey(state);
+    for (std::uint64_t slot = key & mask; keys[slot] != 0; slot = (slot + 1) & mask) {
+        if (keys[slot] != key) continue;
+        moves.clear();
+        CubieCube check;
+        for (std::uint32_t packed = values[slot]; packed; packed >>= 5) {
+            moves.push_back(static_cast<int>(packed & 31) - 1);
+            check.multiply(moveCube(moves.back()));
+        }
+        return check == state;
+    }
+    return false;
+}
+
+SequenceCanonicalizer::SequenceCanonicalizer() : table(nullptr), maxWindow(0) {}
+
+void SequenceCanonicalizer::setTable(const SequenceTable* sequenceTable, int window) {
+    table = sequenceTable;
+    maxWindow = 0;
+    if (table) maxWindow = window > 0 ? window : 2 * table->maxDepth();
+}
+
+// Merge into the tail group (the last one or two moves on the incoming move's axis)
+void SequenceCanonicalizer::merge(int move) {
+    std::size_t n = output.size();
+    int face = moveFace(move);
+    std::size_t target = n;
+    if (n >= 1 && moveFace(output[n - 1]) == face) {
+        target = n - 1;
+    } else if (n >= 2 && moveAxis(output[n - 1]) == moveAxis(move) && moveFace(output[n - 2]) == face) {
+        target = n - 2;
+    }
+
+    if (target < n) {
+        int turns = (moveTurns(output[target]) + moveTurns(move)) % 4;
+        if (turns == 0) {
+            output.erase(output.begin() + static_cast<std::ptrdiff_t>(target));
+        } else {
+            output[target] = face * 3 + turns - 1;
+        }
+    } else if (n >= 1 && moveAxis(output[n - 1]) == moveAxis(move) && face < moveFace(output[n - 1])) {
+        output.insert(output.end() - 1, move);
+    } else {
+        output.push_back(move);
+    }
+}
+
+// Walk windows ending at the tail, growing backwards; replace the first one that has a shorter form
+bool SequenceCanonicalizer::shortenTail() {
+    std::size_t n = output.size();
+    std::size_t limit = static_cast<std::size_t>(maxWindow) < n ? static_cast<std::size_t>(maxWindow) : n;
+    CubieCube window;
+    for (std::size_t length = 1; length <= limit; length++) {
+        // Prepend one move: window = move * window
+        CubieCube state = moveCube(output[n - length]);
+        state.multiply(window);
+        window = state;
+        if (length < 2 || !table->lookup(window, replacement) || replacement.size() >= length) continue;
+
+        output.resize(n - length);
+        // Re-merge the shorter form so it can cancel into what precedes it
+        for (auto it = replacement.rbegin(); it != replacement.rend(); ++it) pending.push_back(*it);
+        return true;
+    }
+    return false;
+}
+
+void SequenceCanonicalizer::push(int move) {
+    if (move < 0 || move >= NUM_MOVES) return;
+    pending.push_back(move);
+    while (!pending.empty()) {
+        int next = pending.back();
+        pending.pop_back();
+        merge(next);
+        if (table && pending.empty()) shortenTail();
+    }
+}
+
+void SequenceCanonicalizer::push(const std::vector<int>& moves) {
+    for (int move : moves) push(move);
+}
+
+std::vector<int> canonicalizeSequence(const std::vector<int>& moves, const SequenceTable* table) {
+    SequenceCanonicalizer canonicalizer;
+    canonicalizer.setTable(table);
+    canonicalizer.push(moves);
+    return canonicalizer.moves();
+}
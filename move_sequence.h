@@ -0,0 +1,80 @@
+// Move Sequence Header
+// Parsing, canonical simplification and table-driven shortening of move sequences
+
+#ifndef MOVE_SEQUENCE_H
+#define MOVE_SEQUENCE_H
+
+#include "cubie_cube.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// "R U R' U2" -> move indices; returns false on an unknown token
+bool parseSequence(const std::string& text, std::vector<int>& moves);
+
+// Move indices -> space separated notation
+std::string sequenceToString(const std::vector<int>& moves);
+
+// Optimal sequences for every state within maxDepth moves of solved, keyed by state hash.
+// Depth 5 holds ~620k states (~25 MB), depth 6 ~8.2M states (~200 MB).
+class SequenceTable {
+private:
+    static constexpr int MAX_DEPTH = 6;
+
+    std::vector<std::uint64_t> keys;    // State hash, 0 = empty slot
+    std::vector<std::uint32_t> values;  // Up to 6 moves, 5 bits each as move + 1
+    std::uint64_t mask;
+    std::size_t entries;
+    int depth;
+
+    bool insert(std::uint64_t key, std::uint32_t value);
+
+public:
+    SequenceTable();
+
+    // BFS from solved over canonical sequences (first visit is optimal)
+    void build(int maxDepth);
+
+    int maxDepth() const { return depth; }
+    std::size_t size() const { return entries; }
+
+    // Optimal sequence reaching `state` from solved; false if it is deeper than maxDepth
+    bool lookup(const CubieCube& state, std::vector<int>& moves) const;
+};
+
+// Streaming canonicalizer - feed moves one at a time, read the simplified sequence at any point.
+// Same-face runs merge (R R -> R2, U2 U' -> U, R R' -> nothing), commuting opposite faces
+// are kept in R-before-L / U-before-D / F-before-B order and merge across each other (R L R' -> L).
+// With a table, the tail is also checked after every move and any window that is longer than
+// the optimal sequence for its state is replaced. Each move costs O(window) work, so a
+// stream runs in linear time; clear() keeps the buffers for reuse.
+class SequenceCanonicalizer {
+private:
+    std::vector<int> output;
+    std::vector<int> pending;
+    std::vector<int> replacement;
+    const SequenceTable* table;
+    int maxWindow;
+
+    void merge(int move);
+    bool shortenTail();
+
+public:
+    SequenceCanonicalizer();
+
+    // Enable table shortening of windows up to `window` moves (0 = twice the table depth)
+    void setTable(const SequenceTable* sequenceTable, int window = 0);
+
+    void push(int move);
+    void push(const std::vector<int>& moves);
+
+    const std::vector<int>& moves() const { return output; }
+    std::size_t size() const { return output.size(); }
+    void clear() { output.clear(); }
+};
+
+// One-shot helper
+std::vector<int> canonicalizeSequence(const std::vector<int>& moves, const SequenceTable* table = nullptr);
+
+#endif // MOVE_SEQUENCE_H
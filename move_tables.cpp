@@ -0,0 +1,370 @@
+// Move Tables Implementation
+// constexpr generation from the sticker geometry, plus static_asserts on the results
+
+#include "move_tables.h"
+
+namespace {
+
+// Grid position and outward normal of every facelet, from the renderer mapping
+struct Geometry {
+    int position[NUM_FACELETS][3];
+    int normal[NUM_FACELETS][3];
+};
+
+constexpr Geometry buildGeometry() {
+    Geometry geometry{};
+    for (int x = -1; x <= 1; x++) {
+        for (int y = -1; y <= 1; y++) {
+            for (int z = -1; z <= 1; z++) {
+                for (int face = 0; face < 6; face++) {
+                    const int position[3] = {x, y, z};
+                    int sign = face % 2 == 0 ? 1 : -1;
+                    if (position[face / 2] != sign) continue;
+                    int i = faceletIndex(cubieSticker(x, y, z, face));
+                    for (int k = 0; k < 3; k++) {
+                        geometry.position[i][k] = position[k];
+                        geometry.normal[i][k] = k == face / 2 ? sign : 0;
+                    }
+                }
+            }
+        }
+    }
+    return geometry;
+}
+
+constexpr Geometry GEOMETRY = buildGeometry();
+
+constexpr int faceOfNormal(const int* normal) {
+    for (int face = 0; face < 6; face++) {
+        if (normal[face / 2] == (face % 2 == 0 ? 1 : -1)) return face;
+    }
+    return -1;
+}
+
+constexpr int faceletAt(const int* position, const int* normal) {
+    return faceletIndex(cubieSticker(position[0], position[1], position[2], faceOfNormal(normal)));
+}
+
+// Right-handed +90 degrees about an axis
+constexpr void rotateQuarter(int* v, int axis) {
+    int x = v[0], y = v[1], z = v[2];
+    if (axis == 0) { v[1] = -z; v[2] = y; }
+    else if (axis == 1) { v[0] = z; v[2] = -x; }
+    else { v[0] = -y; v[1] = x; }
+}
+
+constexpr void transform(const std::int8_t (&m)[3][3], const int* v, int* out) {
+    for (int r = 0; r < 3; r++) out[r] = m[r][0] * v[0] + m[r][1] * v[1] + m[r][2] * v[2];
+}
+
+constexpr int determinant(const std::int8_t (&m)[3][3]) {
+    return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1]) -
+           m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0]) +
+           m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+}
+
+// A turn moves the stickers of one layer exactly as the renderer animates it
+constexpr FaceletPermutation moveFacelets(int move) {
+    int face = move / 3;
+    int axis = face / 2;
+    int layer = face % 2 == 0 ? 1 : -1;
+    int quarters = ((sliceTurnSign(face) * (move % 3 + 1)) % 4 + 4) % 4;
+    FaceletPermutation result{};
+    for (int i = 0; i < NUM_FACELETS; i++) {
+        int position[3] = {GEOMETRY.position[i][0], GEOMETRY.position[i][1], GEOMETRY.position[i][2]};
+        int normal[3] = {GEOMETRY.normal[i][0], GEOMETRY.normal[i][1], GEOMETRY.normal[i][2]};
+        if (position[axis] == layer) {
+            for (int q = 0; q < quarters; q++) {
+                rotateQuarter(position, axis);
+                rotateQuarter(normal, axis);
+            }
+        }
+        result.from[faceletAt(position, normal)] = static_cast<std::uint8_t>(i);
+    }
+    return result;
+}
+
+// Which cubie (and which of its stickers) every position shows, as CubieCube::fromFacelets reads it
+constexpr CubieCube cubieFromFacelets(const FaceletPermutation& permutation) {
+    CubieCube cube;
+    for (int i = 0; i < 8; i++) {
+        for (int n = 0; n < 3; n++) {
+            int source = permutation.from[faceletIndex(CORNER_FACELETS[i][n])];
+            for (int j = 0; j < 8; j++) {
+                if (faceletIndex(CORNER_FACELETS[j][0]) == source) {
+                    cube.cp[i] = static_cast<std::uint8_t>(j);
+                    cube.co[i] = static_cast<std::uint8_t>(n);  // Twist = which sticker shows U/D
+                }
+            }
+        }
+    }
+    for (int i = 0; i < 12; i++) {
+        int source = permutation.from[faceletIndex(EDGE_FACELETS[i][0])];
+        for (int j = 0; j < 12; j++) {
+            for (int k = 0; k < 2; k++) {
+                if (faceletIndex(EDGE_FACELETS[j][k]) == source) {
+                    cube.ep[i] = static_cast<std::uint8_t>(j);
+                    cube.eo[i] = static_cast<std::uint8_t>(k);
+                }
+            }
+        }
+    }
+    return cube;
+}
+
+constexpr bool sameMatrix(const std::int8_t (&a)[3][3], const std::int8_t (&b)[3][3]) {
+    for (int r = 0; r < 3; r++) {
+        for (int c = 0; c < 3; c++) {
+            if (a[r][c] != b[r][c]) return false;
+        }
+    }
+    return true;
+}
+
+constexpr int findSymmetry(const MoveTables& tables, const std::int8_t (&m)[3][3]) {
+    for (int s = 0; s < NUM_SYMMETRIES; s++) {
+        if (sameMatrix(tables.symmetryMatrix[s], m)) return s;
+    }
+    return -1;
+}
+
+// Symmetry 8p + b: axis permutation p, bit k of b negates row k
+constexpr void buildSymmetries(MoveTables& tables) {
+    const int PERMUTATIONS[6][3] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+    for (int s = 0; s < NUM_SYMMETRIES; s++) {
+        for (int r = 0; r < 3; r++) {
+            for (int c = 0; c < 3; c++) tables.symmetryMatrix[s][r][c] = 0;
+            tables.symmetryMatrix[s][r][PERMUTATIONS[s / 8][r]] = static_cast<std::int8_t>((s >> r) & 1 ? -1 : 1);
+        }
+    }
+
+    for (int s = 0; s < NUM_SYMMETRIES; s++) {
+        const std::int8_t (&m)[3][3] = tables.symmetryMatrix[s];
+        for (int i = 0; i < NUM_FACELETS; i++) {
+            int position[3] = {}, normal[3] = {};
+            transform(m, GEOMETRY.position[i], position);
+            transform(m, GEOMETRY.normal[i], normal);
+            tables.symmetryFacelets[s].from[faceletAt(position, normal)] = static_cast<std::uint8_t>(i);
+        }
+        for (int face = 0; face < 6; face++) {
+            int normal[3] = {}, image[3] = {};
+            normal[face / 2] = face % 2 == 0 ? 1 : -1;
+            transform(m, normal, image);
+            tables.symmetryFace[s][face] = static_cast<std::uint8_t>(faceOfNormal(image));
+        }
+        std::int8_t transpose[3][3] = {};
+        for (int r = 0; r < 3; r++) {
+            for (int c = 0; c < 3; c++) transpose[r][c] = m[c][r];
+        }
+        tables.symmetryInverse[s] = static_cast<std::uint8_t>(findSymmetry(tables, transpose));
+
+        for (int other = 0; other < NUM_SYMMETRIES; other++) {
+            const std::int8_t (&b)[3][3] = tables.symmetryMatrix[other];
+            std::int8_t product[3][3] = {};
+            for (int r = 0; r < 3; r++) {
+                for (int c = 0; c < 3; c++) {
+                    product[r][c] = static_cast<std::int8_t>(m[r][0] * b[0][c] + m[r][1] * b[1][c] + m[r][2] * b[2][c]);
+                }
+            }
+            tables.symmetryMultiply[s][other] = static_cast<std::uint8_t>(findSymmetry(tables, product));
+        }
+
+        // A reflection turns a clockwise turn into a counter-clockwise one
+        bool reflection = determinant(m) < 0;
+        for (int move = 0; move < NUM_MOVES; move++) {
+            int turn = reflection ? 2 - move % 3 : move % 3;
+            tables.conjugateMove[s][move] = static_cast<std::uint8_t>(tables.symmetryFace[s][move / 3] * 3 + turn);
+        }
+    }
+}
+
+// Same ranks as CubieCube::cornerOrientation / edgeOrientation and their setters
+struct TwistTable {
+    std::uint16_t next[CORNER_ORIENTATIONS * NUM_MOVES];
+};
+
+struct FlipTable {
+    std::uint16_t next[EDGE_ORIENTATIONS * NUM_MOVES];
+};
+
+constexpr TwistTable buildTwistTable(const CubieCube* moveCubes) {
+    TwistTable table{};
+    for (int twist = 0; twist < CORNER_ORIENTATIONS; twist++) {
+        int co[8] = {};
+        int rank = twist, sum = 0;
+        for (int i = 6; i >= 0; i--) {
+            co[i] = rank % 3;
+            sum += co[i];
+            rank /= 3;
+        }
+        co[7] = (3 - sum % 3) % 3;
+        for (int move = 0; move < NUM_MOVES; move++) {
+            const CubieCube& m = moveCubes[move];
+            int next = 0;
+            for (int i = 0; i < 7; i++) next = next * 3 + (co[m.cp[i]] + m.co[i]) % 3;
+            table.next[twist * NUM_MOVES + move] = static_cast<std::uint16_t>(next);
+        }
+    }
+    return table;
+}
+
+constexpr FlipTable buildFlipTable(const CubieCube* moveCubes) {
+    FlipTable table{};
+    for (int flip = 0; flip < EDGE_ORIENTATIONS; flip++) {
+        int eo[12] = {};
+        int rank = flip, sum = 0;
+        for (int i = 10; i >= 0; i--) {
+            eo[i] = rank & 1;
+            sum += eo[i];
+            rank >>= 1;
+        }
+        eo[11] = sum & 1;
+        for (int move = 0; move < NUM_MOVES; move++) {
+            const CubieCube& m = moveCubes[move];
+            int next = 0;
+            for (int i = 0; i < 11; i++) next = next * 2 + (eo[m.ep[i]] ^ m.eo[i]);
+            table.next[flip * NUM_MOVES + move] = static_cast<std::uint16_t>(next);
+        }
+    }
+    return table;
+}
+
+// Each part is its own constant evaluation, which keeps every one within the compilers'
+// default constexpr step limits
+constexpr MoveTables buildMoves() {
+    MoveTables tables{};
+    for (int move = 0; move < NUM_MOVES; move++) {
+        tables.moveFacelets[move] = moveFacelets(move);
+        tables.moveCubes[move] = cubieFromFacelets(tables.moveFacelets[move]);
+    }
+    return tables;
+}
+
+constexpr MoveTables MOVES = buildMoves();
+constexpr TwistTable TWIST_TABLE = buildTwistTable(MOVES.moveCubes);
+constexpr FlipTable FLIP_TABLE = buildFlipTable(MOVES.moveCubes);
+
+constexpr MoveTables buildMoveTables() {
+    MoveTables tables = MOVES;
+    buildSymmetries(tables);
+    for (int i = 0; i < CORNER_ORIENTATIONS * NUM_MOVES; i++) tables.twistMove[i] = TWIST_TABLE.next[i];
+    for (int i = 0; i < EDGE_ORIENTATIONS * NUM_MOVES; i++) tables.flipMove[i] = FLIP_TABLE.next[i];
+    return tables;
+}
+
+} // namespace
+
+constexpr MoveTables MOVE_TABLES = buildMoveTables();
+
+namespace {
+
+constexpr FaceletPermutation identityFacelets() {
+    FaceletPermutation identity{};
+    for (int i = 0; i < NUM_FACELETS; i++) identity.from[i] = static_cast<std::uint8_t>(i);
+    return identity;
+}
+
+// X2 and X' are X applied twice and three times, X has order 4; centers never move
+constexpr bool movesFormTurns(const MoveTables& tables) {
+    for (int face = 0; face < 6; face++) {
+        const FaceletPermutation& quarter = tables.moveFacelets[face * 3];
+        FaceletPermutation half = compose(quarter, quarter);
+        FaceletPermutation threeQuarters = compose(half, quarter);
+        if (!(half == tables.moveFacelets[face * 3 + 1]) || !(threeQuarters == tables.moveFacelets[face * 3 + 2])) return false;
+        if (!(compose(threeQuarters, quarter) == identityFacelets())) return false;
+        for (int move = 0; move < NUM_MOVES; move++) {
+            if (tables.moveFacelets[move].from[face * 9 + 4] != face * 9 + 4) return false;
+        }
+    }
+    return true;
+}
+
+constexpr bool oppositeFacesCommute(const MoveTables& tables) {
+    for (int axis = 0; axis < 3; axis++) {
+        const FaceletPermutation& a = tables.moveFacelets[axis * 6];
+        const FaceletPermutation& b = tables.moveFacelets[axis * 6 + 3];
+        if (!(compose(a, b) == compose(b, a))) return false;
+    }
+    return true;
+}
+
+// Valid cubie states; only R/L/F/B twist corners and only F/B quarter turns flip edges
+constexpr bool moveCubesValid(const MoveTables& tables) {
+    for (int move = 0; move < NUM_MOVES; move++) {
+        const CubieCube& cube = tables.moveCubes[move];
+        int face = move / 3, corners = 0, edges = 0, twist = 0, flip = 0;
+        for (int i = 0; i < 8; i++) {
+            corners |= 1 << cube.cp[i];
+            twist += cube.co[i];
+        }
+        for (int i = 0; i < 12; i++) {
+            edges |= 1 << cube.ep[i];
+            flip += cube.eo[i];
+        }
+        if (corners != 0xFF || edges != 0xFFF || twist % 3 != 0 || flip % 2 != 0) return false;
+        if ((face == UP || face == DOWN) && twist != 0) return false;
+        bool flips = (face == FRONT || face == BACK) && move % 3 != 1;
+        if ((flip != 0) != flips) return false;
+    }
+    return true;
+}
+
+// 48 distinct maps, identity first, 24 reflections, products and inverses match composition
+constexpr bool symmetriesFormGroup(const MoveTables& tables) {
+    if (!(tables.symmetryFacelets[0] == identityFacelets())) return false;
+    int reflections = 0;
+    for (int a = 0; a < NUM_SYMMETRIES; a++) {
+        reflections += determinant(tables.symmetryMatrix[a]) < 0;
+        if (tables.symmetryMultiply[a][tables.symmetryInverse[a]] != 0) return false;
+        for (int b = 0; b < NUM_SYMMETRIES; b++) {
+            if (a != b && tables.symmetryFacelets[a] == tables.symmetryFacelets[b]) return false;
+            const FaceletPermutation& product = tables.symmetryFacelets[tables.symmetryMultiply[a][b]];
+            if (!(product == compose(tables.symmetryFacelets[b], tables.symmetryFacelets[a]))) return false;
+        }
+    }
+    return reflections == NUM_SYMMETRIES / 2;
+}
+
+// S^-1, move, S is the single move conjugateMove[S][move]
+constexpr bool conjugatesAreMoves(const MoveTables& tables) {
+    for (int s = 0; s < NUM_SYMMETRIES; s++) {
+        const FaceletPermutation& forward = tables.symmetryFacelets[s];
+        const FaceletPermutation& backward = tables.symmetryFacelets[tables.symmetryInverse[s]];
+        for (int move = 0; move < NUM_MOVES; move++) {
+            FaceletPermutation conjugate = compose(compose(backward, tables.moveFacelets[move]), forward);
+            if (!(conjugate == tables.moveFacelets[tables.conjugateMove[s][move]])) return false;
+        }
+    }
+    return true;
+}
+
+// Every quarter turn has order 4 on every coordinate; from solved, U/D keep the corners
+// untwisted and only F/B quarter turns flip edges
+constexpr bool coordinateTablesConsistent(const MoveTables& tables) {
+    for (int face = 0; face < 6; face++) {
+        int move = face * 3;
+        for (int twist = 0; twist < CORNER_ORIENTATIONS; twist++) {
+            int t = twist;
+            for (int q = 0; q < 4; q++) t = tables.twistMove[t * NUM_MOVES + move];
+            if (t != twist) return false;
+        }
+        for (int flip = 0; flip < EDGE_ORIENTATIONS; flip++) {
+            int f = flip;
+            for (int q = 0; q < 4; q++) f = tables.flipMove[f * NUM_MOVES + move];
+            if (f != flip) return false;
+        }
+        bool twists = face != UP && face != DOWN;
+        bool flips = face == FRONT || face == BACK;
+        if ((tables.twistMove[move] != 0) != twists || (tables.flipMove[move] != 0) != flips) return false;
+    }
+    return true;
+}
+
+static_assert(movesFormTurns(MOVE_TABLES), "half and inverse turns must be powers of the quarter turn");
+static_assert(oppositeFacesCommute(MOVE_TABLES), "opposite faces must commute");
+static_assert(moveCubesValid(MOVE_TABLES), "move cubes must be valid cube states");
+static_assert(symmetriesFormGroup(MOVE_TABLES), "symmetry tables must form the 48-element cube group");
+static_assert(conjugatesAreMoves(MOVE_TABLES), "conjugating a move by a symmetry must give a move");
+static_assert(coordinateTablesConsistent(MOVE_TABLES), "coordinate move tables must follow the turns");
+
+} // namespace
@@ -0,0 +1,92 @@
+// Move Tables Header
+// Move, symmetry and small coordinate tables computed at compile time
+//
+// Everything in MOVE_TABLES is produced by constexpr code from the sticker geometry
+// (cubieSticker and sliceTurnSign, which rubik_verify checks against RubikCube's hand-coded
+// rotations) and emitted as read-only data: nothing is built at startup. move_tables.cpp
+// static_asserts the group properties the rest of the code relies on.
+//
+// Facelets are numbered face * 9 + row * 3 + col. A FaceletPermutation is applied as
+// after[i] = before[from[i]]; applying a then b is compose(a, b).
+//
+// The 48 symmetries are the signed 3x3 permutation matrices acting on grid positions and
+// sticker normals (+X = RIGHT, +Y = UP, +Z = FRONT); symmetry 0 is the identity, 24 of them
+// are rotations and 24 reflections.
+
+#ifndef MOVE_TABLES_H
+#define MOVE_TABLES_H
+
+#include "cubie_cube.h"
+#include <cstdint>
+
+constexpr int NUM_FACELETS = 54;
+constexpr int NUM_SYMMETRIES = 48;
+
+// Stickers of each corner position, U/D sticker first then clockwise
+constexpr StickerRef CORNER_FACELETS[8][3] = {
+    {{UP, 2, 2}, {RIGHT, 0, 0}, {FRONT, 0, 2}},   // URF
+    {{UP, 2, 0}, {FRONT, 0, 0}, {LEFT, 0, 2}},    // UFL
+    {{UP, 0, 0}, {LEFT, 0, 0}, {BACK, 0, 2}},     // ULB
+    {{UP, 0, 2}, {BACK, 0, 0}, {RIGHT, 0, 2}},    // UBR
+    {{DOWN, 0, 2}, {FRONT, 2, 2}, {RIGHT, 2, 0}}, // DFR
+    {{DOWN, 0, 0}, {LEFT, 2, 2}, {FRONT, 2, 0}},  // DLF
+    {{DOWN, 2, 0}, {BACK, 2, 2}, {LEFT, 2, 0}},   // DBL
+    {{DOWN, 2, 2}, {RIGHT, 2, 2}, {BACK, 2, 0}}   // DRB
+};
+
+// Stickers of each edge position, U/D (or F/B for middle-layer edges) sticker first
+constexpr StickerRef EDGE_FACELETS[12][2] = {
+    {{UP, 1, 2}, {RIGHT, 0, 1}},    // UR
+    {{UP, 2, 1}, {FRONT, 0, 1}},    // UF
+    {{UP, 1, 0}, {LEFT, 0, 1}},     // UL
+    {{UP, 0, 1}, {BACK, 0, 1}},     // UB
+    {{DOWN, 1, 2}, {RIGHT, 2, 1}},  // DR
+    {{DOWN, 0, 1}, {FRONT, 2, 1}},  // DF
+    {{DOWN, 1, 0}, {LEFT, 2, 1}},   // DL
+    {{DOWN, 2, 1}, {BACK, 2, 1}},   // DB
+    {{FRONT, 1, 2}, {RIGHT, 1, 0}}, // FR
+    {{FRONT, 1, 0}, {LEFT, 1, 2}},  // FL
+    {{BACK, 1, 2}, {LEFT, 1, 0}},   // BL
+    {{BACK, 1, 0}, {RIGHT, 1, 2}}   // BR
+};
+
+constexpr int faceletIndex(const StickerRef& sticker) {
+    return sticker.face * 9 + sticker.row * 3 + sticker.col;
+}
+
+struct FaceletPermutation {
+    std::uint8_t from[NUM_FACELETS];
+};
+
+constexpr FaceletPermutation compose(const FaceletPermutation& first, const FaceletPermutation& second) {
+    FaceletPermutation result{};
+    for (int i = 0; i < NUM_FACELETS; i++) result.from[i] = first.from[second.from[i]];
+    return result;
+}
+
+constexpr bool operator==(const FaceletPermutation& a, const FaceletPermutation& b) {
+    for (int i = 0; i < NUM_FACELETS; i++) {
+        if (a.from[i] != b.from[i]) return false;
+    }
+    return true;
+}
+
+struct MoveTables {
+    FaceletPermutation moveFacelets[NUM_MOVES];
+    CubieCube moveCubes[NUM_MOVES];
+
+    std::int8_t symmetryMatrix[NUM_SYMMETRIES][3][3];
+    FaceletPermutation symmetryFacelets[NUM_SYMMETRIES];        // Moves stickers as the map does
+    std::uint8_t symmetryMultiply[NUM_SYMMETRIES][NUM_SYMMETRIES]; // [a][b] = a after b
+    std::uint8_t symmetryInverse[NUM_SYMMETRIES];
+    std::uint8_t symmetryFace[NUM_SYMMETRIES][6];               // Image of each face
+    std::uint8_t conjugateMove[NUM_SYMMETRIES][NUM_MOVES];      // S^-1, move, S as one move
+
+    std::uint16_t twistMove[CORNER_ORIENTATIONS * NUM_MOVES];   // [twist * NUM_MOVES + move]
+    std::uint16_t flipMove[EDGE_ORIENTATIONS * NUM_MOVES];      // [flip * NUM_MOVES + move]
+};
+
+// Constant-initialized (read-only data) in move_tables.cpp
+extern const MoveTables MOVE_TABLES;
+
+#endif // MOVE_TABLES_H
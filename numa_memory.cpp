@@ -0,0 +1,233 @@
+// NUMA Memory Implementation
+// Anonymous mappings with huge-page hints and libnuma placement policies
+
+#include "numa_memory.h"
+#include <cstdint>
+#include <cstdio>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#ifdef RUBIK_HAVE_LIBNUMA
+#include <numa.h>
+#include <sched.h>
+#endif
+
+thread_local int numaCachedNode = -1;
+
+namespace {
+
+constexpr std::size_t SMALL_PAGE_SIZE = 4096;
+constexpr std::size_t HUGE_PAGE_SIZE = 2u << 20;  // PMD size on x86-64 and 4K-page AArch64
+
+const char* const PLACEMENT_NAMES[NUMA_PLACEMENTS] = {"first-touch", "interleave", "replicate"};
+const char* const PAGE_MODE_NAMES[HUGE_PAGE_MODES] = {"off", "thp", "explicit"};
+
+std::size_t roundUp(std::size_t value, std::size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+#ifdef RUBIK_HAVE_LIBNUMA
+// numa_available() has to be called before any other libnuma function
+bool libnumaUsable() {
+    static const bool usable = numa_available() >= 0;
+    return usable;
+}
+#endif
+
+} // namespace
+
+const char* numaPlacementName(NumaPlacement placement) {
+    return placement >= 0 && placement < NUMA_PLACEMENTS ? PLACEMENT_NAMES[placement] : "unknown";
+}
+
+bool parseNumaPlacement(const std::string& name, NumaPlacement& placement) {
+    for (int i = 0; i < NUMA_PLACEMENTS; i++) {
+        if (name == PLACEMENT_NAMES[i]) {
+            placement = static_cast<NumaPlacement>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* hugePageModeName(HugePageMode mode) {
+    return mode >= 0 && mode < HUGE_PAGE_MODES ? PAGE_MODE_NAMES[mode] : "unknown";
+}
+
+bool parseHugePageMode(const std::string& name, HugePageMode& mode) {
+    for (int i = 0; i < HUGE_PAGE_MODES; i++) {
+        if (name == PAGE_MODE_NAMES[i]) {
+            mode = static_cast<HugePageMode>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool numaAvailable() {
+#ifdef RUBIK_HAVE_LIBNUMA
+    return libnumaUsable();
+#else
+    return false;
+#endif
+}
+
+int numaNodeCount() {
+#ifdef RUBIK_HAVE_LIBNUMA
+    if (libnumaUsable()) return numa_max_node() + 1;
+#endif
+    return 1;
+}
+
+bool numaNodeHasMemory(int node) {
+#ifdef RUBIK_HAVE_LIBNUMA
+    if (libnumaUsable()) {
+        return node >= 0 && node < numaNodeCount() && numa_bitmask_isbitset(numa_all_nodes_ptr, node);
+    }
+#endif
+    return node == 0;
+}
+
+int numaCurrentNode() {
+#ifdef RUBIK_HAVE_LIBNUMA
+    if (libnumaUsable()) {
+        int cpu = sched_getcpu();
+        int node = cpu >= 0 ? numa_node_of_cpu(cpu) : -1;
+        return node >= 0 ? node : 0;
+    }
+#endif
+    return 0;
+}
+
+bool numaRunOnNode(int node) {
+#ifdef RUBIK_HAVE_LIBNUMA
+    if (libnumaUsable()) {
+        if (node < 0 || node >= numaNodeCount() || numa_run_on_node(node) != 0) return false;
+        numaCachedNode = node;
+        return true;
+    }
+#endif
+    numaCachedNode = 0;
+    return node == 0;
+}
+
+NumaBuffer::NumaBuffer() : bytes(nullptr), length(0), mapped(0), pages(HUGE_PAGES_OFF) {}
+
+NumaBuffer::~NumaBuffer() {
+    release();
+}
+
+bool NumaBuffer::allocate(std::size_t size, int node, HugePageMode hugePages) {
+    release();
+    if (size == 0 || node >= numaNodeCount()) return false;
+#ifdef _WIN32
+    // Large pages need SeLockMemoryPrivilege; only the node preference is honoured here
+    void* address = nullptr;
+    if (node >= 0) {
+        address = VirtualAllocExNuma(GetCurrentProcess(), nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE,
+                                     static_cast<DWORD>(node));
+    }
+    if (!address) address = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (!address) return false;
+    bytes = static_cast<unsigned char*>(address);
+    length = size;
+    mapped = size;
+    pages = HUGE_PAGES_OFF;
+    (void)hugePages;
+    return true;
+#else
+    void* address = MAP_FAILED;
+    std::size_t mapLength = 0;
+    HugePageMode obtained = HUGE_PAGES_OFF;
+#ifdef MAP_HUGETLB
+    if (hugePages == HUGE_PAGES_EXPLICIT) {
+        mapLength = roundUp(size, HUGE_PAGE_SIZE);
+        address = mmap(nullptr, mapLength, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (address != MAP_FAILED) obtained = HUGE_PAGES_EXPLICIT;
+    }
+#endif
+    if (address == MAP_FAILED) {
+        // Transparent huge pages only back 2 MB-aligned ranges: map one huge page of slack and
+        // trim it from both ends
+        bool transparent = hugePages != HUGE_PAGES_OFF;
+        std::size_t alignment = transparent ? HUGE_PAGE_SIZE : SMALL_PAGE_SIZE;
+        mapLength = roundUp(size, alignment);
+        std::size_t slack = transparent ? HUGE_PAGE_SIZE : 0;
+        void* raw = mmap(nullptr, mapLength + slack, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) return false;
+        std::uintptr_t start = reinterpret_cast<std::uintptr_t>(raw);
+        std::uintptr_t aligned = roundUp(start, alignment);
+        if (aligned > start) munmap(raw, aligned - start);
+        std::size_t tail = start + mapLength + slack - (aligned + mapLength);
+        if (tail > 0) munmap(reinterpret_cast<void*>(aligned + mapLength), tail);
+        address = reinterpret_cast<void*>(aligned);
+#ifdef MADV_HUGEPAGE
+        // Also opt out explicitly so "off" measures small pages when THP is set to "always"
+        madvise(address, mapLength, transparent ? MADV_HUGEPAGE : MADV_NOHUGEPAGE);
+        if (transparent) obtained = HUGE_PAGES_TRANSPARENT;
+#endif
+    }
+
+#ifdef RUBIK_HAVE_LIBNUMA
+    if (libnumaUsable()) {
+        if (node >= 0) {
+            numa_tonode_memory(address, mapLength, node);
+        } else if (node == NUMA_INTERLEAVED) {
+            numa_interleave_memory(address, mapLength, numa_all_nodes_ptr);
+        }
+    }
+#endif
+    bytes = static_cast<unsigned char*>(address);
+    length = size;
+    mapped = mapLength;
+    pages = obtained;
+    return true;
+#endif
+}
+
+void NumaBuffer::release() {
+    if (bytes) {
+#ifdef _WIN32
+        VirtualFree(bytes, 0, MEM_RELEASE);
+#else
+        munmap(bytes, mapped);
+#endif
+    }
+    bytes = nullptr;
+    length = 0;
+    mapped = 0;
+    pages = HUGE_PAGES_OFF;
+}
+
+std::size_t NumaBuffer::hugePageBytes() const {
+    if (!bytes || pages == HUGE_PAGES_OFF) return 0;
+    if (pages == HUGE_PAGES_EXPLICIT) return mapped;
+#ifdef __linux__
+    // Sum AnonHugePages over the mappings inside the buffer (policies can split it into several)
+    std::FILE* smaps = std::fopen("/proc/self/smaps", "r");
+    if (!smaps) return 0;
+    unsigned long long begin = reinterpret_cast<std::uintptr_t>(bytes);
+    unsigned long long end = begin + mapped;
+    bool inside = false;
+    std::size_t total = 0;
+    char line[256];
+    while (std::fgets(line, sizeof(line), smaps)) {
+        unsigned long long from, to, kilobytes;
+        if (std::sscanf(line, "%llx-%llx ", &from, &to) == 2) {
+            inside = from >= begin && to <= end;
+        } else if (inside && std::sscanf(line, "AnonHugePages: %llu kB", &kilobytes) == 1) {
+            total += static_cast<std::size_t>(kilobytes) * 1024;
+        }
+    }
+    std::fclose(smaps);
+    return total;
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,90 @@
+// NUMA Memory Header
+// Large anonymous buffers with NUMA placement and huge pages for random-access tables
+//
+// Placement uses libnuma when the build found it (RUBIK_HAVE_LIBNUMA) and the kernel supports
+// NUMA policies; otherwise the machine is treated as a single node and every placement request
+// succeeds as an ordinary allocation, so callers need no second code path.
+//
+// Huge pages: HUGE_PAGES_EXPLICIT maps from the reserved pool (MAP_HUGETLB, see
+// /proc/sys/vm/nr_hugepages) and falls back to transparent ones when the pool is short;
+// HUGE_PAGES_TRANSPARENT maps 2 MB-aligned memory and asks for THP with madvise, which is
+// honoured when /sys/kernel/mm/transparent_hugepage/enabled is "always" or "madvise".
+
+#ifndef NUMA_MEMORY_H
+#define NUMA_MEMORY_H
+
+#include <cstddef>
+#include <string>
+
+enum NumaPlacement {
+    NUMA_FIRST_TOUCH = 0,  // Pages land on the node of the thread that fills them
+    NUMA_INTERLEAVE = 1,   // Pages round-robin over all nodes
+    NUMA_REPLICATE = 2,    // One copy per node, each thread reads its own node's copy
+    NUMA_PLACEMENTS = 3
+};
+
+enum HugePageMode {
+    HUGE_PAGES_OFF = 0,
+    HUGE_PAGES_TRANSPARENT = 1,
+    HUGE_PAGES_EXPLICIT = 2,
+    HUGE_PAGE_MODES = 3
+};
+
+const char* numaPlacementName(NumaPlacement placement);
+bool parseNumaPlacement(const std::string& name, NumaPlacement& placement);
+const char* hugePageModeName(HugePageMode mode);
+bool parseHugePageMode(const std::string& name, HugePageMode& mode);
+
+// True when libnuma is linked and the kernel supports NUMA policies
+bool numaAvailable();
+
+// Highest node id + 1 (1 without NUMA support); nodes without memory are skipped by placement
+int numaNodeCount();
+bool numaNodeHasMemory(int node);
+
+// Node of the CPU the calling thread runs on right now
+int numaCurrentNode();
+
+// Restrict the calling thread to the CPUs of a node; false if the node has no CPUs
+bool numaRunOnNode(int node);
+
+// Node of the calling thread, looked up once per thread (numaRunOnNode updates it)
+extern thread_local int numaCachedNode;
+inline int numaThreadNode() {
+    if (numaCachedNode < 0) numaCachedNode = numaCurrentNode();
+    return numaCachedNode;
+}
+
+constexpr int NUMA_ANY_NODE = -1;     // First touch
+constexpr int NUMA_INTERLEAVED = -2;  // Round-robin over all nodes
+
+// Page-aligned, zero-filled anonymous memory; the policy is set before the first touch, so
+// pages land where requested when the caller fills the buffer
+class NumaBuffer {
+private:
+    unsigned char* bytes;
+    std::size_t length;
+    std::size_t mapped;
+    HugePageMode pages;
+
+public:
+    NumaBuffer();
+    ~NumaBuffer();
+    NumaBuffer(const NumaBuffer&) = delete;
+    NumaBuffer& operator=(const NumaBuffer&) = delete;
+
+    // node is a node id, NUMA_ANY_NODE or NUMA_INTERLEAVED
+    bool allocate(std::size_t size, int node, HugePageMode hugePages);
+    void release();
+
+    unsigned char* data() const { return bytes; }
+    std::size_t size() const { return length; }
+
+    // Page mode actually obtained (explicit requests may fall back to transparent)
+    HugePageMode pageMode() const { return pages; }
+
+    // Bytes currently backed by huge pages (Linux; reads /proc/self/smaps for transparent ones)
+    std::size_t hugePageBytes() const;
+};
+
+#endif // NUMA_MEMORY_H
@@ -0,0 +1,384 @@
+// Pattern Database Implementation
+// Coordinate ranking per kind, successor generation and the checksummed table file
+
+#include "pattern_database.h"
+#include "cube_search.h"
+#include "distance_estimator.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+const char FILE_MAGIC[8] = {'R', 'B', 'K', 'P', 'D', 'B', '0', '1'};
+const std::uint32_t FORMAT_VERSION = 1;
+const std::size_t HEADER_SIZE = 168;
+const std::size_t CHECKSUM_OFFSET = 36;  // Header checksum field
+
+const char* const KIND_NAMES[PATTERN_KINDS] = {"corners", "edges7", "phase1"};
+
+constexpr int TRACKED_EDGES = 7;
+constexpr std::uint64_t EDGE7_FLIPS = 1u << TRACKED_EDGES;
+constexpr std::uint64_t EDGE7_PLACEMENTS = 3991680;  // 12! / 5!
+
+void putU32(std::uint8_t* out, std::uint32_t value) {
+    for (int i = 0; i < 4; i++) out[i] = static_cast<std::uint8_t>(value >> (8 * i));
+}
+
+void putU64(std::uint8_t* out, std::uint64_t value) {
+    for (int i = 0; i < 8; i++) out[i] = static_cast<std::uint8_t>(value >> (8 * i));
+}
+
+std::uint32_t getU32(const std::uint8_t* in) {
+    std::uint32_t value = 0;
+    for (int i = 0; i < 4; i++) value |= static_cast<std::uint32_t>(in[i]) << (8 * i);
+    return value;
+}
+
+std::uint64_t getU64(const std::uint8_t* in) {
+    std::uint64_t value = 0;
+    for (int i = 0; i < 8; i++) value |= static_cast<std::uint64_t>(in[i]) << (8 * i);
+    return value;
+}
+
+std::size_t tableOffset(std::uint32_t chunkCount) {
+    std::size_t end = HEADER_SIZE + 4 * static_cast<std::size_t>(chunkCount);
+    return (end + PATTERN_ALIGNMENT - 1) / PATTERN_ALIGNMENT * PATTERN_ALIGNMENT;
+}
+
+std::uint32_t headerChecksum(const std::uint8_t* header, std::size_t size) {
+    std::vector<std::uint8_t> copy(header, header + size);
+    putU32(copy.data() + CHECKSUM_OFFSET, 0);
+    return patternChecksum(copy.data(), copy.size());
+}
+
+// Edge permutation with the tracked edges' positions in the upper digits: rank of an ordered
+// choice of 7 of 12 positions, digit k weighted by (11 - k)! / 5!
+struct EdgeMoves {
+    std::uint8_t destination[NUM_MOVES][12];  // Position an edge moves to
+    std::uint8_t flip[NUM_MOVES][12];         // Flip it picks up on the way
+    std::uint32_t weight[TRACKED_EDGES];
+    std::uint8_t bitCount[1 << 12];           // Set bits of a 12-bit position mask
+
+    EdgeMoves() {
+        for (int move = 0; move < NUM_MOVES; move++) {
+            const CubieCube& m = moveCube(move);
+            for (int i = 0; i < 12; i++) {
+                destination[move][m.ep[i]] = static_cast<std::uint8_t>(i);
+                flip[move][m.ep[i]] = m.eo[i];
+            }
+        }
+        for (int k = 0; k < TRACKED_EDGES; k++) {
+            std::uint32_t w = 1;
+            for (int n = 11 - k; n > 12 - TRACKED_EDGES; n--) w *= static_cast<std::uint32_t>(n);
+            weight[k] = w;
+        }
+        for (int mask = 0; mask < (1 << 12); mask++) {
+            bitCount[mask] = static_cast<std::uint8_t>(mask == 0 ? 0 : bitCount[mask >> 1] + (mask & 1));
+        }
+    }
+
+    static const EdgeMoves& instance() {
+        static const EdgeMoves moves;
+        return moves;
+    }
+
+    std::uint64_t rank(const int* positions, const int* flips) const {
+        std::uint64_t placement = 0;
+        std::uint32_t used = 0, flipBits = 0;
+        for (int k = 0; k < TRACKED_EDGES; k++) {
+            int p = positions[k];
+            int smallerFree = p - bitCount[used & ((1u << p) - 1)];
+            placement += static_cast<std::uint64_t>(smallerFree) * weight[k];
+            used |= 1u << p;
+            flipBits |= static_cast<std::uint32_t>(flips[k]) << k;
+        }
+        return placement * EDGE7_FLIPS + flipBits;
+    }
+
+    void unrank(std::uint64_t index, int* positions, int* flips) const {
+        std::uint32_t flipBits = static_cast<std::uint32_t>(index % EDGE7_FLIPS);
+        std::uint32_t placement = static_cast<std::uint32_t>(index / EDGE7_FLIPS);
+        std::uint32_t used = 0;
+        for (int k = 0; k < TRACKED_EDGES; k++) {
+            std::uint32_t digit = placement / weight[k];
+            placement %= weight[k];
+            int p = 0;
+            for (;; p++) {
+                if (used & (1u << p)) continue;
+                if (digit-- == 0) break;
+            }
+            positions[k] = p;
+            used |= 1u << p;
+            flips[k] = (flipBits >> k) & 1;
+        }
+    }
+};
+
+} // namespace
+
+const char* patternName(PatternKind kind) {
+    return kind >= 0 && kind < PATTERN_KINDS ? KIND_NAMES[kind] : "unknown";
+}
+
+bool parsePatternKind(const std::string& name, PatternKind& kind) {
+    for (int i = 0; i < PATTERN_KINDS; i++) {
+        if (name == KIND_NAMES[i]) {
+            kind = static_cast<PatternKind>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+std::uint64_t patternSize(PatternKind kind) {
+    switch (kind) {
+        case PATTERN_CORNERS:
+            return static_cast<std::uint64_t>(CORNER_PERMUTATIONS) * CORNER_ORIENTATIONS;
+        case PATTERN_EDGES7:
+            return EDGE7_PLACEMENTS * EDGE7_FLIPS;
+        case PATTERN_PHASE1:
+            return static_cast<std::uint64_t>(CORNER_ORIENTATIONS) * EDGE_ORIENTATIONS * SLICE_POSITIONS;
+        default:
+            return 0;
+    }
+}
+
+std::uint64_t patternIndex(PatternKind kind, const CubieCube& cube) {
+    switch (kind) {
+        case PATTERN_CORNERS:
+            return static_cast<std::uint64_t>(cube.cornerPermutation()) * CORNER_ORIENTATIONS + cube.cornerOrientation();
+        case PATTERN_EDGES7: {
+            int positions[TRACKED_EDGES], flips[TRACKED_EDGES];
+            for (int i = 0; i < 12; i++) {
+                if (cube.ep[i] < TRACKED_EDGES) {
+                    positions[cube.ep[i]] = i;
+                    flips[cube.ep[i]] = cube.eo[i];
+                }
+            }
+            return EdgeMoves::instance().rank(positions, flips);
+        }
+        case PATTERN_PHASE1:
+            return (static_cast<std::uint64_t>(cube.cornerOrientation()) * EDGE_ORIENTATIONS + cube.edgeOrientation()) *
+                   SLICE_POSITIONS + SlicePatternTables::sliceCoordinate(cube);
+        default:
+            return 0;
+    }
+}
+
+void patternPrepare(PatternKind kind) {
+    if (kind == PATTERN_EDGES7) {
+        EdgeMoves::instance();
+    } else {
+        CoordinateTables::instance();
+        if (kind == PATTERN_PHASE1) SlicePatternTables::instance();
+    }
+}
+
+void patternSuccessors(PatternKind kind, std::uint64_t index, std::uint64_t* out) {
+    switch (kind) {
+        case PATTERN_CORNERS: {
+            const CoordinateTables& tables = CoordinateTables::instance();
+            const std::uint16_t* permutation = &tables.permutationMove[(index / CORNER_ORIENTATIONS) * NUM_MOVES];
+            const std::uint16_t* twist = &tables.twistMove[(index % CORNER_ORIENTATIONS) * NUM_MOVES];
+            for (int move = 0; move < NUM_MOVES; move++) {
+                out[move] = static_cast<std::uint64_t>(permutation[move]) * CORNER_ORIENTATIONS + twist[move];
+            }
+            break;
+        }
+        case PATTERN_EDGES7: {
+            const EdgeMoves& moves = EdgeMoves::instance();
+            int positions[TRACKED_EDGES], flips[TRACKED_EDGES], movedPositions[TRACKED_EDGES], movedFlips[TRACKED_EDGES];
+            moves.unrank(index, positions, flips);
+            for (int move = 0; move < NUM_MOVES; move++) {
+                for (int k = 0; k < TRACKED_EDGES; k++) {
+                    movedPositions[k] = moves.destination[move][positions[k]];
+                    movedFlips[k] = flips[k] ^ moves.flip[move][positions[k]];
+                }
+                out[move] = moves.rank(movedPositions, movedFlips);
+            }
+            break;
+        }
+        case PATTERN_PHASE1: {
+            const CoordinateTables& tables = CoordinateTables::instance();
+            const SlicePatternTables& patterns = SlicePatternTables::instance();
+            std::uint64_t slice = index % SLICE_POSITIONS;
+            std::uint64_t rest = index / SLICE_POSITIONS;
+            const std::uint16_t* flip = &tables.flipMove[(rest % EDGE_ORIENTATIONS) * NUM_MOVES];
+            const std::uint16_t* twist = &tables.twistMove[(rest / EDGE_ORIENTATIONS) * NUM_MOVES];
+            const std::uint16_t* sliceMove = &patterns.sliceMove[slice * NUM_MOVES];
+            for (int move = 0; move < NUM_MOVES; move++) {
+                out[move] = (static_cast<std::uint64_t>(twist[move]) * EDGE_ORIENTATIONS + flip[move]) * SLICE_POSITIONS +
+                            sliceMove[move];
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+std::uint32_t patternChecksum(const std::uint8_t* data, std::size_t size) {
+    std::uint32_t hash = 2166136261u;
+    for (std::size_t i = 0; i < size; i++) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+bool writePatternDatabase(const std::string& path, PatternKind kind, std::uint32_t chunkEntries,
+                          const std::uint64_t* depthCounts, const PatternChunkSource& source) {
+    std::uint64_t entries = patternSize(kind);
+    if (entries == 0 || chunkEntries == 0 || chunkEntries % 2 != 0) return false;
+    std::uint32_t chunkCount = static_cast<std::uint32_t>((entries + chunkEntries - 1) / chunkEntries);
+    std::uint64_t tableBytes = (entries + 1) / 2;
+    std::size_t offset = tableOffset(chunkCount);
+
+    std::string temporary = path + ".tmp";
+    std::FILE* file = std::fopen(temporary.c_str(), "wb");
+    if (!file) return false;
+
+    // Table first (chunk by chunk, checksummed on the way), header and checksums last
+    std::vector<std::uint8_t> header(offset, 0);
+    std::vector<std::uint8_t> buffer(chunkEntries / 2);
+    bool ok = std::fwrite(header.data(), 1, header.size(), file) == header.size();
+    for (std::uint32_t chunk = 0; ok && chunk < chunkCount; chunk++) {
+        std::uint64_t begin = static_cast<std::uint64_t>(chunk) * (chunkEntries / 2);
+        std::size_t bytes = static_cast<std::size_t>(std::min<std::uint64_t>(chunkEntries / 2, tableBytes - begin));
+        source(chunk, buffer.data(), bytes);
+        putU32(header.data() + HEADER_SIZE + 4 * static_cast<std::size_t>(chunk), patternChecksum(buffer.data(), bytes));
+        ok = std::fwrite(buffer.data(), 1, bytes, file) == bytes;
+    }
+
+    int maxDepth = 0;
+    for (int depth = 0; depth < 16; depth++) {
+        if (depthCounts[depth] > 0) maxDepth = depth;
+        putU64(header.data() + 40 + 8 * depth, depthCounts[depth]);
+    }
+    std::memcpy(header.data(), FILE_MAGIC, 8);
+    putU32(header.data() + 8, FORMAT_VERSION);
+    putU32(header.data() + 12, static_cast<std::uint32_t>(kind));
+    putU64(header.data() + 16, entries);
+    putU32(header.data() + 24, chunkEntries);
+    putU32(header.data() + 28, chunkCount);
+    putU32(header.data() + 32, static_cast<std::uint32_t>(maxDepth));
+    putU32(header.data() + CHECKSUM_OFFSET, headerChecksum(header.data(), HEADER_SIZE + 4 * static_cast<std::size_t>(chunkCount)));
+    ok = ok && std::fseek(file, 0, SEEK_SET) == 0 && std::fwrite(header.data(), 1, header.size(), file) == header.size();
+    ok = (std::fclose(file) == 0) && ok;
+    if (!ok) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+#ifdef _WIN32
+    std::remove(path.c_str());  // rename does not replace on Windows
+#endif
+    return std::rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+PatternDatabase::PatternDatabase()
+    : kind(PATTERN_CORNERS), entries(0), chunkEntries(0), chunkCount(0), maxDepth(0), depthCounts(),
+      checksums(nullptr), table(nullptr) {}
+
+void PatternDatabase::close() {
+    replicas.clear();
+    buffers.clear();
+    mapping.close();
+    table = nullptr;
+    checksums = nullptr;
+    entries = 0;
+}
+
+bool PatternDatabase::open(const std::string& path, bool verifyTable) {
+    close();
+    if (!mapping.open(path)) return false;
+    const std::uint8_t* data = mapping.data();
+    std::size_t size = mapping.size();
+    if (size < HEADER_SIZE || std::memcmp(data, FILE_MAGIC, 8) != 0 || getU32(data + 8) != FORMAT_VERSION) {
+        close();
+        return false;
+    }
+
+    std::uint32_t kindValue = getU32(data + 12);
+    entries = getU64(data + 16);
+    chunkEntries = getU32(data + 24);
+    chunkCount = getU32(data + 28);
+    maxDepth = static_cast<int>(getU32(data + 32));
+    bool valid = kindValue < PATTERN_KINDS && entries == patternSize(static_cast<PatternKind>(kindValue)) &&
+                 chunkEntries > 0 && chunkEntries % 2 == 0 &&
+                 chunkCount == (entries + chunkEntries - 1) / chunkEntries && maxDepth <= PATTERN_MAX_DEPTH;
+    std::size_t offset = valid ? tableOffset(chunkCount) : 0;
+    valid = valid && size >= offset + (entries + 1) / 2 &&
+            getU32(data + CHECKSUM_OFFSET) == headerChecksum(data, HEADER_SIZE + 4 * static_cast<std::size_t>(chunkCount));
+    if (!valid) {
+        close();
+        return false;
+    }
+
+    kind = static_cast<PatternKind>(kindValue);
+    for (int depth = 0; depth < 16; depth++) depthCounts[depth] = getU64(data + 40 + 8 * depth);
+    checksums = data + HEADER_SIZE;
+    table = data + offset;
+    if (verifyTable && firstCorruptChunk() >= 0) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool PatternDatabase::load(const std::string& path, const PatternLoadOptions& options) {
+    if (!open(path)) return false;
+    std::size_t tableBytes = static_cast<std::size_t>((entries + 1) / 2);
+    bool replicate = options.placement == NUMA_REPLICATE && numaNodeCount() > 1;
+    int nodes = replicate ? numaNodeCount() : 1;
+    if (replicate) replicas.assign(nodes, nullptr);
+    for (int node = 0; node < nodes; node++) {
+        if (replicate && !numaNodeHasMemory(node)) continue;
+        int target = replicate ? node : options.placement == NUMA_INTERLEAVE ? NUMA_INTERLEAVED : NUMA_ANY_NODE;
+        std::unique_ptr<NumaBuffer> buffer(new NumaBuffer());
+        if (!buffer->allocate(tableBytes, target, options.hugePages)) {
+            close();
+            return false;
+        }
+        std::memcpy(buffer->data(), table, tableBytes);
+        if (replicate) replicas[node] = buffer->data();
+        buffers.push_back(std::move(buffer));
+    }
+    // Threads on memoryless nodes read the first copy
+    table = buffers.front()->data();
+    for (const std::uint8_t*& replica : replicas) {
+        if (!replica) replica = table;
+    }
+    if (options.verifyTable && firstCorruptChunk() >= 0) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+std::size_t PatternDatabase::hugePageBytes() const {
+    std::size_t total = 0;
+    for (const std::unique_ptr<NumaBuffer>& buffer : buffers) total += buffer->hugePageBytes();
+    return total;
+}
+
+std::int64_t PatternDatabase::firstCorruptChunk() const {
+    if (!table) return -1;
+    std::uint64_t tableBytes = (entries + 1) / 2;
+    for (std::uint32_t chunk = 0; chunk < chunkCount; chunk++) {
+        std::uint64_t begin = static_cast<std::uint64_t>(chunk) * (chunkEntries / 2);
+        std::size_t bytes = static_cast<std::size_t>(std::min<std::uint64_t>(chunkEntries / 2, tableBytes - begin));
+        if (patternChecksum(table + begin, bytes) != getU32(checksums + 4 * static_cast<std::size_t>(chunk))) {
+            return chunk;
+        }
+    }
+    return -1;
+}
+
+bool openPatternDatabase(const std::string& path, const std::string& placement, const std::string& pages,
+                         PatternDatabase& database) {
+    if (placement == "mapped") return database.open(path);
+    PatternLoadOptions options;
+    if (!parseNumaPlacement(placement, options.placement) || !parseHugePageMode(pages, options.hugePages)) return false;
+    return database.load(path, options);
+}
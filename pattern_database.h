@@ -0,0 +1,123 @@
+// Pattern Database Header
+// Large pruning tables over ranked coordinates: index / successor functions and the mapped format
+//
+// Kinds (entries, file size at 4 bits per entry):
+//   corners   corner permutation x twist                 88,179,840   42 MB
+//   edges7    positions and flips of edges UR..DL        510,935,040  244 MB
+//   phase1    twist x flip x middle-slice positions      2,217,093,120  1.03 GB
+//
+// Tables are built by rubik_pdb_build. PatternDatabase either maps the file read-only (pages
+// come from the page cache, wherever the kernel put them) or loads the table into anonymous
+// memory with a NUMA placement and huge pages (see numa_memory.h); on multi-socket machines
+// replicating or interleaving keeps random lookups from all queueing on one node's memory.
+//
+// File layout (little-endian):
+//   header   "RBKPDB01", u32 version, u32 kind, u64 entries, u32 chunk entries, u32 chunk count,
+//            u32 max depth, u32 header checksum (FNV-1a of the header and checksum table with
+//            this field zeroed), u64 count per depth [16]
+//   checksum u32 FNV-1a per chunk of table bytes
+//   table    at the next 4096-byte boundary: entry i in the low (even i) or high (odd i) nibble
+//            of byte i / 2, holding the exact distance to solved
+
+#ifndef PATTERN_DATABASE_H
+#define PATTERN_DATABASE_H
+
+#include "cubie_cube.h"
+#include "mapped_file.h"
+#include "numa_memory.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+enum PatternKind {
+    PATTERN_CORNERS = 0,
+    PATTERN_EDGES7 = 1,
+    PATTERN_PHASE1 = 2,
+    PATTERN_KINDS = 3
+};
+
+constexpr int PATTERN_MAX_DEPTH = 14;        // Nibble 15 marks unvisited entries while building
+constexpr std::size_t PATTERN_ALIGNMENT = 4096;
+
+const char* patternName(PatternKind kind);
+bool parsePatternKind(const std::string& name, PatternKind& kind);
+std::uint64_t patternSize(PatternKind kind);
+
+// Rank of the pattern's pieces in a cube
+std::uint64_t patternIndex(PatternKind kind, const CubieCube& cube);
+
+// The NUM_MOVES neighbours of an entry, in move order; thread-safe once the shared move tables
+// exist (call patternPrepare first to build them outside the timed part)
+void patternPrepare(PatternKind kind);
+void patternSuccessors(PatternKind kind, std::uint64_t index, std::uint64_t* out);
+
+// Fills `bytes` table bytes of one chunk (the last chunk may be short)
+typedef std::function<void(std::uint32_t chunk, std::uint8_t* out, std::size_t bytes)> PatternChunkSource;
+
+// Streams the table chunk by chunk into path + ".tmp", then renames it into place
+bool writePatternDatabase(const std::string& path, PatternKind kind, std::uint32_t chunkEntries,
+                          const std::uint64_t* depthCounts, const PatternChunkSource& source);
+
+std::uint32_t patternChecksum(const std::uint8_t* data, std::size_t size);
+
+struct PatternLoadOptions {
+    NumaPlacement placement = NUMA_INTERLEAVE;
+    HugePageMode hugePages = HUGE_PAGES_TRANSPARENT;
+    bool verifyTable = false;
+};
+
+class PatternDatabase {
+private:
+    MappedFile mapping;
+    PatternKind kind;
+    std::uint64_t entries;
+    std::uint32_t chunkEntries;
+    std::uint32_t chunkCount;
+    int maxDepth;
+    std::uint64_t depthCounts[16];
+    const std::uint8_t* checksums;
+    const std::uint8_t* table;
+    std::vector<std::unique_ptr<NumaBuffer>> buffers;  // Loaded copies (empty when mapped)
+    std::vector<const std::uint8_t*> replicas;        // Table per node id when replicated
+
+    // Replica on the calling thread's node; pin workers with numaRunOnNode so it stays local
+    const std::uint8_t* localTable() const { return replicas.size() > 1 ? replicas[numaThreadNode()] : table; }
+
+public:
+    PatternDatabase();
+
+    // Map and validate the header; verifyTable also checks every chunk checksum (reads the
+    // whole table, about 1 s per GB)
+    bool open(const std::string& path, bool verifyTable = false);
+
+    // Copy the table out of the file into placed memory (one copy per node for NUMA_REPLICATE);
+    // verifyTable checks the first copy
+    bool load(const std::string& path, const PatternLoadOptions& options);
+    void close();
+    bool isOpen() const { return table != nullptr; }
+    bool isLoaded() const { return !buffers.empty(); }
+    int replicaCount() const { return static_cast<int>(buffers.size()); }
+    HugePageMode pageMode() const { return buffers.empty() ? HUGE_PAGES_OFF : buffers.front()->pageMode(); }
+    std::size_t hugePageBytes() const;
+
+    // Index of the first chunk whose checksum does not match, or -1
+    std::int64_t firstCorruptChunk() const;
+
+    PatternKind getKind() const { return kind; }
+    std::uint64_t size() const { return entries; }
+    int getMaxDepth() const { return maxDepth; }
+    std::uint64_t countAtDepth(int depth) const { return depth >= 0 && depth < 16 ? depthCounts[depth] : 0; }
+
+    int distance(std::uint64_t index) const { return (localTable()[index >> 1] >> ((index & 1) * 4)) & 0xF; }
+    int distance(const CubieCube& cube) const { return distance(patternIndex(kind, cube)); }
+};
+
+// Opens a table for a solver: placement "mapped" maps the file, a NumaPlacement name loads it
+// with the named page mode; false on an unknown name or a file that does not open
+bool openPatternDatabase(const std::string& path, const std::string& placement, const std::string& pages,
+                         PatternDatabase& database);
+
+#endif // PATTERN_DATABASE_H
@@ -0,0 +1,136 @@
+// Frame Profiler Implementation
+// Event ring buffer, frame statistics and trace export
+
+#include "profiler.h"
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <thread>
+
+// Constructor - allocate all buffers up front
+Profiler::Profiler()
+    : origin(std::chrono::steady_clock::now()), events(EVENT_CAPACITY), nextEvent(0),
+      frameTimes(FRAME_HISTORY, 0.0f), frameMoves(FRAME_HISTORY, 0),
+      frameCursor(0), frameCount(0), frameStart(0) {
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        counters[i] = 0;
+        lastCounters[i] = 0;
+    }
+}
+
+// Process-wide profiler
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+// Microseconds since the profiler was created
+std::int64_t Profiler::now() const {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - origin).count();
+}
+
+// Store one event; the oldest event is overwritten when the buffer is full
+void Profiler::record(const char* name, std::int64_t start, std::int64_t duration) {
+    static thread_local std::uint32_t threadId =
+        static_cast<std::uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id()) & 0xFFFF);
+    std::uint64_t ticket = nextEvent.fetch_add(1, std::memory_order_relaxed);
+    ProfileEventSlot& slot = events[ticket & (EVENT_CAPACITY - 1)];
+    slot.sequence.store(2 * ticket + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.start.store(start, std::memory_order_relaxed);
+    slot.duration.store(duration, std::memory_order_relaxed);
+    slot.thread.store(threadId, std::memory_order_relaxed);
+    slot.sequence.store(2 * ticket + 2, std::memory_order_release);
+}
+
+// Start timing a frame
+void Profiler::beginFrame() {
+    frameStart = now();
+}
+
+// Close the frame: store its duration and move counters into the snapshot
+void Profiler::endFrame() {
+    std::int64_t end = now();
+    record("Frame", frameStart, end - frameStart);
+
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        lastCounters[i] = counters[i].exchange(0);
+    }
+
+    frameTimes[frameCursor] = (end - frameStart) / 1000.0f;
+    frameMoves[frameCursor] = lastCounters[COUNTER_MOVES];
+    frameCursor = (frameCursor + 1) % FRAME_HISTORY;
+    frameCount = std::min(frameCount + 1, FRAME_HISTORY);
+}
+
+// Percentiles over the frame history and moves/sec over the last second
+FrameStats Profiler::getStats() const {
+    FrameStats stats = {};
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        stats.counters[i] = lastCounters[i];
+    }
+    if (frameCount == 0) return stats;
+
+    std::vector<float> sorted = getFrameHistory();
+    std::sort(sorted.begin(), sorted.end());
+    stats.p50Ms = sorted[(sorted.size() - 1) / 2];
+    stats.p99Ms = sorted[std::min(sorted.size() - 1, (sorted.size() * 99) / 100)];
+
+    // Walk backwards from the newest frame until one second is covered
+    float elapsedMs = 0.0f;
+    std::int64_t moves = 0;
+    for (std::size_t i = 0; i < frameCount && elapsedMs < 1000.0f; i++) {
+        std::size_t index = (frameCursor + FRAME_HISTORY - 1 - i) % FRAME_HISTORY;
+        elapsedMs += frameTimes[index];
+        moves += frameMoves[index];
+    }
+    if (elapsedMs > 0.0f) {
+        stats.movesPerSecond = moves * 1000.0f / elapsedMs;
+    }
+    return stats;
+}
+
+// Frame times in chronological order
+std::vector<float> Profiler::getFrameHistory() const {
+    std::vector<float> history;
+    history.reserve(frameCount);
+    std::size_t first = (frameCursor + FRAME_HISTORY - frameCount) % FRAME_HISTORY;
+    for (std::size_t i = 0; i < frameCount; i++) {
+        history.push_back(frameTimes[(first + i) % FRAME_HISTORY]);
+    }
+    return history;
+}
+
+// Write "complete" (ph = X) events; timestamps are already in microseconds
+bool Profiler::exportChromeTrace(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) return false;
+
+    std::uint64_t total = nextEvent.load();
+    std::uint64_t count = std::min<std::uint64_t>(total, EVENT_CAPACITY);
+    bool first = true;
+    out << "{\"traceEvents\":[\n";
+    for (std::uint64_t i = 0; i < count; i++) {
+        // Skip slots that are being written or were already reused by a newer event
+        std::uint64_t ticket = total - count + i;
+        const ProfileEventSlot& slot = events[ticket & (EVENT_CAPACITY - 1)];
+        std::uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != 2 * ticket + 2) continue;
+        ProfileEvent event;
+        event.name = slot.name.load(std::memory_order_relaxed);
+        event.start = slot.start.load(std::memory_order_relaxed);
+        event.duration = slot.duration.load(std::memory_order_relaxed);
+        event.thread = slot.thread.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != sequence || !event.name) continue;
+        out << (first ? "" : ",\n")
+            << "{\"name\":\"" << event.name << "\",\"cat\":\"rubik\",\"ph\":\"X\""
+            << ",\"ts\":" << event.start << ",\"dur\":" << event.duration
+            << ",\"pid\":1,\"tid\":" << event.thread << "}";
+        first = false;
+    }
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return static_cast<bool>(out);
+}
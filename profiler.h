@@ -0,0 +1,123 @@
+// Frame Profiler Header
+// Scoped timers, per-frame counters and Chrome trace-event export
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Per-frame counters shown in the overlay
+enum ProfileCounter {
+    COUNTER_DRAW_CALLS = 0,
+    COUNTER_VERTICES = 1,
+    COUNTER_MOVES = 2,
+    COUNTER_COUNT = 3
+};
+
+// One completed scope, in microseconds since profiler start (a copy taken from the ring)
+struct ProfileEvent {
+    const char* name;
+    std::int64_t start;
+    std::int64_t duration;
+    std::uint32_t thread;
+};
+
+// Summary of recent frames for the overlay
+struct FrameStats {
+    float p50Ms;
+    float p99Ms;
+    float movesPerSecond;
+    std::int64_t counters[COUNTER_COUNT];  // Values from the last completed frame
+};
+
+// Ring slot, written by any thread and read by the exporter. sequence is 2 * ticket + 1 while
+// the writer fills it and 2 * ticket + 2 once it is complete; readers keep only slots whose
+// sequence is unchanged around the copy.
+struct ProfileEventSlot {
+    std::atomic<std::uint64_t> sequence;
+    std::atomic<const char*> name;
+    std::atomic<std::int64_t> start;
+    std::atomic<std::int64_t> duration;
+    std::atomic<std::uint32_t> thread;
+};
+
+// Profiler - fixed-size ring buffers, no allocation after construction.
+// Scopes and counters are only compiled into the game and its own build of the core
+// (rubik_core_profiled); the tools link an uninstrumented core and never touch the ring.
+class Profiler {
+private:
+    static constexpr std::size_t EVENT_CAPACITY = 1 << 16;  // Must be a power of two
+    static constexpr std::size_t FRAME_HISTORY = 240;
+
+    std::chrono::steady_clock::time_point origin;
+    std::vector<ProfileEventSlot> events;
+    std::atomic<std::uint64_t> nextEvent;
+
+    std::atomic<std::int64_t> counters[COUNTER_COUNT];
+    std::int64_t lastCounters[COUNTER_COUNT];
+
+    std::vector<float> frameTimes;       // Milliseconds, ring buffer
+    std::vector<std::int64_t> frameMoves;
+    std::size_t frameCursor;
+    std::size_t frameCount;
+    std::int64_t frameStart;
+
+    Profiler();
+
+public:
+    static Profiler& instance();
+
+    // Microseconds since profiler start
+    std::int64_t now() const;
+
+    void record(const char* name, std::int64_t start, std::int64_t duration);
+    void addCount(ProfileCounter counter, std::int64_t amount) { counters[counter] += amount; }
+
+    // Frame boundaries: endFrame() closes the frame and snapshots counters
+    void beginFrame();
+    void endFrame();
+
+    FrameStats getStats() const;
+
+    // Last frame times in milliseconds, oldest first
+    std::vector<float> getFrameHistory() const;
+
+    // Write buffered events as Chrome trace-event JSON (chrome://tracing, Perfetto)
+    bool exportChromeTrace(const std::string& path) const;
+};
+
+// RAII timer - records its lifetime as one event
+class ProfileScope {
+private:
+    const char* name;
+    std::int64_t start;
+
+public:
+    explicit ProfileScope(const char* scopeName) : name(scopeName), start(Profiler::instance().now()) {}
+    ~ProfileScope() {
+        Profiler& profiler = Profiler::instance();
+        profiler.record(name, start, profiler.now() - start);
+    }
+};
+
+// Instrumentation macros - expand to nothing unless RUBIK_ENABLE_PROFILER is defined
+#define RUBIK_PROFILE_CONCAT_INNER(a, b) a##b
+#define RUBIK_PROFILE_CONCAT(a, b) RUBIK_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef RUBIK_ENABLE_PROFILER
+#define PROFILE_SCOPE(name) ProfileScope RUBIK_PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_COUNT(counter, amount) Profiler::instance().addCount(counter, amount)
+#define PROFILE_FRAME_BEGIN() Profiler::instance().beginFrame()
+#define PROFILE_FRAME_END() Profiler::instance().endFrame()
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_COUNT(counter, amount) ((void)0)
+#define PROFILE_FRAME_BEGIN() ((void)0)
+#define PROFILE_FRAME_END() ((void)0)
+#endif
+
+#endif // PROFILER_H
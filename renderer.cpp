@@ -2,35 +2,93 @@
 // Handles all OpenGL rendering, camera control, and animation
 
 #include "renderer.h"
+#include "profiler.h"
 #include <cmath>
 #include <algorithm>
 #include <cstdlib>
 #include <ctime>
+#include <iostream>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
 // Constructor - initialize camera position
-Renderer::Renderer() {
+Renderer::Renderer()
+    : viewportWidth(0), viewportHeight(0), useShaders(false), cachedCube(nullptr), cachedVersion(0),
+      sliceActive(false), sliceFace(-1), sliceAxis(0), sliceSign(1.0f) {
     cameraAngleX = 30.0f;
     cameraAngleY = 45.0f;
     cameraDistance = 8.0f;
+    sliceCenter[0] = sliceCenter[1] = sliceCenter[2] = 0.0f;
+    std::fill(sliceMembers, sliceMembers + 27, false);
+    buildStars();
+    buildStickerTable();
 }
 
-// Draw starfield background
-void Renderer::drawStars() {
-    glDisable(GL_LIGHTING);
-    glDisable(GL_DEPTH_TEST);
+// Precompute which sticker each cubie face shows (same mapping as the cube model)
+void Renderer::buildStickerTable() {
+    for (int x = -1; x <= 1; x++) {
+        for (int y = -1; y <= 1; y++) {
+            for (int z = -1; z <= 1; z++) {
+                StickerRef* refs = stickerTable[(x + 1) * 9 + (y + 1) * 3 + (z + 1)];
+                for (int face = 0; face < 6; face++) refs[face] = cubieSticker(x, y, z, face);
+            }
+        }
+    }
+}
+
+// Refresh cached sticker colors if the cube changed since the last frame
+void Renderer::updateColorCache(const RubikCube& cube) {
+    if (&cube == cachedCube && cube.getVersion() == cachedVersion) return;
+    PROFILE_SCOPE("Renderer::updateColorCache");
     
-    glPointSize(2.0f);
-    glBegin(GL_POINTS);
-    glColor3f(1.0f, 1.0f, 1.0f); // White stars
+    const auto& faces = cube.getFaces();
+    for (int cubie = 0; cubie < 27; cubie++) {
+        for (int face = 0; face < 6; face++) {
+            const StickerRef& ref = stickerTable[cubie][face];
+            colorCache[cubie][face] = faces[ref.face][ref.row][ref.col];
+        }
+    }
+    cachedCube = &cube;
+    cachedVersion = cube.getVersion();
+}
+
+// Recompute the rotating slice when an animation starts, ends or changes face
+void Renderer::updateSlice(const AnimationState& anim) {
+    bool active = anim.isAnimating && anim.face >= RIGHT && anim.face <= BACK;
+    if (active == sliceActive && (!active || anim.face == sliceFace)) return;
+    
+    sliceActive = active;
+    sliceFace = active ? anim.face : -1;
+    std::fill(sliceMembers, sliceMembers + 27, false);
+    if (!active) return;
+    
+    // RIGHT/LEFT turn about X, UP/DOWN about Y, FRONT/BACK about Z
+    sliceAxis = anim.face / 2;
+    int layer = (anim.face % 2 == 0) ? 1 : -1;
+    sliceSign = static_cast<float>(sliceTurnSign(anim.face));
+    sliceCenter[0] = sliceCenter[1] = sliceCenter[2] = 0.0f;
+    sliceCenter[sliceAxis] = static_cast<float>(layer);
+    
+    for (int x = -1; x <= 1; x++) {
+        for (int y = -1; y <= 1; y++) {
+            for (int z = -1; z <= 1; z++) {
+                int coords[3] = {x, y, z};
+                sliceMembers[(x + 1) * 9 + (y + 1) * 3 + (z + 1)] = coords[sliceAxis] == layer;
+            }
+        }
+    }
+}
+
+// Generate starfield once - shared by the shader and fixed-function paths
+void Renderer::buildStars() {
+    stars.clear();
     
     // Generate stars in a sphere around the origin
     // Using a simple pseudo-random distribution
     std::srand(42); // Fixed seed for consistent star positions
-    for (int i = 0; i < 150; i++) {
+    for (int i = 0; i < 165; i++) {
         // Generate random point on sphere
         float theta = (float)(std::rand() % 628) / 100.0f; // 0 to 2*PI
         float phi = (float)(std::rand() % 314) / 100.0f;   // 0 to PI
@@ -40,25 +98,36 @@ void Renderer::drawStars() {
         float y = radius * sin(phi) * sin(theta);
         float z = radius * cos(phi);
         
-        glVertex3f(x, y, z);
+        // Last 15 stars are brighter, slightly yellow and larger
+        bool bright = i >= 150;
+        float star[7] = {
+            x, y, z,
+            1.0f, 1.0f, bright ? 0.9f : 1.0f,
+            bright ? 3.0f : 2.0f
+        };
+        stars.insert(stars.end(), star, star + 7);
     }
+}
+
+// Draw starfield background
+void Renderer::drawStars() {
+    PROFILE_SCOPE("Renderer::drawStars");
+    glDisable(GL_LIGHTING);
+    glDisable(GL_DEPTH_TEST);
     
-    // Add some brighter stars
-    glPointSize(3.0f);
-    glColor3f(1.0f, 1.0f, 0.9f); // Slightly yellow for brighter stars
-    for (int i = 0; i < 15; i++) {
-        float theta = (float)(std::rand() % 628) / 100.0f;
-        float phi = (float)(std::rand() % 314) / 100.0f;
-        float radius = 50.0f;
-        
-        float x = radius * sin(phi) * cos(theta);
-        float y = radius * sin(phi) * sin(theta);
-        float z = radius * cos(phi);
-        
-        glVertex3f(x, y, z);
+    // Point size cannot change inside glBegin/glEnd, so draw one batch per size
+    for (float pointSize : {2.0f, 3.0f}) {
+        glPointSize(pointSize);
+        glBegin(GL_POINTS);
+        for (size_t i = 0; i + 7 <= stars.size(); i += 7) {
+            if (stars[i + 6] != pointSize) continue;
+            glColor3f(stars[i + 3], stars[i + 4], stars[i + 5]);
+            glVertex3f(stars[i], stars[i + 1], stars[i + 2]);
+        }
+        glEnd();
+        PROFILE_COUNT(COUNTER_DRAW_CALLS, 1);
     }
-    
-    glEnd();
+    PROFILE_COUNT(COUNTER_VERTICES, static_cast<std::int64_t>(stars.size() / 7));
     
     // Re-enable lighting and depth test
     glEnable(GL_LIGHTING);
@@ -70,6 +139,17 @@ void Renderer::initialize() {
     glEnable(GL_DEPTH_TEST);
     glDepthFunc(GL_LEQUAL);
     glDisable(GL_CULL_FACE);  // Show all faces
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f); // Black background
+    
+    // Prefer the GL 3.3 shader path; fall back to fixed-function otherwise
+    int major = 0, minor = 0;
+    if (getGLVersion(major, minor) && (major > 3 || (major == 3 && minor >= 3)) &&
+        loadGLCoreFunctions() && shaderRenderer.initialize(stars)) {
+        useShaders = true;
+        return;
+    }
+    std::cerr << "Warning: OpenGL 3.3 unavailable, using fixed-function renderer." << std::endl;
+    useShaders = false;
     
     // Setup lighting
     glEnable(GL_LIGHTING);
@@ -89,8 +169,6 @@ void Renderer::initialize() {
     
     // Enable smooth shading for better reflections
     glShadeModel(GL_SMOOTH);
-    
-    glClearColor(0.0f, 0.0f, 0.0f, 1.0f); // Black background
 }
 
 // Set OpenGL color based on face color enum
@@ -125,12 +203,6 @@ void Renderer::drawFace(float x, float y, float z, float size, int faceIndex, in
     float s = size / 2.0f;
     float offset = 0.01f; // Small offset to make faces slightly protrude and avoid z-fighting
     
-    // Set material properties for highly reflective surface
-    GLfloat matSpecular[] = {1.0f, 1.0f, 1.0f, 1.0f}; // Maximum specular reflection
-    GLfloat matShininess[] = {128.0f}; // Maximum shininess for mirror-like reflection
-    glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, matSpecular);
-    glMaterialfv(GL_FRONT_AND_BACK, GL_SHININESS, matShininess);
-    
     glBegin(GL_QUADS);
     setColor(color);
     
@@ -179,6 +251,8 @@ void Renderer::drawFace(float x, float y, float z, float size, int faceIndex, in
             break;
     }
     glEnd();
+    PROFILE_COUNT(COUNTER_DRAW_CALLS, 1);
+    PROFILE_COUNT(COUNTER_VERTICES, 4);
 }
 
 // Draw cube edges (black lines)
@@ -208,19 +282,16 @@ void Renderer::drawCube(float x, float y, float z, float size) {
     glVertex3f(x - s, y - s, z + s); glVertex3f(x - s, y + s, z + s);
     
     glEnd();
+    PROFILE_COUNT(COUNTER_DRAW_CALLS, 1);
+    PROFILE_COUNT(COUNTER_VERTICES, 24);
 }
 
-// Main render function - sets up view and draws entire cube
-void Renderer::render(const RubikCube& cube, int windowWidth, int windowHeight, const AnimationState& anim) {
-    glViewport(0, 0, windowWidth, windowHeight);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    
-    glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
+// Compute projection and view matrices from window size and camera angles
+void Renderer::updateMatrices(int windowWidth, int windowHeight, float distanceScale) {
     float aspect = static_cast<float>(windowWidth) / static_cast<float>(windowHeight);
     float fov = 45.0f * M_PI / 180.0f;
     float nearPlane = 0.1f;
-    float farPlane = 100.0f;
+    float farPlane = 100.0f * distanceScale;
     float f = 1.0f / tan(fov / 2.0f);
     float frustum[16] = {
         f / aspect, 0.0f, 0.0f, 0.0f,
@@ -228,17 +299,17 @@ void Renderer::render(const RubikCube& cube, int windowWidth, int windowHeight,
         0.0f, 0.0f, (farPlane + nearPlane) / (nearPlane - farPlane), -1.0f,
         0.0f, 0.0f, (2.0f * farPlane * nearPlane) / (nearPlane - farPlane), 0.0f
     };
-    glMultMatrixf(frustum);
-    
-    glMatrixMode(GL_MODELVIEW);
-    glLoadIdentity();
+    std::copy(frustum, frustum + 16, projectionMatrix);
+    viewportWidth = windowWidth;
+    viewportHeight = windowHeight;
     
     // Camera positioning
     float radX = cameraAngleX * M_PI / 180.0f;
     float radY = cameraAngleY * M_PI / 180.0f;
-    float camX = cameraDistance * cos(radX) * sin(radY);
-    float camY = cameraDistance * sin(radX);
-    float camZ = cameraDistance * cos(radX) * cos(radY);
+    float distance = cameraDistance * distanceScale;
+    float camX = distance * cos(radX) * sin(radY);
+    float camY = distance * sin(radX);
+    float camZ = distance * cos(radX) * cos(radY);
     
     // Manual lookAt matrix
     float forward[3] = {-camX, -camY, -camZ};
@@ -260,20 +331,106 @@ void Renderer::render(const RubikCube& cube, int windowWidth, int windowHeight,
         right[0] * forward[1] - right[1] * forward[0]
     };
     
+    // Rotation rows followed by the camera translation (rotation * translate(-cam))
     float view[16] = {
         right[0], up2[0], -forward[0], 0.0f,
         right[1], up2[1], -forward[1], 0.0f,
         right[2], up2[2], -forward[2], 0.0f,
-        0.0f, 0.0f, 0.0f, 1.0f
+        -(right[0] * camX + right[1] * camY + right[2] * camZ),
+        -(up2[0] * camX + up2[1] * camY + up2[2] * camZ),
+        forward[0] * camX + forward[1] * camY + forward[2] * camZ,
+        1.0f
     };
-    glMultMatrixf(view);
-    glTranslatef(-camX, -camY, -camZ);
+    std::copy(view, view + 16, viewMatrix);
+}
+
+// Main render function - sets up view and draws entire cube
+void Renderer::render(const RubikCube& cube, int windowWidth, int windowHeight, const AnimationState& anim) {
+    PROFILE_SCOPE("Renderer::render");
+    glViewport(0, 0, windowWidth, windowHeight);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    
+    updateMatrices(windowWidth, windowHeight);
+    
+    if (!useShaders) {
+        renderLegacy(cube, anim);
+        return;
+    }
+    
+    updateSlice(anim);
+    if (sliceActive) {
+        int size = static_cast<int>(cube.getFaces()[0].size());
+        int layer = anim.face % 2 == 0 ? size - 1 : 0;  // R/U/F turn the positive-side layer
+        shaderRenderer.setSliceRotation(sliceAxis, layer, sliceSign * anim.currentAngle);
+    } else {
+        shaderRenderer.clearSliceRotation();
+    }
+    shaderRenderer.updateStickers(cube);
+    shaderRenderer.render(projectionMatrix, viewMatrix);
+}
+
+// Wall of cubes - the camera orbits at a distance proportional to the wall's size
+void Renderer::renderWall(const CubeWall& wall, int windowWidth, int windowHeight) {
+    PROFILE_SCOPE("Renderer::renderWall");
+    glViewport(0, 0, windowWidth, windowHeight);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    
+    // Default zoom (8) frames the whole wall
+    updateMatrices(windowWidth, windowHeight, std::max(1.0f, wall.getExtent() / 6.0f));
+    wall.cull(projectionMatrix, viewMatrix, WALL_LOD_DISTANCE, wallView);
+    
+    if (!useShaders) {
+        renderWallLegacy(wall);
+        return;
+    }
+    shaderRenderer.updateWall(wall);
+    shaderRenderer.renderWall(projectionMatrix, viewMatrix, wallView);
+}
+
+// Fixed-function wall - every visible cube as one box in its majority colors
+void Renderer::renderWallLegacy(const CubeWall& wall) {
+    PROFILE_SCOPE("Renderer::renderWallLegacy");
+    glMatrixMode(GL_PROJECTION);
+    glLoadMatrixf(projectionMatrix);
+    glMatrixMode(GL_MODELVIEW);
+    glLoadMatrixf(viewMatrix);
+    drawStars();
+    
+    const unsigned char* stickers = wall.stickerData();
+    const std::vector<WallInstance>* lists[2] = {&wallView.detailed, &wallView.distant};
+    for (const std::vector<WallInstance>* list : lists) {
+        for (const WallInstance& instance : *list) {
+            const unsigned char* colors = stickers + instance.cube * WALL_TEXELS + 54;
+            for (int face = 0; face < 6; face++) {
+                drawFace(instance.center[0], instance.center[1], instance.center[2], 2.95f, face, colors[face]);
+            }
+        }
+    }
+}
+
+// Fixed-function path - immediate mode, one cubie at a time
+void Renderer::renderLegacy(const RubikCube& cube, const AnimationState& anim) {
+    PROFILE_SCOPE("Renderer::renderLegacy");
+    glMatrixMode(GL_PROJECTION);
+    glLoadMatrixf(projectionMatrix);
+    
+    glMatrixMode(GL_MODELVIEW);
+    glLoadMatrixf(viewMatrix);
     
     // Draw background stars
     drawStars();
     
+    updateColorCache(cube);
+    updateSlice(anim);
+    float sliceAngle = sliceSign * anim.currentAngle;
+    
+    // Material is the same for every sticker - set it once per frame
+    GLfloat matSpecular[] = {1.0f, 1.0f, 1.0f, 1.0f}; // Maximum specular reflection
+    GLfloat matShininess[] = {128.0f}; // Maximum shininess for mirror-like reflection
+    glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, matSpecular);
+    glMaterialfv(GL_FRONT_AND_BACK, GL_SHININESS, matShininess);
+    
     // Draw all 27 cubies (3x3x3 grid)
-    const auto& faces = cube.getFaces();
     float cubieSize = 0.95f;
     float spacing = 1.0f;
     for (int x = -1; x <= 1; x++) {
@@ -283,132 +440,29 @@ void Renderer::render(const RubikCube& cube, int windowWidth, int windowHeight,
                 float posY = y * spacing;
                 float posZ = z * spacing;
                 
-                drawCubie(posX, posY, posZ, cubieSize, cube, x, y, z, anim);
+                drawCubie(posX, posY, posZ, cubieSize, (x + 1) * 9 + (y + 1) * 3 + (z + 1), sliceAngle);
             }
         }
     }
 }
 
-// Draw a single cubie with appropriate colors and rotation animation
-void Renderer::drawCubie(float x, float y, float z, float size, const RubikCube& cube, int cubieX, int cubieY, int cubieZ, const AnimationState& anim) {
-    const auto& faces = cube.getFaces();
-    bool isRotating = false;
-    float rotationAngle = 0.0f;
-    int rotationAxis = 0; // 0=X, 1=Y, 2=Z
-    float faceCenterX = 0.0f, faceCenterY = 0.0f, faceCenterZ = 0.0f;
-    
-    // Check if this cubie is part of the rotating face
-    if (anim.isAnimating) {
-        switch (anim.face) {
-            case RIGHT: // Rotate around X axis, x = 1
-                if (cubieX == 1) {
-                    isRotating = true;
-                    rotationAxis = 0;
-                    rotationAngle = anim.currentAngle;
-                    faceCenterX = 1.0f; faceCenterY = 0.0f; faceCenterZ = 0.0f;
-                }
-                break;
-            case LEFT: // Rotate around X axis, x = -1
-                if (cubieX == -1) {
-                    isRotating = true;
-                    rotationAxis = 0;
-                    rotationAngle = -anim.currentAngle; // Opposite direction
-                    faceCenterX = -1.0f; faceCenterY = 0.0f; faceCenterZ = 0.0f;
-                }
-                break;
-            case UP: // Rotate around Y axis, y = 1
-                if (cubieY == 1) {
-                    isRotating = true;
-                    rotationAxis = 1;
-                    rotationAngle = anim.currentAngle;
-                    faceCenterX = 0.0f; faceCenterY = 1.0f; faceCenterZ = 0.0f;
-                }
-                break;
-            case DOWN: // Rotate around Y axis, y = -1
-                if (cubieY == -1) {
-                    isRotating = true;
-                    rotationAxis = 1;
-                    rotationAngle = -anim.currentAngle;
-                    faceCenterX = 0.0f; faceCenterY = -1.0f; faceCenterZ = 0.0f;
-                }
-                break;
-            case FRONT: // Rotate around Z axis, z = 1
-                if (cubieZ == 1) {
-                    isRotating = true;
-                    rotationAxis = 2;
-                    rotationAngle = anim.currentAngle;
-                    faceCenterX = 0.0f; faceCenterY = 0.0f; faceCenterZ = 1.0f;
-                }
-                break;
-            case BACK: // Rotate around Z axis, z = -1
-                if (cubieZ == -1) {
-                    isRotating = true;
-                    rotationAxis = 2;
-                    rotationAngle = -anim.currentAngle;
-                    faceCenterX = 0.0f; faceCenterY = 0.0f; faceCenterZ = -1.0f;
-                }
-                break;
-        }
-    }
+// Draw a single cubie with cached colors; members of the rotating slice are rotated
+void Renderer::drawCubie(float x, float y, float z, float size, int cubieIndex, float sliceAngle) {
+    glPushMatrix();
     
     // Apply rotation if needed - rotate around face center, not cubie center
-    if (isRotating) {
-        glPushMatrix();
-        // Translate to face center
-        glTranslatef(faceCenterX, faceCenterY, faceCenterZ);
-        
-        // Rotate around the appropriate axis
-        switch (rotationAxis) {
-            case 0: // X axis
-                glRotatef(rotationAngle, 1.0f, 0.0f, 0.0f);
-                break;
-            case 1: // Y axis
-                glRotatef(rotationAngle, 0.0f, 1.0f, 0.0f);
-                break;
-            case 2: // Z axis
-                glRotatef(rotationAngle, 0.0f, 0.0f, 1.0f);
-                break;
-        }
-        
-        // Translate back from face center, then to cubie position
-        glTranslatef(-faceCenterX, -faceCenterY, -faceCenterZ);
-        glTranslatef(x, y, z);
-    } else {
-        // No rotation, just translate to cubie position
-        glPushMatrix();
-        glTranslatef(x, y, z);
+    if (sliceMembers[cubieIndex]) {
+        glTranslatef(sliceCenter[0], sliceCenter[1], sliceCenter[2]);
+        glRotatef(sliceAngle, sliceAxis == 0 ? 1.0f : 0.0f, sliceAxis == 1 ? 1.0f : 0.0f, sliceAxis == 2 ? 1.0f : 0.0f);
+        glTranslatef(-sliceCenter[0], -sliceCenter[1], -sliceCenter[2]);
     }
+    glTranslatef(x, y, z);
     
-    // Draw all 6 faces of the cubie with colors from cube state
-    // Right face (+X) - Red
-    int row = 1 - cubieY;
-    int col = 1 - cubieZ;
-    drawFace(0, 0, 0, size, 0, faces[RIGHT][row][col]);
-    
-    // Left face (-X) - Orange
-    row = 1 - cubieY;
-    col = cubieZ + 1;
-    drawFace(0, 0, 0, size, 1, faces[LEFT][row][col]);
-    
-    // Up face (+Y) - White
-    row = cubieZ + 1;
-    col = cubieX + 1;
-    drawFace(0, 0, 0, size, 2, faces[UP][row][col]);
-    
-    // Down face (-Y) - Yellow
-    row = 1 - cubieZ;
-    col = cubieX + 1;
-    drawFace(0, 0, 0, size, 3, faces[DOWN][row][col]);
-    
-    // Front face (+Z) - Green
-    row = 1 - cubieY;
-    col = cubieX + 1;
-    drawFace(0, 0, 0, size, 4, faces[FRONT][row][col]);
-    
-    // Back face (-Z) - Blue
-    row = 1 - cubieY;
-    col = 1 - cubieX;
-    drawFace(0, 0, 0, size, 5, faces[BACK][row][col]);
+    // Draw all 6 faces of the cubie with colors from the cache
+    const int* colors = colorCache[cubieIndex];
+    for (int face = 0; face < 6; face++) {
+        drawFace(0, 0, 0, size, face, colors[face]);
+    }
     
     // Draw black edges around cubie
     drawCube(0, 0, 0, size);
@@ -425,12 +479,40 @@ void Renderer::handleMouseDrag(int deltaX, int deltaY) {
     cameraAngleX = std::max(-89.0f, std::min(89.0f, cameraAngleX));
 }
 
+// Sticker under a pixel - ray cast on the CPU against the matrices the last frame was drawn with
+bool Renderer::pickSticker(int x, int y, StickerHit& hit) const {
+    PROFILE_SCOPE("Renderer::pickSticker");
+    PickRay ray;
+    if (!screenRay(projectionMatrix, viewMatrix, static_cast<float>(x), static_cast<float>(y),
+                   viewportWidth, viewportHeight, ray)) {
+        return false;
+    }
+    return ::pickSticker(ray, hit);
+}
+
+// Face turn for a drag from a picked sticker to the pixel under the mouse now
+bool Renderer::dragTurn(const StickerHit& start, int x, int y, int& face, bool& clockwise) const {
+    PickRay ray;
+    if (!screenRay(projectionMatrix, viewMatrix, static_cast<float>(x), static_cast<float>(y),
+                   viewportWidth, viewportHeight, ray)) {
+        return false;
+    }
+    return ::dragTurn(start, ray, face, clockwise);
+}
+
 // Handle mouse wheel for zoom in/out
 void Renderer::handleMouseWheel(int delta) {
     cameraDistance += delta * 0.2f;
     cameraDistance = std::max(3.0f, std::min(15.0f, cameraDistance));
 }
 
+// Set camera angles and distance, clamped to the interactive limits
+void Renderer::setCamera(float angleX, float angleY, float distance) {
+    cameraAngleX = std::max(-89.0f, std::min(89.0f, angleX));
+    cameraAngleY = angleY;
+    cameraDistance = std::max(3.0f, std::min(15.0f, distance));
+}
+
 // Reset camera to default position
 void Renderer::resetCamera() {
     cameraAngleX = 30.0f;
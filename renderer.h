@@ -7,6 +7,9 @@
 #include <SFML/Graphics.hpp>
 #include <SFML/OpenGL.hpp>
 #include "rubik_cube.h"
+#include "shader_renderer.h"
+#include "cube_wall.h"
+#include "cube_picker.h"
 #include <vector>
 
 // Animation state for smooth face rotations
@@ -27,11 +30,51 @@ private:
     float cameraAngleY;   // Horizontal camera rotation
     float cameraDistance; // Distance from cube
     
+    // Camera matrices for the current frame (column-major, OpenGL layout)
+    float projectionMatrix[16];
+    float viewMatrix[16];
+    int viewportWidth;
+    int viewportHeight;
+    
+    // Star vertices: x, y, z, r, g, b, point size
+    std::vector<float> stars;
+    
+    // GL 3.3 shader path, used when the context supports it
+    ShaderRenderer shaderRenderer;
+    bool useShaders;
+    
+    // Cubie -> sticker mapping (fixed), indexed [cubie][face]; cubie = (x+1)*9 + (y+1)*3 + (z+1)
+    StickerRef stickerTable[27][6];
+    
+    // Sticker colors per cubie face, rebuilt only when the cube state version changes
+    int colorCache[27][6];
+    const RubikCube* cachedCube;
+    unsigned int cachedVersion;
+    
+    // Rotating slice, recomputed only when an animation starts or ends
+    bool sliceMembers[27];
+    bool sliceActive;
+    int sliceFace;
+    int sliceAxis;      // 0=X, 1=Y, 2=Z
+    float sliceSign;    // sliceTurnSign(face): -1 for R/U/F, +1 for L/D/B
+    float sliceCenter[3];
+    
+    void buildStars();
+    void buildStickerTable();
+    void updateColorCache(const RubikCube& cube);
+    void updateSlice(const AnimationState& anim);
+    // Cube wall cubes visible this frame (rebuilt by renderWall)
+    WallView wallView;
+    
+    void updateMatrices(int windowWidth, int windowHeight, float distanceScale = 1.0f);
+    void renderLegacy(const RubikCube& cube, const AnimationState& anim);
+    void renderWallLegacy(const CubeWall& wall);
+    
     // Color mapping and drawing functions
     void setColor(int faceColor);
     void drawCube(float x, float y, float z, float size);
     void drawFace(float x, float y, float z, float size, int faceIndex, int color);
-    void drawCubie(float x, float y, float z, float size, const RubikCube& cube, int cubieX, int cubieY, int cubieZ, const AnimationState& anim);
+    void drawCubie(float x, float y, float z, float size, int cubieIndex, float sliceAngle);
     void drawStars();
     
 public:
@@ -39,6 +82,16 @@ public:
     
     void initialize();
     void render(const RubikCube& cube, int windowWidth, int windowHeight, const AnimationState& anim);
+    
+    // Wall mode: camera distance scaled to the wall, frustum culling and LOD, then two instanced
+    // draws (the fixed-function fallback draws every visible cube as a box)
+    void renderWall(const CubeWall& wall, int windowWidth, int windowHeight);
+    const WallView& getWallView() const { return wallView; }
+    
+    // Mouse picking against the camera of the last cube frame; pixel coordinates, top-left origin
+    bool pickSticker(int x, int y, StickerHit& hit) const;
+    bool dragTurn(const StickerHit& start, int x, int y, int& face, bool& clockwise) const;
+    
     void handleMouseDrag(int deltaX, int deltaY);
     void handleMouseWheel(int delta);
     void resetCamera();
@@ -46,6 +99,13 @@ public:
     // Get camera angles for UI
     float getCameraAngleX() const { return cameraAngleX; }
     float getCameraAngleY() const { return cameraAngleY; }
+    float getCameraDistance() const { return cameraDistance; }
+    
+    // Set camera directly (session replay); values are clamped like user input
+    void setCamera(float angleX, float angleY, float distance);
+    
+    // Whether the shader path is active (false = fixed-function fallback)
+    bool isUsingShaders() const { return useShaders; }
 };
 
 #endif // RENDERER_H
@@ -0,0 +1,121 @@
+// Resource Loader Implementation
+// Font candidates per platform, optional fontconfig lookup, loader thread
+
+#include "resource_loader.h"
+#include "profiler.h"
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+
+#ifdef RUBIK_HAVE_FONTCONFIG
+#include <fontconfig/fontconfig.h>
+#endif
+
+namespace {
+
+const char* const BUNDLED_FONT = "assets/fonts/ui.ttf";
+
+const char* const SYSTEM_FONTS[] = {
+#if defined(_WIN32)
+    "C:/Windows/Fonts/arial.ttf",
+    "C:/Windows/Fonts/segoeui.ttf",
+    "C:/Windows/Fonts/calibri.ttf",
+#elif defined(__APPLE__)
+    "/System/Library/Fonts/Supplemental/Arial.ttf",
+    "/Library/Fonts/Arial.ttf",
+    "/System/Library/Fonts/Helvetica.ttc",
+#else
+    "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",        // Debian, Ubuntu
+    "/usr/share/fonts/dejavu-sans-fonts/DejaVuSans.ttf",      // Fedora
+    "/usr/share/fonts/TTF/DejaVuSans.ttf",                    // Arch
+    "/usr/share/fonts/dejavu/DejaVuSans.ttf",
+    "/usr/share/fonts/truetype/liberation/LiberationSans-Regular.ttf",
+    "/usr/share/fonts/liberation-sans/LiberationSans-Regular.ttf",
+    "/usr/share/fonts/truetype/noto/NotoSans-Regular.ttf",
+    "/usr/share/fonts/noto/NotoSans-Regular.ttf",
+#endif
+};
+
+std::string directoryOf(const std::string& path) {
+    std::size_t slash = path.find_last_of("/\\");
+    return slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+}
+
+#ifdef RUBIK_HAVE_FONTCONFIG
+// Best scalable sans-serif match; fontconfig's first call parses its cache (tens of ms)
+bool fontconfigMatch(std::string& path) {
+    PROFILE_SCOPE("ResourceLoader::fontconfig");
+    if (!FcInit()) return false;
+    FcPattern* pattern = FcNameParse(reinterpret_cast<const FcChar8*>("sans-serif:style=Regular:scalable=true"));
+    if (!pattern) return false;
+    FcConfigSubstitute(nullptr, pattern, FcMatchPattern);
+    FcDefaultSubstitute(pattern);
+    FcResult result;
+    FcPattern* match = FcFontMatch(nullptr, pattern, &result);
+    FcChar8* file = nullptr;
+    bool found = match && FcPatternGetString(match, FC_FILE, 0, &file) == FcResultMatch;
+    if (found) path = reinterpret_cast<const char*>(file);
+    if (match) FcPatternDestroy(match);
+    FcPatternDestroy(pattern);
+    return found;
+}
+#endif
+
+bool readFile(const std::string& path, std::vector<unsigned char>& data) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return !data.empty();
+}
+
+} // namespace
+
+std::vector<std::string> fontCandidates(const std::string& executablePath) {
+    std::vector<std::string> candidates;
+    if (const char* fromEnvironment = std::getenv("RUBIK_FONT")) candidates.push_back(fromEnvironment);
+    std::string executableDir = directoryOf(executablePath);
+    if (!executableDir.empty()) candidates.push_back(executableDir + BUNDLED_FONT);
+    candidates.push_back(BUNDLED_FONT);
+    for (const char* path : SYSTEM_FONTS) candidates.push_back(path);
+    return candidates;
+}
+
+// ResourceLoader
+ResourceLoader::ResourceLoader() : fontDone(false), allDone(false), font() {}
+
+ResourceLoader::~ResourceLoader() {
+    if (worker.joinable()) worker.join();
+}
+
+void ResourceLoader::start(const std::string& executablePath, std::function<void()> warmUp) {
+    worker = std::thread([this, executablePath, warmUp] {
+        {
+            PROFILE_SCOPE("ResourceLoader::font");
+            auto start = std::chrono::steady_clock::now();
+            for (const std::string& candidate : fontCandidates(executablePath)) {
+                if (readFile(candidate, font.data)) {
+                    font.path = candidate;
+                    break;
+                }
+            }
+#ifdef RUBIK_HAVE_FONTCONFIG
+            // Last resort, so the usual startup never pays for fontconfig's cache
+            std::string matched;
+            if (font.data.empty() && fontconfigMatch(matched) && readFile(matched, font.data)) font.path = matched;
+#endif
+            font.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+        fontDone.store(true, std::memory_order_release);
+
+        if (warmUp) {
+            PROFILE_SCOPE("ResourceLoader::warmUp");
+            warmUp();
+        }
+        allDone.store(true, std::memory_order_release);
+    });
+}
+
+void ResourceLoader::wait() {
+    if (worker.joinable()) worker.join();
+}
@@ -0,0 +1,54 @@
+// Resource Loader Header
+// Background font discovery / loading and startup warm-up, so the first frame never waits
+//
+// Font search order: $RUBIK_FONT, a bundled assets/fonts/ui.ttf (next to the executable or
+// in the working directory), well-known system fonts for Windows, macOS and common Linux
+// distributions, then fontconfig's "sans-serif" match when built with fontconfig. The file
+// is read into memory on the loader thread; the game only hands the bytes to sf::Font.
+
+#ifndef RESOURCE_LOADER_H
+#define RESOURCE_LOADER_H
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct FontAsset {
+    std::string path;                 // Empty if no font was found
+    std::vector<unsigned char> data;  // Must outlive any sf::Font loaded from it
+    double milliseconds;              // Discovery + read time on the loader thread
+};
+
+// Fixed candidate font files in search order (existence is not checked); fontconfig comes after
+// these and is only queried when none of them can be read
+std::vector<std::string> fontCandidates(const std::string& executablePath);
+
+class ResourceLoader {
+private:
+    std::thread worker;
+    std::atomic<bool> fontDone;
+    std::atomic<bool> allDone;
+    FontAsset font;
+
+public:
+    ResourceLoader();
+    ~ResourceLoader();
+    ResourceLoader(const ResourceLoader&) = delete;
+    ResourceLoader& operator=(const ResourceLoader&) = delete;
+
+    // Load the font, then run warmUp (table builds etc.), on a background thread
+    void start(const std::string& executablePath, std::function<void()> warmUp = nullptr);
+
+    // Block until the font and warm-up are done (headless runs need the same first frame every time)
+    void wait();
+
+    bool fontReady() const { return fontDone.load(std::memory_order_acquire); }
+    bool finished() const { return allDone.load(std::memory_order_acquire); }
+
+    // Only valid once fontReady()
+    const FontAsset& getFont() const { return font; }
+};
+
+#endif // RESOURCE_LOADER_H
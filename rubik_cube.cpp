@@ -2,12 +2,13 @@
 // Contains all rotation logic and cube state management
 
 #include "rubik_cube.h"
+#include "profiler.h"
 #include <algorithm>
 #include <random>
 #include <ctime>
 
 // Constructor - initialize cube to solved state
-RubikCube::RubikCube() {
+RubikCube::RubikCube() : version(0) {
     faces.resize(6);
     // Initialize each face with its correct color
     // RIGHT=0 -> RED, LEFT=1 -> ORANGE, UP=2 -> WHITE, DOWN=3 -> YELLOW, FRONT=4 -> GREEN, BACK=5 -> BLUE
@@ -30,6 +31,7 @@ void RubikCube::reset() {
             }
         }
     }
+    version++;
 }
 
 // Rotate a single face 90 degrees clockwise
@@ -56,6 +58,7 @@ void RubikCube::rotateFaceCounterClockwise(int face) {
 
 // Rotate right face clockwise (R move)
 void RubikCube::rotateR() {
+    version++;
     rotateFaceClockwise(RIGHT);
     
     // Rotate adjacent edge pieces
@@ -79,6 +82,7 @@ void RubikCube::rotateR() {
 
 // Rotate left face clockwise (L move)
 void RubikCube::rotateL() {
+    version++;
     rotateFaceClockwise(LEFT);
     
     // Rotate adjacent edge pieces
@@ -102,6 +106,7 @@ void RubikCube::rotateL() {
 
 // Rotate up face clockwise (U move)
 void RubikCube::rotateU() {
+    version++;
     rotateFaceClockwise(UP);
     
     // Rotate adjacent edge pieces
@@ -125,6 +130,7 @@ void RubikCube::rotateU() {
 
 // Rotate down face clockwise (D move)
 void RubikCube::rotateD() {
+    version++;
     rotateFaceClockwise(DOWN);
     
     // Rotate adjacent edge pieces
@@ -148,6 +154,7 @@ void RubikCube::rotateD() {
 
 // Rotate front face clockwise (F move)
 void RubikCube::rotateF() {
+    version++;
     rotateFaceClockwise(FRONT);
     
     // Rotate adjacent edge pieces
@@ -171,6 +178,7 @@ void RubikCube::rotateF() {
 
 // Rotate back face clockwise (B move)
 void RubikCube::rotateB() {
+    version++;
     rotateFaceClockwise(BACK);
     
     // Rotate adjacent edge pieces
@@ -222,56 +230,86 @@ void RubikCube::rotateBPrime() {
     rotateB(); rotateB(); rotateB();
 }
 
-// Apply move from standard notation (e.g., "R", "R'", "U")
+// Parse standard notation into a move index
+int parseMove(const std::string& move) {
+    static const char faceLetters[] = "RLUDFB";
+    if (move.empty() || move.size() > 2) return -1;
+    
+    const char* letter = std::char_traits<char>::find(faceLetters, 6, move[0]);
+    if (!letter) return -1;
+    int face = static_cast<int>(letter - faceLetters);
+    
+    if (move.size() == 1) return face * 3;
+    if (move[1] == '2') return face * 3 + 1;
+    if (move[1] == '\'') return face * 3 + 2;
+    return -1;
+}
+
+// Move index back to standard notation
+std::string moveToString(int move) {
+    static const char faceLetters[] = "RLUDFB";
+    static const char* suffixes[] = {"", "2", "'"};
+    if (move < 0 || move >= NUM_MOVES) return "";
+    return std::string(1, faceLetters[move / 3]) + suffixes[move % 3];
+}
+
+// Uniform quarter turns from a seeded mt19937, same sequence on every platform
+void scrambleMoves(int numMoves, unsigned int seed, std::vector<int>& moves) {
+    static const int quarterTurns[] = {0, 2, 3, 5, 6, 8, 9, 11, 12, 14, 15, 17};  // R R' L L' ... B B'
+    std::mt19937 rng(seed);
+    moves.resize(numMoves > 0 ? numMoves : 0);
+    for (int& move : moves) {
+        move = quarterTurns[rng() % 12];
+    }
+}
+
+// Apply move from standard notation (e.g., "R", "R'", "U", "U2")
 bool RubikCube::applyMove(const std::string& move) {
-    if (move == "R") {
-        rotateR();
-        return true;
-    } else if (move == "R'" || move == "R'") {
-        rotateRPrime();
-        return true;
-    } else if (move == "L") {
-        rotateL();
-        return true;
-    } else if (move == "L'" || move == "L'") {
-        rotateLPrime();
-        return true;
-    } else if (move == "U") {
-        rotateU();
-        return true;
-    } else if (move == "U'" || move == "U'") {
-        rotateUPrime();
-        return true;
-    } else if (move == "D") {
-        rotateD();
-        return true;
-    } else if (move == "D'" || move == "D'") {
-        rotateDPrime();
-        return true;
-    } else if (move == "F") {
-        rotateF();
-        return true;
-    } else if (move == "F'" || move == "F'") {
-        rotateFPrime();
-        return true;
-    } else if (move == "B") {
-        rotateB();
-        return true;
-    } else if (move == "B'" || move == "B'") {
-        rotateBPrime();
-        return true;
-    }
-    return false;
+    return applyMoveIndex(parseMove(move));
 }
 
-// Scramble cube with random moves
-void RubikCube::scramble(int numMoves) {
-    std::vector<std::string> moves = {"R", "R'", "L", "L'", "U", "U'", "D", "D'", "F", "F'", "B", "B'"};
-    std::mt19937 rng(static_cast<unsigned int>(std::time(nullptr)));
-    std::uniform_int_distribution<int> dist(0, moves.size() - 1);
+// Apply move by index - quarter turns use the clockwise rotations
+bool RubikCube::applyMoveIndex(int move) {
+    if (move < 0 || move >= NUM_MOVES) return false;
+    
+    typedef void (RubikCube::*Rotation)();
+    static const Rotation clockwise[6] = {
+        &RubikCube::rotateR, &RubikCube::rotateL, &RubikCube::rotateU,
+        &RubikCube::rotateD, &RubikCube::rotateF, &RubikCube::rotateB
+    };
+    static const Rotation counterClockwise[6] = {
+        &RubikCube::rotateRPrime, &RubikCube::rotateLPrime, &RubikCube::rotateUPrime,
+        &RubikCube::rotateDPrime, &RubikCube::rotateFPrime, &RubikCube::rotateBPrime
+    };
     
-    for (int i = 0; i < numMoves; i++) {
-        applyMove(moves[dist(rng)]);
+    int face = move / 3;
+    switch (move % 3) {
+        case 0:
+            (this->*clockwise[face])();
+            break;
+        case 1:
+            (this->*clockwise[face])();
+            (this->*clockwise[face])();
+            break;
+        case 2:
+            (this->*counterClockwise[face])();
+            break;
+    }
+    return true;
+}
+
+// Scramble cube with random moves, seeded from the clock
+void RubikCube::scramble(int numMoves) {
+    scramble(numMoves, static_cast<unsigned int>(std::time(nullptr)));
+}
+
+// Scramble cube with random moves from a fixed seed (reproducible on every platform)
+void RubikCube::scramble(int numMoves, unsigned int seed) {
+    PROFILE_SCOPE("RubikCube::scramble");
+    std::vector<int> moves;
+    scrambleMoves(numMoves, seed, moves);
+    for (int move : moves) {
+        applyMoveIndex(move);
     }
 }
 
@@ -296,8 +334,13 @@ int RubikCube::getColor(int face, int row, int col) const {
     return faces[face][row][col];
 }
 
+// Set color at specific position
+void RubikCube::setColor(int face, int row, int col, int color) {
+    faces[face][row][col] = color;
+    version++;
+}
+
 // Get all faces (for rendering)
 const std::vector<std::vector<std::vector<int>>>& RubikCube::getFaces() const {
     return faces;
 }
-
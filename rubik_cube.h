@@ -27,12 +27,57 @@ enum FaceIndex {
     BACK = 5
 };
 
+// Move indices for compact encodings: face * 3 + (quarter turns - 1)
+// e.g. 0=R, 1=R2, 2=R', 3=L, ... 17=B' (faces in FaceIndex order)
+constexpr int NUM_MOVES = 18;
+
+// Parse "R", "R'" or "R2" into a move index; returns -1 if not a valid move
+int parseMove(const std::string& move);
+
+// Standard notation for a move index ("R", "R2", "R'")
+std::string moveToString(int move);
+
+// Move sequence used by RubikCube::scramble for a seed (uniform quarter turns)
+void scrambleMoves(int numMoves, unsigned int seed, std::vector<int>& moves);
+
+// Sticker shown on one face of a cubie: faces[face][row][col]
+struct StickerRef {
+    int face;
+    int row;
+    int col;
+};
+
+// Sticker the cubie at grid position (x, y, z), each -1..1, shows on `face`; only meaningful
+// when the cubie lies on that face (+X = RIGHT, +Y = UP, +Z = FRONT). Used by the renderers
+// and, at compile time, by the move and symmetry tables.
+constexpr StickerRef cubieSticker(int x, int y, int z, int face) {
+    switch (face) {
+        case RIGHT: return {RIGHT, 1 - y, 1 - z};
+        case LEFT:  return {LEFT, 1 - y, z + 1};
+        case UP:    return {UP, z + 1, x + 1};
+        case DOWN:  return {DOWN, 1 - z, x + 1};
+        case FRONT: return {FRONT, 1 - y, x + 1};
+        default:    return {BACK, 1 - y, 1 - x};
+    }
+}
+
+// Direction a face turn is animated in: the slice turns by sliceTurnSign(face) * angle degrees
+// about its axis (right-handed), with angle > 0 for a clockwise turn. A clockwise R seen from
+// +X is a right-handed -90 degree turn about X (F -> U), so R/U/F turn by -angle and L/D/B,
+// looked at from the other side, by +angle.
+constexpr int sliceTurnSign(int face) {
+    return face % 2 == 0 ? -1 : 1;
+}
+
 // Rubik's Cube class - manages cube state and rotations
 class RubikCube {
 private:
     // 6 faces, each is 3x3 grid of colors
     std::vector<std::vector<std::vector<int>>> faces;
     
+    // Incremented on every state change so caches can detect edits
+    unsigned int version;
+    
     // Helper functions for face and edge rotations
     void rotateFaceClockwise(int face);
     void rotateFaceCounterClockwise(int face);
@@ -61,11 +106,15 @@ public:
     void rotateFPrime();  // Front face counter-clockwise
     void rotateBPrime();  // Back face counter-clockwise
     
-    // Apply move from string notation (e.g., "R", "R'", "U", "U'")
+    // Apply move from string notation (e.g., "R", "R'", "U", "U'", "U2")
     bool applyMove(const std::string& move);
     
-    // Scramble the cube
+    // Apply move by index (see NUM_MOVES); returns false if out of range
+    bool applyMoveIndex(int move);
+    
+    // Scramble the cube (seeded from the clock, or with an explicit seed for replay)
     void scramble(int numMoves = 25);
+    void scramble(int numMoves, unsigned int seed);
     
     // Check if cube is solved
     bool isSolved() const;
@@ -73,8 +122,14 @@ public:
     // Get face color at position (face, row, col)
     int getColor(int face, int row, int col) const;
     
+    // Set a single sticker (used when loading states from other representations)
+    void setColor(int face, int row, int col, int color);
+    
     // Get all faces (for rendering)
     const std::vector<std::vector<std::vector<int>>>& getFaces() const;
+    
+    // State version - changes whenever the sticker layout changes
+    unsigned int getVersion() const { return version; }
 };
 
 #endif // RUBIK_CUBE_H
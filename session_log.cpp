@@ -0,0 +1,222 @@
+// Session Log Implementation
+// Varint record encoding, background writer thread and mapped reader
+
+#include "session_log.h"
+#include "rubik_cube.h"
+#include <cmath>
+#include <cstring>
+#include <ctime>
+
+namespace {
+
+const char LOG_MAGIC[8] = {'R', 'B', 'K', 'L', 'O', 'G', '0', '1'};
+const std::size_t FLUSH_THRESHOLD = 64 * 1024;          // Wake the writer early past this size
+const std::chrono::milliseconds FLUSH_INTERVAL(250);    // Otherwise write out every 250 ms
+
+} // namespace
+
+// Append a LEB128 varint
+void writeVarint(std::vector<unsigned char>& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<unsigned char>(value));
+}
+
+// Read a LEB128 varint; fails on truncation or overlong encodings
+bool readVarint(const unsigned char* data, std::size_t size, std::size_t& offset, std::uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && offset < size; shift += 7) {
+        unsigned char byte = data[offset++];
+        if (shift == 63 && byte > 1) return false;          // Bits past the 64th
+        value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return byte != 0 || shift == 0;  // A trailing zero group is redundant
+    }
+    return false;
+}
+
+SessionRecorder::SessionRecorder() : file(nullptr), stopping(false) {}
+
+SessionRecorder::~SessionRecorder() {
+    close();
+}
+
+// Open in append mode; the magic starts a new file and marks every appended session, so a
+// reader can resync after a record cut short by a crash
+bool SessionRecorder::open(const std::string& path) {
+    close();
+    file = std::fopen(path.c_str(), "ab");
+    if (!file) return false;
+
+    ioBuffer.resize(1 << 20);
+    std::setvbuf(file, ioBuffer.data(), _IOFBF, ioBuffer.size());
+    std::fwrite(LOG_MAGIC, 1, sizeof(LOG_MAGIC), file);
+
+    stopping = false;
+    pending.reserve(FLUSH_THRESHOLD * 2);
+    writing.reserve(FLUSH_THRESHOLD * 2);
+    lastEvent = std::chrono::steady_clock::now();
+    writer = std::thread(&SessionRecorder::writerLoop, this);
+
+    std::uint64_t wallClock = static_cast<std::uint64_t>(std::time(nullptr));
+    append(EVENT_SESSION_START, &wallClock, 1);
+    return true;
+}
+
+// Stop the writer after it drains everything, then close the file
+void SessionRecorder::close() {
+    if (!file) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    writer.join();
+    std::fclose(file);
+    file = nullptr;
+}
+
+// Writer thread - swaps buffers under the lock, writes outside it
+void SessionRecorder::writerLoop() {
+    for (;;) {
+        bool done;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait_for(lock, FLUSH_INTERVAL, [this] { return stopping || pending.size() >= FLUSH_THRESHOLD; });
+            pending.swap(writing);
+            done = stopping;
+        }
+        if (!writing.empty()) {
+            std::fwrite(writing.data(), 1, writing.size(), file);
+            std::fflush(file);
+            writing.clear();
+        }
+        if (done) return;
+    }
+}
+
+// Encode one record into the pending buffer (called from the game loop)
+void SessionRecorder::append(int code, const std::uint64_t* values, int valueCount) {
+    if (!file) return;
+    auto now = std::chrono::steady_clock::now();
+    bool wakeWriter;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::uint64_t delta = std::chrono::duration_cast<std::chrono::microseconds>(now - lastEvent).count();
+        lastEvent = now;
+        writeVarint(pending, delta);
+        pending.push_back(static_cast<unsigned char>(code));
+        for (int i = 0; i < valueCount; i++) {
+            writeVarint(pending, values[i]);
+        }
+        wakeWriter = pending.size() >= FLUSH_THRESHOLD;
+    }
+    if (wakeWriter) wake.notify_one();
+}
+
+void SessionRecorder::logMove(int move) {
+    if (move < 0 || move >= NUM_MOVES) return;
+    append(move, nullptr, 0);
+}
+
+void SessionRecorder::logScramble(std::uint32_t seed, std::uint32_t count) {
+    std::uint64_t values[2] = {seed, count};
+    append(EVENT_SCRAMBLE, values, 2);
+}
+
+void SessionRecorder::logReset() {
+    append(EVENT_RESET, nullptr, 0);
+}
+
+void SessionRecorder::logCamera(float angleX, float angleY, float distance) {
+    std::uint64_t values[3] = {
+        zigzagEncode(std::lround(angleX * 100.0f)),
+        zigzagEncode(std::lround(angleY * 100.0f)),
+        zigzagEncode(std::lround(distance * 100.0f))
+    };
+    append(EVENT_CAMERA, values, 3);
+}
+
+SessionReader::SessionReader() : offset(0), clock(0) {}
+
+// Map the log and check the magic
+bool SessionReader::open(const std::string& path) {
+    if (!mapping.open(path)) return false;
+    if (mapping.size() < sizeof(LOG_MAGIC) || std::memcmp(mapping.data(), LOG_MAGIC, sizeof(LOG_MAGIC)) != 0) {
+        mapping.close();
+        return false;
+    }
+    rewind();
+    return true;
+}
+
+void SessionReader::rewind() {
+    offset = sizeof(LOG_MAGIC);
+    clock = 0;
+}
+
+// First magic starting in [from, limit), or npos
+std::size_t SessionReader::findMagic(std::size_t from, std::size_t limit) const {
+    const unsigned char* data = mapping.data();
+    for (std::size_t i = from; i < limit && i + sizeof(LOG_MAGIC) <= mapping.size(); i++) {
+        if (std::memcmp(data + i, LOG_MAGIC, sizeof(LOG_MAGIC)) == 0) return i;
+    }
+    return std::string::npos;
+}
+
+// Skips the magic before each appended session. A valid record never contains the magic (its
+// bytes are all invalid codes and a record has at most four bytes between codes), so a record
+// that fails to decode or runs into one was cut short: drop it and resume at that session.
+bool SessionReader::next(SessionEvent& event) {
+    for (;;) {
+        if (findMagic(offset, offset + 1) == offset) offset += sizeof(LOG_MAGIC);
+        std::size_t start = offset;
+        bool decoded = decode(event);
+        std::size_t marker = findMagic(start + 1, decoded ? offset : mapping.size());
+        if (marker == std::string::npos) return decoded;
+        offset = marker;
+    }
+}
+
+// Decode one record in place from the mapping
+bool SessionReader::decode(SessionEvent& event) {
+    const unsigned char* data = mapping.data();
+    std::size_t size = mapping.size();
+    std::uint64_t delta;
+    if (!readVarint(data, size, offset, delta) || offset >= size) return false;
+
+    int code = data[offset++];
+    event = SessionEvent();
+    clock += delta;
+
+    if (code < NUM_MOVES) {
+        event.type = EVENT_MOVE;
+        event.move = code;
+    } else if (code == EVENT_SCRAMBLE) {
+        std::uint64_t seed, count;
+        if (!readVarint(data, size, offset, seed) || !readVarint(data, size, offset, count)) return false;
+        event.type = EVENT_SCRAMBLE;
+        event.seed = static_cast<std::uint32_t>(seed);
+        event.count = static_cast<std::uint32_t>(count);
+    } else if (code == EVENT_RESET) {
+        event.type = EVENT_RESET;
+    } else if (code == EVENT_CAMERA) {
+        event.type = EVENT_CAMERA;
+        for (int i = 0; i < 3; i++) {
+            std::uint64_t value;
+            if (!readVarint(data, size, offset, value)) return false;
+            event.camera[i] = zigzagDecode(value) / 100.0f;
+        }
+    } else if (code == EVENT_SESSION_START) {
+        std::uint64_t wallClock;
+        if (!readVarint(data, size, offset, wallClock)) return false;
+        event.type = EVENT_SESSION_START;
+        event.wallClock = wallClock;
+        clock = 0;
+    } else {
+        return false;
+    }
+    event.time = clock;
+    return true;
+}
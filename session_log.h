@@ -0,0 +1,107 @@
+// Session Log Header
+// Append-only binary log of moves, scrambles and camera changes, plus a replay reader
+//
+// File layout: 8-byte magic "RBKLOG01", then records. Each record is
+//   varint  microseconds since the previous record
+//   byte    code: 0..17 = move index, or one of the SessionEventType codes below
+//   payload depending on the code (varints; camera values are zigzag varints in 1/100 units)
+// Every recording appended to the file starts with the magic again, then a SESSION_START record.
+
+#ifndef SESSION_LOG_H
+#define SESSION_LOG_H
+
+#include "mapped_file.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum SessionEventType {
+    EVENT_MOVE = 0,             // Codes 0..17 (move index)
+    EVENT_SCRAMBLE = 18,        // varint seed, varint move count
+    EVENT_RESET = 19,           // no payload
+    EVENT_CAMERA = 20,          // zigzag angleX, angleY, distance (x100)
+    EVENT_SESSION_START = 21    // varint wall-clock time (seconds since epoch)
+};
+
+// One decoded record
+struct SessionEvent {
+    SessionEventType type;
+    std::uint64_t time;         // Microseconds since the start of the session
+    int move;                   // EVENT_MOVE
+    std::uint32_t seed;         // EVENT_SCRAMBLE
+    std::uint32_t count;        // EVENT_SCRAMBLE
+    float camera[3];            // EVENT_CAMERA: angleX, angleY, distance
+    std::uint64_t wallClock;    // EVENT_SESSION_START
+};
+
+// Recorder - encodes on the caller's thread, writes on a background thread
+class SessionRecorder {
+private:
+    std::FILE* file;
+    std::vector<unsigned char> pending;   // Filled by the game loop
+    std::vector<unsigned char> writing;   // Drained by the writer thread
+    std::vector<char> ioBuffer;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::thread writer;
+    bool stopping;
+    std::chrono::steady_clock::time_point lastEvent;
+
+    void writerLoop();
+    void append(int code, const std::uint64_t* values, int valueCount);
+
+public:
+    SessionRecorder();
+    ~SessionRecorder();
+
+    // Open (or create) a log and append a new session to it
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return file != nullptr; }
+
+    void logMove(int move);
+    void logScramble(std::uint32_t seed, std::uint32_t count);
+    void logReset();
+    void logCamera(float angleX, float angleY, float distance);
+};
+
+// Reader - walks a memory-mapped log without copying it
+class SessionReader {
+private:
+    MappedFile mapping;
+    std::size_t offset;
+    std::uint64_t clock;
+
+    std::size_t findMagic(std::size_t from, std::size_t limit) const;
+    bool decode(SessionEvent& event);
+
+public:
+    SessionReader();
+
+    // Map a log and validate its header
+    bool open(const std::string& path);
+
+    // Decode the next record, skipping any record cut short before an appended session;
+    // returns false at end of file or on a truncated final record
+    bool next(SessionEvent& event);
+
+    // Restart from the first record
+    void rewind();
+};
+
+// Varint helpers shared by the log and other binary formats
+void writeVarint(std::vector<unsigned char>& out, std::uint64_t value);
+bool readVarint(const unsigned char* data, std::size_t size, std::size_t& offset, std::uint64_t& value);
+inline std::uint64_t zigzagEncode(std::int64_t value) {
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+inline std::int64_t zigzagDecode(std::uint64_t value) {
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+#endif // SESSION_LOG_H
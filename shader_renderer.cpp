@@ -0,0 +1,651 @@
+// Shader Renderer Implementation
+// Builds the GL 3.3 pipeline and draws all cubies with a single instanced call
+
+#include "shader_renderer.h"
+#include "profiler.h"
+#include <cstring>
+#include <iostream>
+#include <string>
+
+namespace {
+
+constexpr int WALL_CUBES_PER_ROW = 16;  // Keeps the wall sticker texture under 1024 wide
+
+// Uniform block shared by every shader stage
+const char* FRAME_BLOCK = R"(
+layout(std140) uniform Frame {
+    mat4 uProjection;
+    mat4 uView;
+    vec4 uLightPosition;
+    vec4 uPalette[8];
+    ivec4 uSlice;
+    vec4 uParams;
+};
+)";
+
+// Helpers for every cubie vertex shader: slice rotation and the sticker a cubie face
+// shows (row, column on that face), with the same mapping as cubieSticker
+const char* CUBIE_FUNCTIONS = R"(
+vec3 rotateAxis(vec3 v, int axis, float angle) {
+    float c = cos(angle);
+    float s = sin(angle);
+    if (axis == 0) return vec3(v.x, c * v.y - s * v.z, s * v.y + c * v.z);
+    if (axis == 1) return vec3(c * v.x + s * v.z, v.y, -s * v.x + c * v.z);
+    return vec3(c * v.x - s * v.y, s * v.x + c * v.y, v.z);
+}
+
+bool stickerCell(ivec3 c, int face, int n, out ivec2 rc) {
+    int last = n - 1;
+    bool outer;
+    if (face == 0) { outer = c.x == last; rc = ivec2(last - c.y, last - c.z); }
+    else if (face == 1) { outer = c.x == 0; rc = ivec2(last - c.y, c.z); }
+    else if (face == 2) { outer = c.y == last; rc = ivec2(c.z, c.x); }
+    else if (face == 3) { outer = c.y == 0; rc = ivec2(last - c.z, c.x); }
+    else if (face == 4) { outer = c.z == last; rc = ivec2(last - c.y, c.x); }
+    else { outer = c.z == 0; rc = ivec2(last - c.y, last - c.x); }
+    return outer;
+}
+)";
+
+// Cubie vertex shader: places the instance on the grid, applies the slice
+// rotation and resolves the sticker color with the same mapping as drawCubie
+const char* CUBE_VERTEX_SOURCE = R"(
+layout(location = 0) in vec3 aPosition;
+layout(location = 1) in vec3 aNormal;
+layout(location = 2) in vec2 aUV;
+layout(location = 3) in int aFace;
+layout(location = 4) in ivec3 aCubie;
+
+uniform usampler2D uStickers;
+
+out vec3 vViewPosition;
+out vec3 vViewNormal;
+out vec2 vUV;
+flat out vec3 vColor;
+
+int stickerColor(ivec3 c, int face, int n) {
+    ivec2 rc;
+    if (!stickerCell(c, face, n, rc)) return 6;
+    return int(texelFetch(uStickers, ivec2(rc.x * n + rc.y, face), 0).r);
+}
+
+void main() {
+    int n = uSlice.w;
+    vec3 center = (vec3(aCubie) - vec3(float(n - 1) * 0.5)) * uParams.z;
+    vec3 position = center + aPosition * uParams.y;
+    vec3 normal = aNormal;
+    if (uSlice.z != 0 && aCubie[uSlice.x] == uSlice.y) {
+        float angle = radians(uParams.x);
+        position = rotateAxis(position, uSlice.x, angle);
+        normal = rotateAxis(normal, uSlice.x, angle);
+    }
+    vec4 viewPosition = uView * vec4(position, 1.0);
+    vViewPosition = viewPosition.xyz;
+    vViewNormal = mat3(uView) * normal;
+    vUV = aUV;
+    vColor = uPalette[stickerColor(aCubie, aFace, n)].rgb;
+    gl_Position = uProjection * viewPosition;
+}
+)";
+
+// Cubie fragment shader: Blinn-Phong matching the fixed-function light setup,
+// with a dark sticker border in place of the legacy edge lines
+const char* CUBE_FRAGMENT_SOURCE = R"(
+in vec3 vViewPosition;
+in vec3 vViewNormal;
+in vec2 vUV;
+flat in vec3 vColor;
+
+out vec4 fragColor;
+
+void main() {
+    vec2 edge = min(vUV, vec2(1.0) - vUV);
+    vec3 base = mix(uPalette[6].rgb, vColor, step(uParams.w, min(edge.x, edge.y)));
+    vec3 n = normalize(vViewNormal);
+    vec3 toLight = normalize(uLightPosition.xyz - vViewPosition);
+    float diffuse = max(dot(n, toLight), 0.0);
+    float specular = 0.0;
+    if (diffuse > 0.0) {
+        specular = pow(max(dot(n, normalize(toLight + vec3(0.0, 0.0, 1.0))), 0.0), 128.0);
+    }
+    // Global ambient 0.2 + light ambient 0.3 + diffuse 0.8, specular 1.5
+    fragColor = vec4(base * (0.5 + 0.8 * diffuse) + vec3(1.5 * specular), 1.0);
+}
+)";
+
+// Wall vertex shader: detailed instances are 27 cubies per WallInstance (attribute divisor 27,
+// cubie from gl_InstanceID); with uBoxes set each instance is one box in its majority colors
+const char* WALL_VERTEX_SOURCE = R"(
+layout(location = 0) in vec3 aPosition;
+layout(location = 1) in vec3 aNormal;
+layout(location = 2) in vec2 aUV;
+layout(location = 3) in int aFace;
+layout(location = 5) in vec4 aCenter;  // xyz, slice angle in degrees
+layout(location = 6) in ivec4 aCube;   // sticker row, slice axis, slice layer, slice active
+
+uniform usampler2D uWallStickers;
+uniform int uBoxes;
+
+out vec3 vViewPosition;
+out vec3 vViewNormal;
+out vec2 vUV;
+flat out vec3 vColor;
+
+int wallSticker(int texel) {
+    ivec2 base = ivec2((aCube.x % WALL_CUBES_PER_ROW) * WALL_TEXELS, aCube.x / WALL_CUBES_PER_ROW);
+    return int(texelFetch(uWallStickers, base + ivec2(texel, 0), 0).r);
+}
+
+void main() {
+    vec3 position;
+    vec3 normal = aNormal;
+    int color;
+    if (uBoxes != 0) {
+        position = aCenter.xyz + aPosition * (2.0 * uParams.z + uParams.y);
+        color = wallSticker(54 + aFace);
+    } else {
+        int index = gl_InstanceID % 27;
+        ivec3 cubie = ivec3(index / 9, (index / 3) % 3, index % 3);
+        position = (vec3(cubie) - vec3(1.0)) * uParams.z + aPosition * uParams.y;
+        if (aCube.w != 0 && cubie[aCube.y] == aCube.z) {
+            float angle = radians(aCenter.w);
+            position = rotateAxis(position, aCube.y, angle);
+            normal = rotateAxis(normal, aCube.y, angle);
+        }
+        position += aCenter.xyz;
+        ivec2 rc;
+        color = stickerCell(cubie, aFace, 3, rc) ? wallSticker(aFace * 9 + rc.x * 3 + rc.y) : 6;
+    }
+    vec4 viewPosition = uView * vec4(position, 1.0);
+    vViewPosition = viewPosition.xyz;
+    vViewNormal = mat3(uView) * normal;
+    vUV = aUV;
+    vColor = uPalette[color].rgb;
+    gl_Position = uProjection * viewPosition;
+}
+)";
+
+const char* STAR_VERTEX_SOURCE = R"(
+layout(location = 0) in vec3 aPosition;
+layout(location = 1) in vec4 aColor;
+
+out vec3 vColor;
+
+void main() {
+    vColor = aColor.rgb;
+    gl_PointSize = aColor.a;
+    gl_Position = uProjection * uView * vec4(aPosition, 1.0);
+}
+)";
+
+const char* STAR_FRAGMENT_SOURCE = R"(
+in vec3 vColor;
+out vec4 fragColor;
+
+void main() {
+    fragColor = vec4(vColor, 1.0);
+}
+)";
+
+// Unit cubie vertex: position in [-0.5, 0.5], normal, sticker UV, face index
+struct MeshVertex {
+    float position[3];
+    float normal[3];
+    float uv[2];
+    GLint face;
+};
+
+GLuint compileShader(GLenum type, const std::string& source) {
+    GLuint shader = glCore.CreateShader(type);
+    const GLchar* text = source.c_str();
+    glCore.ShaderSource(shader, 1, &text, nullptr);
+    glCore.CompileShader(shader);
+
+    GLint status = GL_FALSE;
+    glCore.GetShaderiv(shader, GL_COMPILE_STATUS, &status);
+    if (status != GL_TRUE) {
+        GLint length = 0;
+        glCore.GetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
+        std::string log(length > 0 ? length : 1, '\0');
+        glCore.GetShaderInfoLog(shader, length, nullptr, &log[0]);
+        std::cerr << "Warning: Shader compilation failed: " << log << std::endl;
+        glCore.DeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+} // namespace
+
+// Constructor - no GL calls until initialize()
+ShaderRenderer::ShaderRenderer()
+    : cubeProgram(0), starProgram(0), cubeVao(0), starVao(0), meshBuffer(0), indexBuffer(0),
+      instanceBuffer(0), starBuffer(0), frameBuffer(0), stickerTexture(0),
+      cubeSize(0), instanceCount(0), starCount(0), ready(false), uploadedCube(nullptr), uploadedVersion(0),
+      wallProgram(0), wallDetailVao(0), wallBoxVao(0), wallDetailBuffer(0), wallBoxBuffer(0), wallStickerTexture(0),
+      wallBoxesLocation(-1), wallCubes(0), uploadedWall(nullptr), uploadedWallVersion(0) {
+    std::memset(&frame, 0, sizeof(frame));
+}
+
+ShaderRenderer::~ShaderRenderer() {
+    releaseResources();
+}
+
+// Compile and link a program; both stages get the version line and Frame block, the vertex
+// stage also the wall layout constants and cubie helpers
+GLuint ShaderRenderer::buildProgram(const char* vertexSource, const char* fragmentSource) {
+    std::string header = std::string("#version 330 core\n") + FRAME_BLOCK;
+    std::string vertexHeader = header + "const int WALL_TEXELS = " + std::to_string(WALL_TEXELS) +
+                               ";\nconst int WALL_CUBES_PER_ROW = " + std::to_string(WALL_CUBES_PER_ROW) + ";\n" +
+                               CUBIE_FUNCTIONS;
+    GLuint vertex = compileShader(GL_VERTEX_SHADER, vertexHeader + vertexSource);
+    GLuint fragment = compileShader(GL_FRAGMENT_SHADER, header + fragmentSource);
+    if (!vertex || !fragment) {
+        if (vertex) glCore.DeleteShader(vertex);
+        if (fragment) glCore.DeleteShader(fragment);
+        return 0;
+    }
+
+    GLuint program = glCore.CreateProgram();
+    glCore.AttachShader(program, vertex);
+    glCore.AttachShader(program, fragment);
+    glCore.LinkProgram(program);
+    glCore.DeleteShader(vertex);
+    glCore.DeleteShader(fragment);
+
+    GLint status = GL_FALSE;
+    glCore.GetProgramiv(program, GL_LINK_STATUS, &status);
+    if (status != GL_TRUE) {
+        GLint length = 0;
+        glCore.GetProgramiv(program, GL_INFO_LOG_LENGTH, &length);
+        std::string log(length > 0 ? length : 1, '\0');
+        glCore.GetProgramInfoLog(program, length, nullptr, &log[0]);
+        std::cerr << "Warning: Shader program link failed: " << log << std::endl;
+        glCore.DeleteProgram(program);
+        return 0;
+    }
+
+    // Every program reads the same uniform buffer at binding 0
+    GLuint blockIndex = glCore.GetUniformBlockIndex(program, "Frame");
+    if (blockIndex != GL_INVALID_INDEX) {
+        glCore.UniformBlockBinding(program, blockIndex, 0);
+    }
+    return program;
+}
+
+// Build the unit cubie mesh - same face order and winding as Renderer::drawFace
+void ShaderRenderer::createCubeMesh() {
+    static const float corners[6][4][3] = {
+        {{ 0.5f, -0.5f, -0.5f}, { 0.5f,  0.5f, -0.5f}, { 0.5f,  0.5f,  0.5f}, { 0.5f, -0.5f,  0.5f}},  // Right (+X)
+        {{-0.5f, -0.5f,  0.5f}, {-0.5f,  0.5f,  0.5f}, {-0.5f,  0.5f, -0.5f}, {-0.5f, -0.5f, -0.5f}},  // Left (-X)
+        {{-0.5f,  0.5f, -0.5f}, { 0.5f,  0.5f, -0.5f}, { 0.5f,  0.5f,  0.5f}, {-0.5f,  0.5f,  0.5f}},  // Up (+Y)
+        {{-0.5f, -0.5f,  0.5f}, { 0.5f, -0.5f,  0.5f}, { 0.5f, -0.5f, -0.5f}, {-0.5f, -0.5f, -0.5f}},  // Down (-Y)
+        {{-0.5f, -0.5f,  0.5f}, {-0.5f,  0.5f,  0.5f}, { 0.5f,  0.5f,  0.5f}, { 0.5f, -0.5f,  0.5f}},  // Front (+Z)
+        {{ 0.5f, -0.5f, -0.5f}, { 0.5f,  0.5f, -0.5f}, {-0.5f,  0.5f, -0.5f}, {-0.5f, -0.5f, -0.5f}}   // Back (-Z)
+    };
+    static const float normals[6][3] = {
+        {1.0f, 0.0f, 0.0f}, {-1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f},
+        {0.0f, -1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, -1.0f}
+    };
+    static const float uvs[4][2] = {{0.0f, 0.0f}, {0.0f, 1.0f}, {1.0f, 1.0f}, {1.0f, 0.0f}};
+
+    std::vector<MeshVertex> vertices;
+    std::vector<GLushort> indices;
+    for (int face = 0; face < 6; face++) {
+        GLushort base = static_cast<GLushort>(vertices.size());
+        for (int v = 0; v < 4; v++) {
+            MeshVertex vertex;
+            std::memcpy(vertex.position, corners[face][v], sizeof(vertex.position));
+            std::memcpy(vertex.normal, normals[face], sizeof(vertex.normal));
+            std::memcpy(vertex.uv, uvs[v], sizeof(vertex.uv));
+            vertex.face = face;
+            vertices.push_back(vertex);
+        }
+        GLushort quad[6] = {base, GLushort(base + 1), GLushort(base + 2), base, GLushort(base + 2), GLushort(base + 3)};
+        indices.insert(indices.end(), quad, quad + 6);
+    }
+
+    glCore.GenBuffers(1, &meshBuffer);
+    glCore.BindBuffer(GL_ARRAY_BUFFER, meshBuffer);
+    glCore.BufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(MeshVertex), vertices.data(), GL_STATIC_DRAW);
+    glCore.GenBuffers(1, &indexBuffer);
+
+    glCore.GenVertexArrays(1, &cubeVao);
+    glCore.BindVertexArray(cubeVao);
+    glCore.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+    glCore.BufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLushort), indices.data(), GL_STATIC_DRAW);
+    bindMeshAttributes();
+
+    // Per-instance grid coordinate, advanced once per cubie
+    glCore.GenBuffers(1, &instanceBuffer);
+    glCore.BindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    glCore.EnableVertexAttribArray(4);
+    glCore.VertexAttribIPointer(4, 3, GL_INT, 3 * sizeof(GLint), nullptr);
+    glCore.VertexAttribDivisor(4, 1);
+
+    glCore.BindVertexArray(0);
+    glCore.BindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+// Mesh attributes 0-3 and the index buffer for the bound VAO
+void ShaderRenderer::bindMeshAttributes() {
+    glCore.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+    glCore.BindBuffer(GL_ARRAY_BUFFER, meshBuffer);
+    glCore.EnableVertexAttribArray(0);
+    glCore.VertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(MeshVertex), reinterpret_cast<void*>(offsetof(MeshVertex, position)));
+    glCore.EnableVertexAttribArray(1);
+    glCore.VertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(MeshVertex), reinterpret_cast<void*>(offsetof(MeshVertex, normal)));
+    glCore.EnableVertexAttribArray(2);
+    glCore.VertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(MeshVertex), reinterpret_cast<void*>(offsetof(MeshVertex, uv)));
+    glCore.EnableVertexAttribArray(3);
+    glCore.VertexAttribIPointer(3, 1, GL_INT, sizeof(MeshVertex), reinterpret_cast<void*>(offsetof(MeshVertex, face)));
+}
+
+// Wall VAOs: the cubie mesh plus a WallInstance stream, advanced every 27 instances for
+// detailed cubes and every instance for boxes
+void ShaderRenderer::createWallArrays() {
+    GLuint* vaos[2] = {&wallDetailVao, &wallBoxVao};
+    GLuint* buffers[2] = {&wallDetailBuffer, &wallBoxBuffer};
+    const GLuint divisors[2] = {27, 1};
+    for (int i = 0; i < 2; i++) {
+        glCore.GenVertexArrays(1, vaos[i]);
+        glCore.BindVertexArray(*vaos[i]);
+        bindMeshAttributes();
+        glCore.GenBuffers(1, buffers[i]);
+        glCore.BindBuffer(GL_ARRAY_BUFFER, *buffers[i]);
+        glCore.EnableVertexAttribArray(5);
+        glCore.VertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, sizeof(WallInstance), reinterpret_cast<void*>(offsetof(WallInstance, center)));
+        glCore.VertexAttribDivisor(5, divisors[i]);
+        glCore.EnableVertexAttribArray(6);
+        glCore.VertexAttribIPointer(6, 4, GL_INT, sizeof(WallInstance), reinterpret_cast<void*>(offsetof(WallInstance, cube)));
+        glCore.VertexAttribDivisor(6, divisors[i]);
+    }
+    glCore.BindVertexArray(0);
+    glCore.BindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glGenTextures(1, &wallStickerTexture);
+    glBindTexture(GL_TEXTURE_2D, wallStickerTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+// Fill the instance buffer with every cubie coordinate of an NxNxN cube
+void ShaderRenderer::createInstances(int size) {
+    std::vector<GLint> coordinates;
+    coordinates.reserve(size * size * size * 3);
+    for (int x = 0; x < size; x++) {
+        for (int y = 0; y < size; y++) {
+            for (int z = 0; z < size; z++) {
+                coordinates.push_back(x);
+                coordinates.push_back(y);
+                coordinates.push_back(z);
+            }
+        }
+    }
+    glCore.BindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    glCore.BufferData(GL_ARRAY_BUFFER, coordinates.size() * sizeof(GLint), coordinates.data(), GL_STATIC_DRAW);
+    glCore.BindBuffer(GL_ARRAY_BUFFER, 0);
+
+    cubeSize = size;
+    instanceCount = size * size * size;
+    frame.slice[3] = size;
+}
+
+// Compile programs and allocate all GPU resources
+bool ShaderRenderer::initialize(const std::vector<float>& starVertices) {
+    releaseResources();
+
+    cubeProgram = buildProgram(CUBE_VERTEX_SOURCE, CUBE_FRAGMENT_SOURCE);
+    starProgram = buildProgram(STAR_VERTEX_SOURCE, STAR_FRAGMENT_SOURCE);
+    wallProgram = buildProgram(WALL_VERTEX_SOURCE, CUBE_FRAGMENT_SOURCE);
+    if (!cubeProgram || !starProgram || !wallProgram) {
+        releaseResources();
+        return false;
+    }
+
+    createCubeMesh();
+    createWallArrays();
+
+    // Stars never change: upload once
+    starCount = static_cast<int>(starVertices.size() / 7);
+    glCore.GenVertexArrays(1, &starVao);
+    glCore.BindVertexArray(starVao);
+    glCore.GenBuffers(1, &starBuffer);
+    glCore.BindBuffer(GL_ARRAY_BUFFER, starBuffer);
+    glCore.BufferData(GL_ARRAY_BUFFER, starVertices.size() * sizeof(float), starVertices.data(), GL_STATIC_DRAW);
+    glCore.EnableVertexAttribArray(0);
+    glCore.VertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 7 * sizeof(float), nullptr);
+    glCore.EnableVertexAttribArray(1);
+    glCore.VertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, 7 * sizeof(float), reinterpret_cast<void*>(3 * sizeof(float)));
+    glCore.BindVertexArray(0);
+    glCore.BindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glCore.GenBuffers(1, &frameBuffer);
+    glCore.BindBuffer(GL_UNIFORM_BUFFER, frameBuffer);
+    glCore.BufferData(GL_UNIFORM_BUFFER, sizeof(FrameUniforms), nullptr, GL_DYNAMIC_DRAW);
+    glCore.BindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    glGenTextures(1, &stickerTexture);
+    glBindTexture(GL_TEXTURE_2D, stickerTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glCore.UseProgram(cubeProgram);
+    glCore.Uniform1i(glCore.GetUniformLocation(cubeProgram, "uStickers"), 0);
+    glCore.UseProgram(wallProgram);
+    glCore.Uniform1i(glCore.GetUniformLocation(wallProgram, "uWallStickers"), 0);
+    wallBoxesLocation = glCore.GetUniformLocation(wallProgram, "uBoxes");
+    glCore.UseProgram(0);
+
+    // Constant part of the frame block: light, palette (same colors as Renderer::setColor), cubie layout
+    static const float palette[8][3] = {
+        {1.0f, 1.0f, 1.0f},  // White
+        {1.0f, 1.0f, 0.0f},  // Yellow
+        {1.0f, 0.0f, 0.0f},  // Red
+        {1.0f, 0.5f, 0.0f},  // Orange
+        {0.0f, 1.0f, 0.0f},  // Green
+        {0.0f, 0.0f, 1.0f},  // Blue
+        {0.1f, 0.1f, 0.1f},  // Interior / border
+        {0.2f, 0.2f, 0.2f}   // Unknown
+    };
+    for (int i = 0; i < 8; i++) {
+        frame.palette[i][0] = palette[i][0];
+        frame.palette[i][1] = palette[i][1];
+        frame.palette[i][2] = palette[i][2];
+        frame.palette[i][3] = 1.0f;
+    }
+    frame.lightPosition[0] = 5.0f;
+    frame.lightPosition[1] = 5.0f;
+    frame.lightPosition[2] = 5.0f;
+    frame.lightPosition[3] = 1.0f;
+    frame.params[1] = 0.95f;  // Cubie size
+    frame.params[2] = 1.0f;   // Spacing
+    frame.params[3] = 0.04f;  // Border width in sticker UV units
+
+    ready = true;
+    return true;
+}
+
+// Free every GL object this renderer owns
+void ShaderRenderer::releaseResources() {
+    if (cubeProgram) glCore.DeleteProgram(cubeProgram);
+    if (starProgram) glCore.DeleteProgram(starProgram);
+    if (wallProgram) glCore.DeleteProgram(wallProgram);
+    GLuint vaos[] = {cubeVao, starVao, wallDetailVao, wallBoxVao};
+    for (GLuint vao : vaos) {
+        if (vao) glCore.DeleteVertexArrays(1, &vao);
+    }
+    GLuint buffers[] = {meshBuffer, indexBuffer, instanceBuffer, starBuffer, frameBuffer, wallDetailBuffer, wallBoxBuffer};
+    for (GLuint buffer : buffers) {
+        if (buffer) glCore.DeleteBuffers(1, &buffer);
+    }
+    if (stickerTexture) glDeleteTextures(1, &stickerTexture);
+    if (wallStickerTexture) glDeleteTextures(1, &wallStickerTexture);
+
+    cubeProgram = starProgram = wallProgram = cubeVao = starVao = wallDetailVao = wallBoxVao = 0;
+    meshBuffer = indexBuffer = instanceBuffer = starBuffer = frameBuffer = stickerTexture = 0;
+    wallDetailBuffer = wallBoxBuffer = wallStickerTexture = 0;
+    cubeSize = instanceCount = starCount = wallCubes = 0;
+    wallBoxesLocation = -1;
+    ready = false;
+    uploadedCube = nullptr;
+    uploadedWall = nullptr;
+}
+
+// Copy the cube's sticker colors into the 6 x (N*N) index texture
+void ShaderRenderer::updateStickers(const RubikCube& cube) {
+    if (!ready) return;
+    if (&cube == uploadedCube && cube.getVersion() == uploadedVersion) return;
+    PROFILE_SCOPE("ShaderRenderer::updateStickers");
+
+    const auto& faces = cube.getFaces();
+    int size = static_cast<int>(faces[0].size());
+    bool resized = size != cubeSize;
+    if (resized) {
+        createInstances(size);
+    }
+
+    stickers.resize(6 * size * size);
+    for (int face = 0; face < 6; face++) {
+        for (int row = 0; row < size; row++) {
+            for (int col = 0; col < size; col++) {
+                stickers[(face * size + row) * size + col] = static_cast<unsigned char>(faces[face][row][col]);
+            }
+        }
+    }
+
+    glBindTexture(GL_TEXTURE_2D, stickerTexture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    if (resized) {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R8UI, size * size, 6, 0, GL_RED_INTEGER, GL_UNSIGNED_BYTE, stickers.data());
+    } else {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, size * size, 6, GL_RED_INTEGER, GL_UNSIGNED_BYTE, stickers.data());
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+    uploadedCube = &cube;
+    uploadedVersion = cube.getVersion();
+}
+
+// Select the slice the vertex shader rotates
+void ShaderRenderer::setSliceRotation(int axis, int layer, float angleDegrees) {
+    frame.slice[0] = axis;
+    frame.slice[1] = layer;
+    frame.slice[2] = 1;
+    frame.params[0] = angleDegrees;
+}
+
+void ShaderRenderer::clearSliceRotation() {
+    frame.slice[2] = 0;
+    frame.params[0] = 0.0f;
+}
+
+// Draw stars and cube; leaves no program, VAO or buffer bound for SFML
+void ShaderRenderer::render(const float* projection, const float* view) {
+    if (!ready || instanceCount == 0) return;
+    PROFILE_SCOPE("ShaderRenderer::render");
+
+    std::memcpy(frame.projection, projection, sizeof(frame.projection));
+    std::memcpy(frame.view, view, sizeof(frame.view));
+    glCore.BindBuffer(GL_UNIFORM_BUFFER, frameBuffer);
+    glCore.BufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameUniforms), &frame);
+    glCore.BindBuffer(GL_UNIFORM_BUFFER, 0);
+    glCore.BindBufferBase(GL_UNIFORM_BUFFER, 0, frameBuffer);
+
+    // Background stars, drawn behind everything
+    glDisable(GL_DEPTH_TEST);
+    glEnable(GL_PROGRAM_POINT_SIZE);
+    glCore.UseProgram(starProgram);
+    glCore.BindVertexArray(starVao);
+    glDrawArrays(GL_POINTS, 0, starCount);
+    glDisable(GL_PROGRAM_POINT_SIZE);
+    glEnable(GL_DEPTH_TEST);
+
+    // Entire cube in one call
+    glCore.UseProgram(cubeProgram);
+    glCore.ActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, stickerTexture);
+    glCore.BindVertexArray(cubeVao);
+    glCore.DrawElementsInstanced(GL_TRIANGLES, 36, GL_UNSIGNED_SHORT, nullptr, instanceCount);
+    PROFILE_COUNT(COUNTER_DRAW_CALLS, 2);
+    PROFILE_COUNT(COUNTER_VERTICES, starCount + 36 * instanceCount);
+
+    glCore.BindVertexArray(0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glCore.UseProgram(0);
+    glCore.BindBufferBase(GL_UNIFORM_BUFFER, 0, 0);
+}
+
+// Copy every cube's stickers into the wall texture (a few KB per hundred cubes)
+void ShaderRenderer::updateWall(const CubeWall& wall) {
+    if (!ready) return;
+    if (&wall == uploadedWall && wall.getStickerVersion() == uploadedWallVersion) return;
+    PROFILE_SCOPE("ShaderRenderer::updateWall");
+
+    int rows = (wall.size() + WALL_CUBES_PER_ROW - 1) / WALL_CUBES_PER_ROW;
+    int width = WALL_CUBES_PER_ROW * WALL_TEXELS;
+    wallStickers.assign(static_cast<std::size_t>(rows) * width, 0);
+    std::memcpy(wallStickers.data(), wall.stickerData(), static_cast<std::size_t>(wall.size()) * WALL_TEXELS);
+
+    glBindTexture(GL_TEXTURE_2D, wallStickerTexture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    if (wall.size() != wallCubes) {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R8UI, width, rows, 0, GL_RED_INTEGER, GL_UNSIGNED_BYTE, wallStickers.data());
+        wallCubes = wall.size();
+    } else {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, rows, GL_RED_INTEGER, GL_UNSIGNED_BYTE, wallStickers.data());
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+    uploadedWall = &wall;
+    uploadedWallVersion = wall.getStickerVersion();
+}
+
+// Stars, then detailed cubes (27 cubie instances each) and distant boxes in one call each
+void ShaderRenderer::renderWall(const float* projection, const float* view, const WallView& visible) {
+    if (!ready || wallCubes == 0) return;
+    PROFILE_SCOPE("ShaderRenderer::renderWall");
+
+    std::memcpy(frame.projection, projection, sizeof(frame.projection));
+    std::memcpy(frame.view, view, sizeof(frame.view));
+    glCore.BindBuffer(GL_UNIFORM_BUFFER, frameBuffer);
+    glCore.BufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameUniforms), &frame);
+    glCore.BindBuffer(GL_UNIFORM_BUFFER, 0);
+    glCore.BindBufferBase(GL_UNIFORM_BUFFER, 0, frameBuffer);
+
+    glDisable(GL_DEPTH_TEST);
+    glEnable(GL_PROGRAM_POINT_SIZE);
+    glCore.UseProgram(starProgram);
+    glCore.BindVertexArray(starVao);
+    glDrawArrays(GL_POINTS, 0, starCount);
+    glDisable(GL_PROGRAM_POINT_SIZE);
+    glEnable(GL_DEPTH_TEST);
+
+    glCore.UseProgram(wallProgram);
+    glCore.ActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, wallStickerTexture);
+    int draws = 1;
+    const std::vector<WallInstance>* lists[2] = {&visible.detailed, &visible.distant};
+    GLuint vaos[2] = {wallDetailVao, wallBoxVao};
+    GLuint buffers[2] = {wallDetailBuffer, wallBoxBuffer};
+    for (int i = 0; i < 2; i++) {
+        if (lists[i]->empty()) continue;
+        // Orphan and refill: the instance lists are rebuilt every frame
+        glCore.BindBuffer(GL_ARRAY_BUFFER, buffers[i]);
+        glCore.BufferData(GL_ARRAY_BUFFER, lists[i]->size() * sizeof(WallInstance), lists[i]->data(), GL_STREAM_DRAW);
+        glCore.Uniform1i(wallBoxesLocation, i);
+        glCore.BindVertexArray(vaos[i]);
+        GLsizei instances = static_cast<GLsizei>(lists[i]->size() * (i == 0 ? 27 : 1));
+        glCore.DrawElementsInstanced(GL_TRIANGLES, 36, GL_UNSIGNED_SHORT, nullptr, instances);
+        PROFILE_COUNT(COUNTER_VERTICES, 36 * instances);
+        draws++;
+    }
+    PROFILE_COUNT(COUNTER_DRAW_CALLS, draws);
+    PROFILE_COUNT(COUNTER_VERTICES, starCount);
+
+    glCore.BindVertexArray(0);
+    glCore.BindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glCore.UseProgram(0);
+    glCore.BindBufferBase(GL_UNIFORM_BUFFER, 0, 0);
+}
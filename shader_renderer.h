@@ -0,0 +1,91 @@
+// Shader Renderer Header
+// OpenGL 3.3 core rendering path: one program, one instanced draw per cube, and the cube wall
+// (CubeWall) as one instanced draw of detailed cubes plus one of distant boxes
+
+#ifndef SHADER_RENDERER_H
+#define SHADER_RENDERER_H
+
+#include "gl_functions.h"
+#include "rubik_cube.h"
+#include "cube_wall.h"
+#include <cstdint>
+#include <vector>
+
+// Per-frame uniform block, laid out to match std140 "Frame" in the shaders
+struct FrameUniforms {
+    float projection[16];
+    float view[16];
+    float lightPosition[4];  // View space
+    float palette[8][4];     // Color index -> RGB (index 6 = cubie interior)
+    GLint slice[4];          // Rotating slice: axis, layer, active flag, cube size
+    float params[4];         // Slice angle (degrees), cubie size, spacing, border width
+};
+
+// Shader-based renderer - cubie transforms and stickers are resolved on the GPU
+class ShaderRenderer {
+private:
+    GLuint cubeProgram;
+    GLuint starProgram;
+    GLuint cubeVao;
+    GLuint starVao;
+    GLuint meshBuffer;      // Unit cubie: 6 faces x 4 vertices
+    GLuint indexBuffer;
+    GLuint instanceBuffer;  // Grid coordinate of every cubie
+    GLuint starBuffer;
+    GLuint frameBuffer;     // Uniform buffer holding FrameUniforms
+    GLuint stickerTexture;  // 6 rows of N*N sticker color indices
+    int cubeSize;
+    int instanceCount;
+    int starCount;
+    bool ready;
+    const RubikCube* uploadedCube;     // Cube and state version last uploaded to the texture
+    unsigned int uploadedVersion;
+    std::vector<unsigned char> stickers;
+    FrameUniforms frame;
+
+    // Cube wall: WallInstance streams with divisor 27 (detailed) and 1 (boxes)
+    GLuint wallProgram;
+    GLuint wallDetailVao;
+    GLuint wallBoxVao;
+    GLuint wallDetailBuffer;
+    GLuint wallBoxBuffer;
+    GLuint wallStickerTexture;  // WALL_TEXELS per cube, WALL_CUBES_PER_ROW cubes per texture row
+    GLint wallBoxesLocation;
+    int wallCubes;              // Cubes the sticker texture was allocated for
+    const CubeWall* uploadedWall;
+    std::uint64_t uploadedWallVersion;
+    std::vector<unsigned char> wallStickers;
+
+    GLuint buildProgram(const char* vertexSource, const char* fragmentSource);
+    void createCubeMesh();
+    void createInstances(int size);
+    void createWallArrays();
+    void bindMeshAttributes();
+    void releaseResources();
+
+public:
+    ShaderRenderer();
+    ~ShaderRenderer();
+
+    // Compile shaders and create buffers; stars are x,y,z,r,g,b,pointSize per vertex
+    bool initialize(const std::vector<float>& starVertices);
+    bool isReady() const { return ready; }
+
+    // Upload sticker colors if the cube state changed (resizes the grid if the cube size changed)
+    void updateStickers(const RubikCube& cube);
+
+    // Set the rotating slice for the next draw (axis 0=X, 1=Y, 2=Z; layer in [0, N))
+    void setSliceRotation(int axis, int layer, float angleDegrees);
+    void clearSliceRotation();
+
+    // Draw background stars and the whole cube with the given camera matrices
+    void render(const float* projection, const float* view);
+
+    // Upload the wall's stickers if any cube changed since the last call
+    void updateWall(const CubeWall& wall);
+
+    // Draw stars and the visible wall cubes (two instanced calls)
+    void renderWall(const float* projection, const float* view, const WallView& visible);
+};
+
+#endif // SHADER_RENDERER_H
@@ -0,0 +1,303 @@
+// Solver Service Implementation
+// Frame and body encoding, blocking Unix-socket client
+
+#include "solver_service.h"
+#include <algorithm>
+#include <cstring>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0  // macOS: SO_NOSIGPIPE is set on the socket instead
+#endif
+#endif
+
+namespace {
+
+void putU16(std::vector<std::uint8_t>& out, std::uint32_t value) {
+    out.push_back(static_cast<std::uint8_t>(value));
+    out.push_back(static_cast<std::uint8_t>(value >> 8));
+}
+
+void putU32(std::vector<std::uint8_t>& out, std::uint32_t value) {
+    for (int i = 0; i < 4; i++) out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+}
+
+void putF32(std::vector<std::uint8_t>& out, float value) {
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    putU32(out, bits);
+}
+
+std::uint32_t getU16(const std::uint8_t* in) {
+    return static_cast<std::uint32_t>(in[0]) | static_cast<std::uint32_t>(in[1]) << 8;
+}
+
+std::uint32_t getU32(const std::uint8_t* in) {
+    std::uint32_t value = 0;
+    for (int i = 0; i < 4; i++) value |= static_cast<std::uint32_t>(in[i]) << (8 * i);
+    return value;
+}
+
+float getF32(const std::uint8_t* in) {
+    std::uint32_t bits = getU32(in);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+void putState(std::vector<std::uint8_t>& out, const CubieCube& cube) {
+    std::uint8_t state[RANKED_STATE_BYTES];
+    cube.encodeRanked(state);
+    out.insert(out.end(), state, state + RANKED_STATE_BYTES);
+}
+
+#ifndef _WIN32
+bool sendAll(int fd, const std::uint8_t* data, std::size_t size) {
+    while (size > 0) {
+        ssize_t sent = ::send(fd, data, size, MSG_NOSIGNAL);
+        if (sent <= 0) return false;
+        data += sent;
+        size -= static_cast<std::size_t>(sent);
+    }
+    return true;
+}
+
+bool receiveAll(int fd, std::uint8_t* data, std::size_t size) {
+    while (size > 0) {
+        ssize_t received = ::recv(fd, data, size, 0);
+        if (received <= 0) return false;
+        data += received;
+        size -= static_cast<std::size_t>(received);
+    }
+    return true;
+}
+#endif
+
+} // namespace
+
+void appendFrame(std::vector<std::uint8_t>& out, std::uint8_t type, std::uint32_t id, const std::vector<std::uint8_t>& body) {
+    putU32(out, static_cast<std::uint32_t>(body.size()));
+    out.push_back(type);
+    putU32(out, id);
+    out.insert(out.end(), body.begin(), body.end());
+}
+
+bool takeFrame(std::vector<std::uint8_t>& buffer, SolverFrame& frame, bool& malformed) {
+    malformed = false;
+    if (buffer.size() < SOLVER_FRAME_HEADER) return false;
+    std::uint32_t length = getU32(buffer.data());
+    if (length > SOLVER_MAX_BODY) {
+        malformed = true;
+        return false;
+    }
+    if (buffer.size() < SOLVER_FRAME_HEADER + length) return false;
+    frame.type = buffer[4];
+    frame.id = getU32(buffer.data() + 5);
+    frame.body.assign(buffer.begin() + SOLVER_FRAME_HEADER, buffer.begin() + SOLVER_FRAME_HEADER + length);
+    buffer.erase(buffer.begin(), buffer.begin() + SOLVER_FRAME_HEADER + length);
+    return true;
+}
+
+void writeStages(const std::vector<SolveStage>& stages, std::vector<std::uint8_t>& body) {
+    body.push_back(static_cast<std::uint8_t>(stages.size()));
+    for (const SolveStage& stage : stages) {
+        std::size_t nameLength = std::min<std::size_t>(stage.name.size(), 255);
+        body.push_back(static_cast<std::uint8_t>(nameLength));
+        body.insert(body.end(), stage.name.begin(), stage.name.begin() + nameLength);
+        body.push_back(static_cast<std::uint8_t>(stage.moves.size()));
+        for (int move : stage.moves) body.push_back(static_cast<std::uint8_t>(move));
+        putF32(body, static_cast<float>(stage.microseconds));
+        putU32(body, static_cast<std::uint32_t>(std::min<std::uint64_t>(stage.nodes, 0xFFFFFFFFu)));
+    }
+}
+
+bool readStages(const std::uint8_t* data, std::size_t size, std::vector<SolveStage>& stages) {
+    stages.clear();
+    if (size < 1) return false;
+    std::size_t count = data[0], offset = 1;
+    for (std::size_t s = 0; s < count; s++) {
+        SolveStage stage;
+        if (offset + 1 > size) return false;
+        std::size_t nameLength = data[offset++];
+        if (offset + nameLength + 1 > size) return false;
+        stage.name.assign(reinterpret_cast<const char*>(data + offset), nameLength);
+        offset += nameLength;
+        std::size_t moveCount = data[offset++];
+        if (offset + moveCount + 8 > size) return false;
+        for (std::size_t i = 0; i < moveCount; i++) {
+            if (data[offset + i] >= NUM_MOVES) return false;
+            stage.moves.push_back(data[offset + i]);
+        }
+        offset += moveCount;
+        stage.microseconds = getF32(data + offset);
+        stage.nodes = getU32(data + offset + 4);
+        offset += 8;
+        stages.push_back(stage);
+    }
+    return offset == size;
+}
+
+void writeEstimates(const DistanceEstimate* estimates, std::size_t count, std::vector<std::uint8_t>& body) {
+    putU16(body, static_cast<std::uint32_t>(count));
+    for (std::size_t i = 0; i < count; i++) {
+        putF32(body, estimates[i].moves);
+        body.push_back(static_cast<std::uint8_t>(estimates[i].lowerBound));
+    }
+}
+
+bool readEstimates(const std::uint8_t* data, std::size_t size, std::vector<DistanceEstimate>& estimates) {
+    if (size < 2) return false;
+    std::size_t count = getU16(data);
+    if (size != 2 + count * 5) return false;
+    estimates.resize(count);
+    for (std::size_t i = 0; i < count; i++) {
+        estimates[i].moves = getF32(data + 2 + i * 5);
+        estimates[i].lowerBound = data[2 + i * 5 + 4];
+    }
+    return true;
+}
+
+// SolverClient
+SolverClient::SolverClient() : socketFd(-1), nextId(1) {}
+
+SolverClient::~SolverClient() {
+    close();
+}
+
+#ifdef _WIN32
+
+bool SolverClient::connect(const std::string&, int) {
+    return false;
+}
+
+void SolverClient::close() {}
+
+bool SolverClient::request(std::uint8_t, const std::vector<std::uint8_t>&, SolverFrame&) {
+    return false;
+}
+
+#else
+
+bool SolverClient::connect(const std::string& path, int timeoutMs) {
+    close();
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) return false;
+    std::memcpy(address.sun_path, path.c_str(), path.size());
+
+    socketFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (socketFd < 0) return false;
+#ifdef SO_NOSIGPIPE
+    int one = 1;
+    ::setsockopt(socketFd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+    if (timeoutMs > 0) {
+        timeval timeout;
+        timeout.tv_sec = timeoutMs / 1000;
+        timeout.tv_usec = (timeoutMs % 1000) * 1000;
+        ::setsockopt(socketFd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        ::setsockopt(socketFd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+    }
+    if (::connect(socketFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void SolverClient::close() {
+    if (socketFd >= 0) ::close(socketFd);
+    socketFd = -1;
+}
+
+// Requests are strictly sequential, so the next frame is the answer
+bool SolverClient::request(std::uint8_t type, const std::vector<std::uint8_t>& body, SolverFrame& response) {
+    if (socketFd < 0) return false;
+    std::uint32_t id = nextId++;
+    std::vector<std::uint8_t> frame;
+    appendFrame(frame, type, id, body);
+
+    std::uint8_t header[SOLVER_FRAME_HEADER];
+    if (sendAll(socketFd, frame.data(), frame.size()) && receiveAll(socketFd, header, SOLVER_FRAME_HEADER)) {
+        std::uint32_t length = getU32(header);
+        response.type = header[4];
+        response.id = getU32(header + 5);
+        if (length >= 1 && length <= SOLVER_MAX_BODY && response.id == id && response.type == type) {
+            response.body.resize(length);
+            if (receiveAll(socketFd, response.body.data(), length)) return true;
+        }
+    }
+    close();
+    return false;
+}
+
+#endif
+
+bool SolverClient::solve(const CubieCube& cube, std::vector<SolveStage>& stages, SolverStatus* status) {
+    std::vector<std::uint8_t> body;
+    putState(body, cube);
+    SolverFrame response;
+    if (!request(REQUEST_SOLVE, body, response)) return false;
+    if (status) *status = static_cast<SolverStatus>(response.body[0]);
+    return response.body[0] == STATUS_OK && readStages(response.body.data() + 1, response.body.size() - 1, stages);
+}
+
+bool SolverClient::solveOptimal(const CubieCube& cube, int maxDepth, std::vector<int>& moves, SolverStatus* status) {
+    std::vector<std::uint8_t> body;
+    body.push_back(static_cast<std::uint8_t>(maxDepth));
+    putState(body, cube);
+    SolverFrame response;
+    if (!request(REQUEST_OPTIMAL, body, response)) return false;
+    if (status) *status = static_cast<SolverStatus>(response.body[0]);
+    if (response.body[0] != STATUS_OK || response.body.size() < 2) return false;
+    std::size_t length = response.body[1];
+    if (response.body.size() != 2 + length + 4) return false;
+    moves.assign(response.body.begin() + 2, response.body.begin() + 2 + length);
+    return true;
+}
+
+bool SolverClient::validate(const RubikCube& cube, bool& valid, CubieCube& state) {
+    std::vector<std::uint8_t> body;
+    for (const auto& face : cube.getFaces()) {
+        for (const auto& row : face) {
+            for (int color : row) body.push_back(static_cast<std::uint8_t>(color));
+        }
+    }
+    SolverFrame response;
+    if (!request(REQUEST_VALIDATE, body, response)) return false;
+    if (response.body[0] != STATUS_OK || response.body.size() < 2) return false;
+    valid = response.body[1] != 0;
+    if (!valid) return true;
+    return response.body.size() == 2 + RANKED_STATE_BYTES && CubieCube::decodeRanked(response.body.data() + 2, state);
+}
+
+bool SolverClient::estimate(const CubieCube* cubes, std::size_t count, std::vector<DistanceEstimate>& estimates) {
+    estimates.clear();
+    for (std::size_t first = 0; first < count; first += SOLVER_MAX_ESTIMATES) {
+        std::size_t chunk = std::min<std::size_t>(SOLVER_MAX_ESTIMATES, count - first);
+        std::vector<std::uint8_t> body;
+        putU16(body, static_cast<std::uint32_t>(chunk));
+        for (std::size_t i = 0; i < chunk; i++) putState(body, cubes[first + i]);
+        SolverFrame response;
+        std::vector<DistanceEstimate> part;
+        if (!request(REQUEST_ESTIMATE, body, response) || response.body[0] != STATUS_OK ||
+            !readEstimates(response.body.data() + 1, response.body.size() - 1, part) || part.size() != chunk) {
+            return false;
+        }
+        estimates.insert(estimates.end(), part.begin(), part.end());
+    }
+    return true;
+}
+
+bool SolverClient::stats(std::string& report) {
+    SolverFrame response;
+    if (!request(REQUEST_STATS, std::vector<std::uint8_t>(), response) || response.body[0] != STATUS_OK) return false;
+    report.assign(response.body.begin() + 1, response.body.end());
+    return true;
+}
@@ -0,0 +1,98 @@
+// Solver Service Header
+// Binary request protocol for the local solver daemon (rubik_solverd) and its blocking client
+//
+// Frames on a Unix stream socket, little-endian:
+//   header  u32 body length, u8 request type, u32 request id
+//   body    request: type-specific; response: u8 status, then type-specific
+//
+//   SOLVE     state[9]                  -> u8 stages, per stage: u8 name length, name,
+//                                          u8 move count, moves, f32 microseconds, u32 nodes
+//   OPTIMAL   u8 max depth, state[9]    -> u8 length, moves, u32 nodes
+//   VALIDATE  54 sticker colors         -> u8 valid, state[9] when valid
+//   ESTIMATE  u16 count, count x state  -> u16 count, count x (f32 moves, u8 lower bound)
+//   STATS     (empty)                   -> text report
+//
+// States use the 9-byte ranked encoding (CubieCube::encodeRanked), moves one byte each.
+// Responses carry the request id; the daemon may answer requests of one connection out of order.
+
+#ifndef SOLVER_SERVICE_H
+#define SOLVER_SERVICE_H
+
+#include "distance_estimator.h"
+#include "human_solver.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+constexpr const char* DEFAULT_SOLVER_SOCKET = "/tmp/rubik_solverd.sock";
+constexpr int SOLVER_FRAME_HEADER = 9;
+constexpr std::uint32_t SOLVER_MAX_BODY = 1 << 20;
+constexpr int SOLVER_MAX_ESTIMATES = 4096;  // Per ESTIMATE request
+constexpr int SOLVER_CLIENT_TIMEOUT_MS = 2000;  // Default send / receive timeout of SolverClient
+
+enum SolverRequest : std::uint8_t {
+    REQUEST_SOLVE = 1,
+    REQUEST_OPTIMAL = 2,
+    REQUEST_VALIDATE = 3,
+    REQUEST_ESTIMATE = 4,
+    REQUEST_STATS = 5,
+    REQUEST_TYPE_COUNT = 6
+};
+
+enum SolverStatus : std::uint8_t {
+    STATUS_OK = 0,
+    STATUS_BAD_REQUEST = 1,
+    STATUS_FAILED = 2,        // Valid request, no answer (unsolvable state, depth limit)
+    STATUS_UNAVAILABLE = 3    // Daemon started without what the request needs
+};
+
+struct SolverFrame {
+    std::uint8_t type;
+    std::uint32_t id;
+    std::vector<std::uint8_t> body;
+};
+
+// Framing
+void appendFrame(std::vector<std::uint8_t>& out, std::uint8_t type, std::uint32_t id, const std::vector<std::uint8_t>& body);
+
+// Remove one complete frame from the front of buffer; false if more bytes are needed.
+// Sets malformed (and returns false) for a body over SOLVER_MAX_BODY.
+bool takeFrame(std::vector<std::uint8_t>& buffer, SolverFrame& frame, bool& malformed);
+
+// Body codecs shared by the daemon and the client (the read side validates lengths)
+void writeStages(const std::vector<SolveStage>& stages, std::vector<std::uint8_t>& body);
+bool readStages(const std::uint8_t* data, std::size_t size, std::vector<SolveStage>& stages);
+void writeEstimates(const DistanceEstimate* estimates, std::size_t count, std::vector<std::uint8_t>& body);
+bool readEstimates(const std::uint8_t* data, std::size_t size, std::vector<DistanceEstimate>& estimates);
+
+// Blocking client - one request in flight at a time, so use one client per thread. Sends and
+// receives give up after the timeout given to connect; the connection is then closed, since a
+// late answer would be read as the reply to the next request.
+class SolverClient {
+private:
+    int socketFd;
+    std::uint32_t nextId;
+
+    bool request(std::uint8_t type, const std::vector<std::uint8_t>& body, SolverFrame& response);
+
+public:
+    SolverClient();
+    ~SolverClient();
+    SolverClient(const SolverClient&) = delete;
+    SolverClient& operator=(const SolverClient&) = delete;
+
+    // False if no daemon listens on path (always false on Windows); timeoutMs 0 waits forever
+    bool connect(const std::string& path = DEFAULT_SOLVER_SOCKET, int timeoutMs = SOLVER_CLIENT_TIMEOUT_MS);
+    void close();
+    bool isConnected() const { return socketFd >= 0; }
+
+    // Each call returns false on transport errors (the connection is then closed) or a
+    // non-OK status, which is stored in status when given
+    bool solve(const CubieCube& cube, std::vector<SolveStage>& stages, SolverStatus* status = nullptr);
+    bool solveOptimal(const CubieCube& cube, int maxDepth, std::vector<int>& moves, SolverStatus* status = nullptr);
+    bool validate(const RubikCube& cube, bool& valid, CubieCube& state);
+    bool estimate(const CubieCube* cubes, std::size_t count, std::vector<DistanceEstimate>& estimates);
+    bool stats(std::string& report);
+};
+
+#endif // SOLVER_SERVICE_H
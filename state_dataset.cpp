@@ -0,0 +1,304 @@
+// State Dataset Implementation
+// Block encoding, optional zlib compression and the mapped block index
+
+#include "state_dataset.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef RUBIK_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace {
+
+const char FILE_MAGIC[8] = {'R', 'B', 'K', 'S', 'T', 'A', 'T', '1'};
+const char INDEX_MAGIC[8] = {'R', 'B', 'K', 'I', 'N', 'D', 'X', '1'};
+const std::uint32_t BLOCK_MAGIC = 0x314B4C42;  // "BLK1"
+const std::uint32_t FORMAT_VERSION = 1;
+const std::size_t HEADER_SIZE = 32;
+const std::size_t BLOCK_HEADER_SIZE = 24;
+const std::size_t INDEX_ENTRY_SIZE = 24;
+const std::size_t TRAILER_SIZE = 24;
+
+void putU32(std::vector<std::uint8_t>& out, std::uint32_t value) {
+    for (int i = 0; i < 4; i++) out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+}
+
+void putU64(std::vector<std::uint8_t>& out, std::uint64_t value) {
+    for (int i = 0; i < 8; i++) out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+}
+
+std::uint32_t getU32(const std::uint8_t* in) {
+    std::uint32_t value = 0;
+    for (int i = 0; i < 4; i++) value |= static_cast<std::uint32_t>(in[i]) << (8 * i);
+    return value;
+}
+
+std::uint64_t getU64(const std::uint8_t* in) {
+    std::uint64_t value = 0;
+    for (int i = 0; i < 8; i++) value |= static_cast<std::uint64_t>(in[i]) << (8 * i);
+    return value;
+}
+
+std::uint32_t fnv1a(const std::uint8_t* data, std::size_t size) {
+    std::uint32_t hash = 2166136261u;
+    for (std::size_t i = 0; i < size; i++) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+} // namespace
+
+// Moves of entry i, read from the offset column
+const std::uint8_t* DatasetBlockView::solution(std::uint32_t i, std::uint32_t& length) const {
+    if (!solutionOffsets) {
+        length = 0;
+        return nullptr;
+    }
+    std::uint32_t begin = getU32(solutionOffsets + 4 * static_cast<std::size_t>(i));
+    std::uint32_t end = getU32(solutionOffsets + 4 * static_cast<std::size_t>(i + 1));
+    length = end - begin;
+    return solutionMoves + begin;
+}
+
+DatasetWriter::DatasetWriter() : file(nullptr), stateCount(0), blockCount(0) {}
+
+DatasetWriter::~DatasetWriter() {
+    close();
+}
+
+// Create the file and write a provisional header (state count is patched on close)
+bool DatasetWriter::open(const std::string& path, const DatasetOptions& datasetOptions) {
+    close();
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+
+    options = datasetOptions;
+    options.blockSize = std::max<std::uint32_t>(1, options.blockSize);
+#ifndef RUBIK_HAVE_ZLIB
+    options.compress = false;
+#endif
+    stateCount = 0;
+    blockCount = 0;
+    index.clear();
+    states.reserve(static_cast<std::size_t>(options.blockSize) * RANKED_STATE_BYTES);
+    distances.reserve(options.blockSize);
+    solutionOffsets.assign(1, 0);
+
+    std::vector<std::uint8_t> header(FILE_MAGIC, FILE_MAGIC + 8);
+    putU32(header, FORMAT_VERSION);
+    putU32(header, options.solutions ? FLAG_SOLUTIONS : 0);
+    putU32(header, options.blockSize);
+    putU32(header, 0);
+    putU64(header, 0);
+    return std::fwrite(header.data(), 1, header.size(), file) == header.size();
+}
+
+// Append one entry to the current block
+bool DatasetWriter::add(const CubieCube& state, std::uint8_t distance, const std::uint8_t* solution, std::size_t length) {
+    if (!file) return false;
+
+    std::size_t offset = states.size();
+    states.resize(offset + RANKED_STATE_BYTES);
+    state.encodeRanked(&states[offset]);
+    distances.push_back(distance);
+    if (options.solutions) {
+        solutionMoves.insert(solutionMoves.end(), solution, solution + length);
+        solutionOffsets.push_back(static_cast<std::uint32_t>(solutionMoves.size()));
+    }
+    stateCount++;
+
+    if (distances.size() >= options.blockSize) {
+        return flushBlock();
+    }
+    return true;
+}
+
+// Serialize the buffered columns as one block and record it in the index
+bool DatasetWriter::flushBlock() {
+    std::uint32_t count = static_cast<std::uint32_t>(distances.size());
+    if (count == 0) return true;
+
+    payload.assign(states.begin(), states.end());
+    payload.insert(payload.end(), distances.begin(), distances.end());
+    if (options.solutions) {
+        for (std::uint32_t offset : solutionOffsets) putU32(payload, offset);
+        payload.insert(payload.end(), solutionMoves.begin(), solutionMoves.end());
+    }
+
+    std::uint32_t compression = COMPRESSION_NONE;
+    const std::uint8_t* stored = payload.data();
+    std::size_t storedSize = payload.size();
+#ifdef RUBIK_HAVE_ZLIB
+    if (options.compress) {
+        uLongf bound = compressBound(static_cast<uLong>(payload.size()));
+        compressed.resize(bound);
+        // Level 1: ranked states compress modestly, decode speed matters more
+        if (compress2(compressed.data(), &bound, payload.data(), static_cast<uLong>(payload.size()), 1) == Z_OK &&
+            bound < payload.size()) {
+            compression = COMPRESSION_ZLIB;
+            stored = compressed.data();
+            storedSize = bound;
+        }
+    }
+#endif
+
+    long blockOffset = std::ftell(file);
+    std::vector<std::uint8_t> header;
+    putU32(header, BLOCK_MAGIC);
+    putU32(header, count);
+    putU32(header, compression);
+    putU32(header, static_cast<std::uint32_t>(payload.size()));
+    putU32(header, static_cast<std::uint32_t>(storedSize));
+    putU32(header, fnv1a(payload.data(), payload.size()));
+    if (std::fwrite(header.data(), 1, header.size(), file) != header.size() ||
+        std::fwrite(stored, 1, storedSize, file) != storedSize) {
+        return false;
+    }
+
+    putU64(index, static_cast<std::uint64_t>(blockOffset));
+    putU64(index, stateCount - count);
+    putU32(index, count);
+    putU32(index, 0);
+    blockCount++;
+
+    states.clear();
+    distances.clear();
+    solutionOffsets.assign(1, 0);
+    solutionMoves.clear();
+    return true;
+}
+
+// Finish the file: last block, index, trailer, then the real state count in the header
+bool DatasetWriter::close() {
+    if (!file) return true;
+    bool ok = flushBlock();
+
+    std::uint64_t indexOffset = static_cast<std::uint64_t>(std::ftell(file));
+    std::vector<std::uint8_t> trailer;
+    putU64(trailer, indexOffset);
+    putU64(trailer, blockCount);
+    trailer.insert(trailer.end(), INDEX_MAGIC, INDEX_MAGIC + 8);
+    ok = ok && std::fwrite(index.data(), 1, index.size(), file) == index.size();
+    ok = ok && std::fwrite(trailer.data(), 1, trailer.size(), file) == trailer.size();
+
+    std::vector<std::uint8_t> count;
+    putU64(count, stateCount);
+    ok = ok && std::fseek(file, HEADER_SIZE - 8, SEEK_SET) == 0;
+    ok = ok && std::fwrite(count.data(), 1, count.size(), file) == count.size();
+    ok = (std::fclose(file) == 0) && ok;
+    file = nullptr;
+    return ok;
+}
+
+DatasetReader::DatasetReader() : flags(0), stateCount(0), decodedBlock(static_cast<std::size_t>(-1)), verifyChecksums(false) {}
+
+// Map the file, check header and trailer, load the block index
+bool DatasetReader::open(const std::string& path) {
+    blockOffsets.clear();
+    blockFirstStates.clear();
+    blockCounts.clear();
+    decodedBlock = static_cast<std::size_t>(-1);
+    if (!mapping.open(path)) return false;
+
+    const std::uint8_t* data = mapping.data();
+    std::size_t size = mapping.size();
+    if (size < HEADER_SIZE + TRAILER_SIZE || std::memcmp(data, FILE_MAGIC, 8) != 0 ||
+        getU32(data + 8) != FORMAT_VERSION ||
+        std::memcmp(data + size - 8, INDEX_MAGIC, 8) != 0) {
+        mapping.close();
+        return false;
+    }
+    flags = getU32(data + 12);
+    stateCount = getU64(data + 24);
+
+    std::uint64_t indexOffset = getU64(data + size - TRAILER_SIZE);
+    std::uint64_t blocks = getU64(data + size - TRAILER_SIZE + 8);
+    if (indexOffset + blocks * INDEX_ENTRY_SIZE + TRAILER_SIZE != size) {
+        mapping.close();
+        return false;
+    }
+    for (std::uint64_t b = 0; b < blocks; b++) {
+        const std::uint8_t* entry = data + indexOffset + b * INDEX_ENTRY_SIZE;
+        blockOffsets.push_back(getU64(entry));
+        blockFirstStates.push_back(getU64(entry + 8));
+        blockCounts.push_back(getU32(entry + 16));
+    }
+    return true;
+}
+
+// Locate the columns of a block, decompressing if needed
+bool DatasetReader::readBlock(std::size_t block, DatasetBlockView& view) {
+    if (block >= blockOffsets.size()) return false;
+    // Header must be inside the mapping before any of it is read
+    if (blockOffsets[block] > mapping.size() || mapping.size() - blockOffsets[block] < BLOCK_HEADER_SIZE) return false;
+    const std::uint8_t* header = mapping.data() + blockOffsets[block];
+    if (getU32(header) != BLOCK_MAGIC) return false;
+
+    std::uint32_t count = getU32(header + 4);
+    std::uint32_t compression = getU32(header + 8);
+    std::uint32_t rawSize = getU32(header + 12);
+    std::uint32_t storedSize = getU32(header + 16);
+    std::uint32_t checksum = getU32(header + 20);
+    const std::uint8_t* stored = header + BLOCK_HEADER_SIZE;
+    if (storedSize > mapping.size() - blockOffsets[block] - BLOCK_HEADER_SIZE) return false;
+
+    const std::uint8_t* payload = stored;
+    if (compression == COMPRESSION_ZLIB) {
+#ifdef RUBIK_HAVE_ZLIB
+        if (decodedBlock != block) {
+            decoded.resize(rawSize);
+            uLongf length = rawSize;
+            if (uncompress(decoded.data(), &length, stored, storedSize) != Z_OK || length != rawSize ||
+                fnv1a(decoded.data(), rawSize) != checksum) {
+                decodedBlock = static_cast<std::size_t>(-1);
+                return false;
+            }
+            decodedBlock = block;
+        }
+        payload = decoded.data();
+#else
+        return false;
+#endif
+    } else if (compression != COMPRESSION_NONE || rawSize != storedSize) {
+        return false;
+    } else if (verifyChecksums && fnv1a(payload, rawSize) != checksum) {
+        return false;
+    }
+
+    std::size_t fixedSize = static_cast<std::size_t>(count) * (RANKED_STATE_BYTES + 1);
+    if (hasSolutions()) fixedSize += 4 * (static_cast<std::size_t>(count) + 1);
+    if (fixedSize > rawSize) return false;
+
+    view.firstState = blockFirstStates[block];
+    view.count = count;
+    view.states = payload;
+    view.distances = payload + static_cast<std::size_t>(count) * RANKED_STATE_BYTES;
+    view.solutionOffsets = nullptr;
+    view.solutionMoves = nullptr;
+    if (hasSolutions()) {
+        view.solutionOffsets = view.distances + count;
+        view.solutionMoves = view.solutionOffsets + 4 * (static_cast<std::size_t>(count) + 1);
+        if (fixedSize + getU32(view.solutionOffsets + 4 * static_cast<std::size_t>(count)) > rawSize) return false;
+    }
+    return true;
+}
+
+// Binary search the index for the block holding entry i
+bool DatasetReader::get(std::uint64_t i, DatasetRecord& record) {
+    if (i >= stateCount) return false;
+    std::size_t block = static_cast<std::size_t>(
+        std::upper_bound(blockFirstStates.begin(), blockFirstStates.end(), i) - blockFirstStates.begin() - 1);
+
+    DatasetBlockView view;
+    if (!readBlock(block, view)) return false;
+    std::uint32_t local = static_cast<std::uint32_t>(i - view.firstState);
+    if (local >= view.count || !view.state(local, record.state)) return false;
+
+    record.distance = view.distance(local);
+    std::uint32_t length;
+    const std::uint8_t* moves = view.solution(local, length);
+    record.solution.assign(moves, moves + length);
+    return true;
+}
@@ -0,0 +1,126 @@
+// State Dataset Header
+// Block-columnar file format for large labelled lists of cube states
+//
+// File layout (all integers little-endian):
+//   header   "RBKSTAT1", u32 version, u32 flags, u32 block size, u32 reserved, u64 state count
+//   blocks   u32 "BLK1", u32 count, u32 compression, u32 raw size, u32 stored size, u32 FNV-1a of raw payload
+//            payload columns: states (9-byte ranked encoding each), distances (1 byte each),
+//            and with FLAG_SOLUTIONS: u32 offsets[count + 1], solution move bytes
+//   index    per block: u64 file offset, u64 first state, u32 count, u32 reserved
+//   trailer  u64 index offset, u64 block count, "RBKINDX1"
+
+#ifndef STATE_DATASET_H
+#define STATE_DATASET_H
+
+#include "cubie_cube.h"
+#include "mapped_file.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+enum DatasetFlags {
+    FLAG_SOLUTIONS = 1
+};
+
+enum DatasetCompression {
+    COMPRESSION_NONE = 0,
+    COMPRESSION_ZLIB = 1
+};
+
+struct DatasetOptions {
+    std::uint32_t blockSize;    // States per block
+    bool compress;              // zlib per block (ignored when built without zlib)
+    bool solutions;             // Store a solution column
+
+    DatasetOptions() : blockSize(65536), compress(false), solutions(true) {}
+};
+
+// One decoded entry
+struct DatasetRecord {
+    CubieCube state;
+    std::uint8_t distance;
+    std::vector<std::uint8_t> solution;  // Move indices
+};
+
+// Columns of one block; points into the file mapping when the block is stored uncompressed
+struct DatasetBlockView {
+    std::uint64_t firstState;
+    std::uint32_t count;
+    const std::uint8_t* states;          // count * RANKED_STATE_BYTES
+    const std::uint8_t* distances;       // count
+    const std::uint8_t* solutionOffsets; // (count + 1) little-endian u32, or null
+    const std::uint8_t* solutionMoves;
+
+    bool state(std::uint32_t i, CubieCube& out) const {
+        return CubieCube::decodeRanked(states + static_cast<std::size_t>(i) * RANKED_STATE_BYTES, out);
+    }
+    std::uint8_t distance(std::uint32_t i) const { return distances[i]; }
+
+    // Solution moves of entry i (length 0 if the file has no solutions)
+    const std::uint8_t* solution(std::uint32_t i, std::uint32_t& length) const;
+};
+
+// Streaming writer - buffers one block at a time
+class DatasetWriter {
+private:
+    std::FILE* file;
+    DatasetOptions options;
+    std::uint64_t stateCount;
+    std::vector<std::uint8_t> states;
+    std::vector<std::uint8_t> distances;
+    std::vector<std::uint32_t> solutionOffsets;
+    std::vector<std::uint8_t> solutionMoves;
+    std::vector<std::uint8_t> payload;
+    std::vector<std::uint8_t> compressed;
+    std::vector<std::uint8_t> index;
+    std::uint64_t blockCount;
+
+    bool flushBlock();
+
+public:
+    DatasetWriter();
+    ~DatasetWriter();
+
+    bool open(const std::string& path, const DatasetOptions& datasetOptions = DatasetOptions());
+    bool add(const CubieCube& state, std::uint8_t distance, const std::uint8_t* solution = nullptr, std::size_t length = 0);
+
+    // Flush the last block and write index and trailer
+    bool close();
+
+    std::uint64_t size() const { return stateCount; }
+};
+
+// Memory-mapped reader with random access through the block index
+class DatasetReader {
+private:
+    MappedFile mapping;
+    std::uint32_t flags;
+    std::uint64_t stateCount;
+    std::vector<std::uint64_t> blockOffsets;
+    std::vector<std::uint64_t> blockFirstStates;
+    std::vector<std::uint32_t> blockCounts;
+    std::vector<std::uint8_t> decoded;   // Decompressed payload of the last compressed block
+    std::size_t decodedBlock;
+    bool verifyChecksums;
+
+public:
+    DatasetReader();
+
+    bool open(const std::string& path);
+
+    std::uint64_t size() const { return stateCount; }
+    std::size_t blockCount() const { return blockOffsets.size(); }
+    bool hasSolutions() const { return (flags & FLAG_SOLUTIONS) != 0; }
+
+    // Check block checksums on every read (uncompressed blocks are otherwise not touched)
+    void setVerifyChecksums(bool verify) { verifyChecksums = verify; }
+
+    // Columns of block i; the view stays valid until the next readBlock() call
+    bool readBlock(std::size_t block, DatasetBlockView& view);
+
+    // Random access to entry i
+    bool get(std::uint64_t i, DatasetRecord& record);
+};
+
+#endif // STATE_DATASET_H
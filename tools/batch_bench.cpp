@@ -0,0 +1,99 @@
+// Batch Benchmark
+// Moves/sec of RubikCube, CubieCube and the bit-sliced BatchCube on the same random sequence,
+// then batch hashing against CubieCube::hash on the same states (exits 1 if batch is slower)
+//
+//   rubik_batch_bench [lanes] [moves]
+
+#include "batch_cube.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void report(const char* name, double cubeMoves, double seconds) {
+    std::cout << name << cubeMoves / seconds / 1e6 << " M moves/s" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t lanes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 65536;
+    std::size_t moveCount = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000;
+    if (lanes == 0 || moveCount == 0) {
+        std::cerr << "Usage: rubik_batch_bench [lanes] [moves]" << std::endl;
+        return 1;
+    }
+
+    std::mt19937 rng(7);
+    std::vector<int> moves(moveCount);
+    for (int& move : moves) move = static_cast<int>(rng() % NUM_MOVES);
+
+    // Scalar baselines run the sequence once per lane on a sample of lanes
+    std::size_t sample = std::min<std::size_t>(lanes, 1024);
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t lane = 0; lane < sample; lane++) {
+        RubikCube cube;
+        for (int move : moves) cube.applyMoveIndex(move);
+    }
+    report("RubikCube: ", static_cast<double>(sample) * moveCount, secondsSince(start));
+
+    start = std::chrono::steady_clock::now();
+    std::uint64_t checksum = 0;
+    for (std::size_t lane = 0; lane < sample; lane++) {
+        CubieCube cube;
+        for (int move : moves) cube.applyMove(move);
+        checksum += cube.hash();
+    }
+    report("CubieCube: ", static_cast<double>(sample) * moveCount, secondsSince(start));
+
+    // Batch: distinct start states so the lanes do real work
+    BatchCube batch(lanes);
+    for (std::size_t lane = 0; lane < lanes; lane++) {
+        CubieCube cube;
+        for (int i = 0; i < 20; i++) cube.applyMove(static_cast<int>(rng() % NUM_MOVES));
+        batch.load(lane, cube);
+    }
+    start = std::chrono::steady_clock::now();
+    batch.applySequence(moves.data(), moves.size());
+    report("BatchCube: ", static_cast<double>(lanes) * moveCount, secondsSince(start));
+
+    // Hashing: every lane through CubieCube::hash versus one batch pass, each repeated so the
+    // timings are not a single sub-millisecond sample
+    const int hashRounds = 16;
+    std::vector<CubieCube> cubes(lanes);
+    for (std::size_t lane = 0; lane < lanes; lane++) batch.store(lane, cubes[lane]);
+    start = std::chrono::steady_clock::now();
+    for (int round = 0; round < hashRounds; round++) {
+        for (const CubieCube& cube : cubes) checksum += cube.hash();
+    }
+    double scalarRate = static_cast<double>(lanes) * hashRounds / secondsSince(start) / 1e6;
+    std::cout << "CubieCube hash: " << scalarRate << " M cubes/s" << std::endl;
+
+    std::vector<std::uint64_t> hashes;
+    start = std::chrono::steady_clock::now();
+    for (int round = 0; round < hashRounds; round++) {
+        batch.hashes(hashes);
+        checksum += hashes[round % lanes];
+    }
+    double batchRate = static_cast<double>(lanes) * hashRounds / secondsSince(start) / 1e6;
+    std::cout << "BatchCube hash: " << batchRate << " M cubes/s" << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    std::size_t solved = batch.countSolved();
+    std::cout << "Solved check: " << lanes / secondsSince(start) / 1e6 << " M cubes/s ("
+              << solved << " solved, checksum " << (checksum & 0xFFFF) << ")" << std::endl;
+
+    if (batchRate < scalarRate) {
+        std::cerr << "Batch hashing is slower than CubieCube::hash" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,193 @@
+// Dataset Tool
+// Generate, inspect and scan state dataset files
+//
+//   rubik_dataset generate <file> <count> [--depth N] [--seed S] [--block N] [--compress] [--no-solutions]
+//   rubik_dataset info <file>
+//   rubik_dataset scan <file> [--verify]
+//   rubik_dataset get <file> <index>
+
+#include "state_dataset.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+
+namespace {
+
+void printUsage() {
+    std::cerr << "Usage:\n"
+              << "  rubik_dataset generate <file> <count> [--depth N] [--seed S] [--block N] [--compress] [--no-solutions]\n"
+              << "  rubik_dataset info <file>\n"
+              << "  rubik_dataset scan <file> [--verify]\n"
+              << "  rubik_dataset get <file> <index>\n";
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Random walks from solved; distance is the walk length (an upper bound), solution the inverted walk
+int generate(int argc, char* argv[]) {
+    if (argc < 4) {
+        printUsage();
+        return 1;
+    }
+    std::string path = argv[2];
+    std::uint64_t count = std::strtoull(argv[3], nullptr, 10);
+    int maxDepth = 20;
+    unsigned int seed = 1;
+    DatasetOptions options;
+    for (int i = 4; i < argc; i++) {
+        if (std::strcmp(argv[i], "--depth") == 0 && i + 1 < argc) {
+            maxDepth = std::min(255, std::max(1, std::atoi(argv[++i])));
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--block") == 0 && i + 1 < argc) {
+            options.blockSize = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--compress") == 0) {
+            options.compress = true;
+        } else if (std::strcmp(argv[i], "--no-solutions") == 0) {
+            options.solutions = false;
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    DatasetWriter writer;
+    if (!writer.open(path, options)) {
+        std::cerr << "Cannot create " << path << std::endl;
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::mt19937 rng(seed);
+    std::uint8_t walk[256];
+    std::uint8_t solution[256];
+    for (std::uint64_t n = 0; n < count; n++) {
+        int depth = 1 + static_cast<int>(rng() % maxDepth);
+        CubieCube state;
+        int last = -1;
+        for (int i = 0; i < depth; i++) {
+            // Never turn the same face twice in a row
+            int move;
+            do {
+                move = static_cast<int>(rng() % NUM_MOVES);
+            } while (last >= 0 && move / 3 == last / 3);
+            state.applyMove(move);
+            walk[i] = static_cast<std::uint8_t>(move);
+            last = move;
+        }
+        for (int i = 0; i < depth; i++) {
+            solution[i] = static_cast<std::uint8_t>(inverseMove(walk[depth - 1 - i]));
+        }
+        if (!writer.add(state, static_cast<std::uint8_t>(depth), solution, depth)) {
+            std::cerr << "Write failed at entry " << n << std::endl;
+            return 1;
+        }
+    }
+    if (!writer.close()) {
+        std::cerr << "Write failed while finishing " << path << std::endl;
+        return 1;
+    }
+
+    std::cout << "Wrote " << count << " states in " << secondsSince(start) << " s" << std::endl;
+    return 0;
+}
+
+int info(const std::string& path) {
+    DatasetReader reader;
+    if (!reader.open(path)) {
+        std::cerr << "Cannot read " << path << std::endl;
+        return 1;
+    }
+    MappedFile file;
+    file.open(path);
+    std::cout << "States:    " << reader.size() << "\n"
+              << "Blocks:    " << reader.blockCount() << "\n"
+              << "Solutions: " << (reader.hasSolutions() ? "yes" : "no") << "\n"
+              << "File size: " << file.size() << " bytes";
+    if (reader.size() > 0) {
+        std::cout << " (" << static_cast<double>(file.size()) / reader.size() << " bytes/state)";
+    }
+    std::cout << std::endl;
+    return 0;
+}
+
+// Decode every state block by block and report throughput and the distance histogram
+int scan(const std::string& path, bool verify) {
+    DatasetReader reader;
+    if (!reader.open(path)) {
+        std::cerr << "Cannot read " << path << std::endl;
+        return 1;
+    }
+    reader.setVerifyChecksums(verify);
+
+    auto start = std::chrono::steady_clock::now();
+    std::uint64_t histogram[256] = {};
+    std::uint64_t decodedStates = 0;
+    std::uint64_t invalid = 0;
+    DatasetBlockView view;
+    CubieCube state;
+    for (std::size_t b = 0; b < reader.blockCount(); b++) {
+        if (!reader.readBlock(b, view)) {
+            std::cerr << "Block " << b << " is corrupt" << std::endl;
+            return 1;
+        }
+        for (std::uint32_t i = 0; i < view.count; i++) {
+            if (!view.state(i, state)) invalid++;
+            histogram[view.distance(i)]++;
+        }
+        decodedStates += view.count;
+    }
+    double seconds = secondsSince(start);
+
+    std::cout << "Decoded " << decodedStates << " states in " << seconds << " s";
+    if (seconds > 0.0) {
+        std::cout << " (" << decodedStates / seconds / 1e6 << " M states/s)";
+    }
+    std::cout << "\nInvalid:  " << invalid << "\n";
+    for (int d = 0; d < 256; d++) {
+        if (histogram[d]) std::cout << "  distance " << d << ": " << histogram[d] << "\n";
+    }
+    return invalid == 0 ? 0 : 1;
+}
+
+int get(const std::string& path, std::uint64_t index) {
+    DatasetReader reader;
+    DatasetRecord record;
+    if (!reader.open(path) || !reader.get(index, record)) {
+        std::cerr << "Cannot read entry " << index << " of " << path << std::endl;
+        return 1;
+    }
+
+    std::cout << "Distance: " << static_cast<int>(record.distance) << "\nSolution:";
+    for (std::uint8_t move : record.solution) {
+        std::cout << " " << moveToString(move);
+    }
+    CubieCube check = record.state;
+    for (std::uint8_t move : record.solution) {
+        check.applyMove(move);
+    }
+    std::cout << "\nSolution verified: " << (check.isSolved() ? "yes" : "no") << std::endl;
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        printUsage();
+        return 1;
+    }
+    std::string command = argv[1];
+    if (command == "generate") return generate(argc, argv);
+    if (command == "info") return info(argv[2]);
+    if (command == "scan") return scan(argv[2], argc > 3 && std::strcmp(argv[3], "--verify") == 0);
+    if (command == "get" && argc > 3) return get(argv[2], std::strtoull(argv[3], nullptr, 10));
+    printUsage();
+    return 1;
+}
@@ -0,0 +1,247 @@
+// Estimate Tool
+// Query, benchmark and retrain the distance-to-solved estimator
+//
+//   rubik_estimate "<scramble>"
+//   rubik_estimate bench [count] [seed]
+//   rubik_estimate fit [samples] [seed]
+//
+// fit draws random walks of 1..20 moves (no repeated or out-of-order opposite faces) and
+// labels them with the optimal distance from CubeSearch when the walk has at most
+// EXACT_DEPTH moves, otherwise with the walk length capped at 18 (the typical distance of a
+// random state). It trains the 13-8-1 network with Adam and prints the weights as the
+// initializer for DEFAULT_WEIGHTS in distance_estimator.cpp.
+
+#include "distance_estimator.h"
+#include "move_sequence.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+
+namespace {
+
+const int EXACT_DEPTH = 8;
+const int MAX_WALK = 20;
+const float DEEP_LABEL_CAP = 18.0f;
+const float EXACT_WEIGHT = 4.0f;  // Exact labels count more than the noisy walk lengths
+
+struct Sample {
+    CubieCube cube;
+    float label;   // Moves
+    bool exact;    // label is the optimal distance
+};
+
+// Random walk that CubeSearch would not prune (so short walks are mostly near-optimal)
+void randomWalk(std::mt19937& rng, int length, CubieCube& cube) {
+    cube = CubieCube();
+    int lastFace = -1;
+    for (int i = 0; i < length; i++) {
+        int move, face;
+        do {
+            move = static_cast<int>(rng() % NUM_MOVES);
+            face = move / 3;
+        } while (face == lastFace || (lastFace >= 0 && face / 2 == lastFace / 2 && face < lastFace));
+        cube.applyMove(move);
+        lastFace = face;
+    }
+}
+
+std::vector<Sample> makeSamples(int count, std::uint32_t seed, int maxWalk) {
+    std::mt19937 rng(seed);
+    CubeSearch search;
+    SearchResult result;
+    std::vector<Sample> samples(static_cast<std::size_t>(count));
+    for (Sample& sample : samples) {
+        int length = 1 + static_cast<int>(rng() % static_cast<std::uint32_t>(maxWalk));
+        randomWalk(rng, length, sample.cube);
+        sample.exact = length <= EXACT_DEPTH;
+        if (sample.exact) {
+            search.solve(sample.cube, length, result);
+            sample.label = static_cast<float>(result.length);
+        } else {
+            sample.label = std::min(static_cast<float>(length), DEEP_LABEL_CAP);
+        }
+    }
+    return samples;
+}
+
+int queryOne(const std::string& text) {
+    std::vector<int> moves;
+    if (!parseSequence(text, moves)) {
+        std::cerr << "Invalid move sequence" << std::endl;
+        return 1;
+    }
+    CubieCube cube;
+    for (int move : moves) cube.applyMove(move);
+
+    DistanceEstimator estimator;
+    DistanceEstimate estimate = estimator.estimate(cube);
+    std::printf("Estimate: %.1f moves (lower bound %d)\n", estimate.moves, estimate.lowerBound);
+    if (estimate.moves <= EXACT_DEPTH + 1) {
+        CubeSearch search;
+        SearchResult result;
+        if (search.solve(cube, EXACT_DEPTH + 2, result)) std::printf("Optimal:  %d moves\n", result.length);
+    }
+    return 0;
+}
+
+int bench(int count, std::uint32_t seed) {
+    std::vector<Sample> samples = makeSamples(count, seed, MAX_WALK);
+    std::vector<CubieCube> cubes;
+    for (const Sample& sample : samples) cubes.push_back(sample.cube);
+    std::vector<DistanceEstimate> estimates(cubes.size());
+
+    // Accuracy against exact labels, network vs the bare lower bound
+    DistanceEstimator estimator;
+    estimator.estimateBatch(cubes.data(), cubes.size(), estimates.data());
+    double networkError = 0.0, boundError = 0.0;
+    int exact = 0;
+    for (std::size_t i = 0; i < samples.size(); i++) {
+        if (!samples[i].exact) continue;
+        networkError += std::fabs(estimates[i].moves - samples[i].label);
+        boundError += std::fabs(estimates[i].lowerBound - samples[i].label);
+        exact++;
+    }
+    std::printf("%d states, %d with known optimal distance (<= %d moves)\n", count, exact, EXACT_DEPTH);
+    std::printf("  mean absolute error: estimate %.2f, lower bound alone %.2f\n",
+                networkError / std::max(exact, 1), boundError / std::max(exact, 1));
+
+    // Typical distance of a game scramble is 17-18 moves
+    std::mt19937 rng(seed);
+    std::vector<int> moves;
+    double scrambleEstimate = 0.0;
+    for (int i = 0; i < 1000; i++) {
+        scrambleMoves(25, rng(), moves);
+        CubieCube cube;
+        for (int move : moves) cube.applyMove(move);
+        scrambleEstimate += estimator.estimate(cube).moves;
+    }
+    std::printf("  mean estimate for 25-move game scrambles: %.1f\n", scrambleEstimate / 1000);
+
+    auto time = [&](const char* label, auto&& body) {
+        auto start = std::chrono::steady_clock::now();
+        body();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::printf("  %-22s %8.1f ns/state\n", label, seconds * 1e9 / count);
+    };
+    time("single, cold cache", [&] {
+        DistanceEstimator cold;
+        for (std::size_t i = 0; i < cubes.size(); i++) estimates[i] = cold.estimate(cubes[i]);
+    });
+    time("batch of 256, cold", [&] {
+        DistanceEstimator cold;
+        for (std::size_t i = 0; i < cubes.size(); i += 256) {
+            std::size_t n = std::min<std::size_t>(256, cubes.size() - i);
+            cold.estimateBatch(&cubes[i], n, &estimates[i]);
+        }
+    });
+    time("single, cached", [&] {
+        for (std::size_t i = 0; i < cubes.size(); i++) estimates[i] = estimator.estimate(cubes[i]);
+    });
+    std::printf("  cache: %llu hits, %llu misses\n", static_cast<unsigned long long>(estimator.cacheHits()),
+                static_cast<unsigned long long>(estimator.cacheMisses()));
+    return 0;
+}
+
+// Adam on mean squared error, labels scaled by 1 / ESTIMATOR_SCALE
+int fit(int count, std::uint32_t seed) {
+    const int EPOCHS = 40;
+    const int BATCH = 64;
+    const float RATE = 0.003f, BETA1 = 0.9f, BETA2 = 0.999f, EPSILON = 1e-8f;
+    const int PARAMETERS = sizeof(EstimatorWeights) / sizeof(float);
+
+    std::fprintf(stderr, "Labelling %d samples...\n", count);
+    std::vector<Sample> samples = makeSamples(count, seed, MAX_WALK);
+    std::vector<float> features(samples.size() * ESTIMATOR_FEATURES);
+    for (std::size_t i = 0; i < samples.size(); i++) estimatorFeatures(samples[i].cube, &features[i * ESTIMATOR_FEATURES]);
+
+    std::mt19937 rng(seed);
+    EstimatorWeights weights;
+    float* w = reinterpret_cast<float*>(&weights);
+    std::normal_distribution<float> initial(0.0f, std::sqrt(2.0f / ESTIMATOR_FEATURES));
+    for (int i = 0; i < PARAMETERS; i++) w[i] = initial(rng) * 0.5f;
+    std::vector<float> m(PARAMETERS, 0.0f), v(PARAMETERS, 0.0f);
+    std::vector<std::size_t> order(samples.size());
+    for (std::size_t i = 0; i < order.size(); i++) order[i] = i;
+
+    long step = 0;
+    for (int epoch = 0; epoch < EPOCHS; epoch++) {
+        std::shuffle(order.begin(), order.end(), rng);
+        double loss = 0.0;
+        for (std::size_t first = 0; first < order.size(); first += BATCH) {
+            EstimatorWeights gradient{};
+            float* g = reinterpret_cast<float*>(&gradient);
+            std::size_t last = std::min(first + BATCH, order.size());
+            for (std::size_t k = first; k < last; k++) {
+                const float* x = &features[order[k] * ESTIMATOR_FEATURES];
+                float hidden[ESTIMATOR_HIDDEN];
+                float y = weights.outputBias;
+                for (int h = 0; h < ESTIMATOR_HIDDEN; h++) {
+                    float sum = weights.hiddenBias[h];
+                    for (int f = 0; f < ESTIMATOR_FEATURES; f++) sum += weights.hidden[h][f] * x[f];
+                    hidden[h] = sum > 0.0f ? sum : 0.0f;
+                    y += weights.output[h] * hidden[h];
+                }
+                float error = y - samples[order[k]].label / ESTIMATOR_SCALE;
+                loss += error * error;
+                if (samples[order[k]].exact) error *= EXACT_WEIGHT;
+                gradient.outputBias += error;
+                for (int h = 0; h < ESTIMATOR_HIDDEN; h++) {
+                    gradient.output[h] += error * hidden[h];
+                    if (hidden[h] <= 0.0f) continue;
+                    float back = error * weights.output[h];
+                    gradient.hiddenBias[h] += back;
+                    for (int f = 0; f < ESTIMATOR_FEATURES; f++) gradient.hidden[h][f] += back * x[f];
+                }
+            }
+            step++;
+            float scale = 1.0f / static_cast<float>(last - first);
+            float correction1 = 1.0f - std::pow(BETA1, static_cast<float>(step));
+            float correction2 = 1.0f - std::pow(BETA2, static_cast<float>(step));
+            for (int i = 0; i < PARAMETERS; i++) {
+                float grad = g[i] * scale;
+                m[i] = BETA1 * m[i] + (1.0f - BETA1) * grad;
+                v[i] = BETA2 * v[i] + (1.0f - BETA2) * grad * grad;
+                w[i] -= RATE * (m[i] / correction1) / (std::sqrt(v[i] / correction2) + EPSILON);
+            }
+        }
+        std::fprintf(stderr, "epoch %2d: rms error %.3f moves\n", epoch + 1,
+                     std::sqrt(loss / samples.size()) * ESTIMATOR_SCALE);
+    }
+
+    std::printf("// Trained with `rubik_estimate fit` (seed %u, %d samples)\n", seed, count);
+    std::printf("const EstimatorWeights DEFAULT_WEIGHTS = {\n    {\n");
+    for (int h = 0; h < ESTIMATOR_HIDDEN; h++) {
+        std::printf("        {");
+        for (int f = 0; f < ESTIMATOR_FEATURES; f++) std::printf("%s%.6ff", f ? ", " : "", weights.hidden[h][f]);
+        std::printf("},\n");
+    }
+    std::printf("    },\n    {");
+    for (int h = 0; h < ESTIMATOR_HIDDEN; h++) std::printf("%s%.6ff", h ? ", " : "", weights.hiddenBias[h]);
+    std::printf("},\n    {");
+    for (int h = 0; h < ESTIMATOR_HIDDEN; h++) std::printf("%s%.6ff", h ? ", " : "", weights.output[h]);
+    std::printf("},\n    %.6ff\n};\n", weights.outputBias);
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage:\n"
+                  << "  rubik_estimate \"<scramble>\"\n"
+                  << "  rubik_estimate bench [count] [seed]\n"
+                  << "  rubik_estimate fit [samples] [seed]\n";
+        return 1;
+    }
+    std::string command = argv[1];
+    int count = argc > 2 ? std::atoi(argv[2]) : 0;
+    std::uint32_t seed = argc > 3 ? static_cast<std::uint32_t>(std::strtoul(argv[3], nullptr, 10)) : 1;
+    if (command == "bench") return bench(count > 0 ? count : 20000, seed);
+    if (command == "fit") return fit(count > 0 ? count : 100000, seed);
+    return queryOne(command);
+}
@@ -0,0 +1,49 @@
+// Move Fuzzer
+// libFuzzer entry point: arbitrary bytes as a move string, checked like rubik_verify does
+//
+//   cmake .. -DCMAKE_CXX_COMPILER=clang++ -DRUBIK_BUILD_FUZZER=ON -DRUBIK_BUILD_GAME=OFF
+//   ./rubik_fuzz_moves -max_len=256 corpus/
+
+#include "move_checks.h"
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+namespace {
+
+const std::size_t MAX_MOVES = 1024;
+
+void report(const std::string& failure) {
+    std::fprintf(stderr, "%s\n", failure.c_str());
+    std::abort();
+}
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size) {
+    std::string text(reinterpret_cast<const char*>(data), size);
+
+    // RubikCube::applyMove must accept exactly the tokens parseSequence accepts
+    std::vector<int> moves;
+    bool parsed = parseSequence(text, moves);
+    std::istringstream tokens(text);
+    std::string token;
+    RubikCube byToken;
+    bool allAccepted = true;
+    while (tokens >> token) allAccepted = byToken.applyMove(token) && allAccepted;
+    if (parsed != allAccepted) report("parseSequence and RubikCube::applyMove disagree on \"" + text + "\"");
+    if (!parsed || moves.size() > MAX_MOVES) return 0;
+
+    // Notation round-trip
+    std::vector<int> reparsed;
+    if (!parseSequence(sequenceToString(moves), reparsed) || reparsed != moves) {
+        report("sequenceToString does not round-trip \"" + text + "\"");
+    }
+
+    std::string failure;
+    RubikCube reference;
+    for (int move : moves) reference.applyMoveIndex(move);
+    if (!sameStickers(reference, byToken)) report("string and index moves differ for \"" + text + "\"");
+    if (!checkSequence(moves, failure)) report(failure);
+    return 0;
+}
@@ -0,0 +1,134 @@
+// Human Solve Tool
+// Solve scrambles stage by stage (cross, F2L, OLL, PLL) and report per-stage cost
+//
+//   rubik_cfop <last_layer.db> "<scramble>"
+//   rubik_cfop <last_layer.db> bench [count] [seed]
+
+#include "human_solver.h"
+#include "move_sequence.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+
+namespace {
+
+const int BENCH_SCRAMBLE_MOVES = 25;
+
+void printUsage() {
+    std::cerr << "Usage:\n"
+              << "  rubik_cfop <last_layer.db> \"<scramble>\"\n"
+              << "  rubik_cfop <last_layer.db> bench [count] [seed]\n";
+}
+
+int solveOne(const HumanSolver& solver, const std::string& text) {
+    std::vector<int> moves;
+    if (!parseSequence(text, moves)) {
+        std::cerr << "Invalid move sequence" << std::endl;
+        return 1;
+    }
+    CubieCube cube;
+    for (int move : moves) cube.applyMove(move);
+
+    std::vector<SolveStage> stages;
+    if (!solver.solve(cube, stages)) {
+        std::cerr << "No solution" << std::endl;
+        return 1;
+    }
+    double total = 0.0;
+    for (const SolveStage& stage : stages) {
+        std::cout << std::left << std::setw(16) << stage.name << std::right << std::setw(3) << stage.moves.size()
+                  << "  " << sequenceToString(stage.moves) << std::endl;
+        total += stage.microseconds;
+    }
+    std::cout << flattenStages(stages).size() << " moves in " << total << " us" << std::endl;
+    return 0;
+}
+
+// Stage statistics grouped by kind (the four pairs are reported together)
+struct StageTotals {
+    double microseconds = 0.0;
+    std::uint64_t nodes = 0;
+    std::uint64_t moves = 0;
+    std::uint64_t count = 0;
+};
+
+int bench(const HumanSolver& solver, std::uint64_t count, std::uint32_t seed) {
+    auto start = std::chrono::steady_clock::now();
+    HumanSolver::warmUp();
+    std::cout << "Tables built in " << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count()
+              << " ms" << std::endl;
+
+    const char* kinds[] = {"Cross", "F2L", "OLL", "PLL"};
+    std::map<std::string, StageTotals> totals;
+    std::vector<SolveStage> stages;
+    std::vector<int> scramble;
+    std::uint64_t failed = 0, moves = 0;
+    double worst = 0.0, sum = 0.0;
+    for (std::uint64_t n = 0; n < count; n++) {
+        scrambleMoves(BENCH_SCRAMBLE_MOVES, seed + static_cast<std::uint32_t>(n), scramble);
+        CubieCube cube;
+        for (int move : scramble) cube.applyMove(move);
+        if (!solver.solve(cube, stages)) {
+            failed++;
+            continue;
+        }
+        double cubeTime = 0.0;
+        for (const SolveStage& stage : stages) {
+            // "F2L FR" -> F2L, "AUF" and "PLL skip" -> PLL
+            std::string kind = stage.name.substr(0, stage.name.find(' '));
+            if (kind == "AUF") kind = "PLL";
+            StageTotals& entry = totals[kind];
+            entry.microseconds += stage.microseconds;
+            entry.nodes += stage.nodes;
+            entry.moves += stage.moves.size();
+            entry.count++;
+            cubeTime += stage.microseconds;
+        }
+        moves += flattenStages(stages).size();
+        sum += cubeTime;
+        if (cubeTime > worst) worst = cubeTime;
+    }
+
+    std::uint64_t solved = count - failed;
+    if (solved == 0) {
+        std::cerr << "No scramble solved" << std::endl;
+        return 1;
+    }
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Stage   avg us  avg probes  avg moves" << std::endl;
+    for (const char* kind : kinds) {
+        const StageTotals& entry = totals[kind];
+        double perCube = static_cast<double>(solved);
+        std::cout << std::left << std::setw(6) << kind << std::right << std::setw(8) << entry.microseconds / perCube
+                  << std::setw(12) << entry.nodes / perCube << std::setw(11) << entry.moves / perCube << std::endl;
+    }
+    std::cout << solved << " solved, " << failed << " failed; " << moves / static_cast<double>(solved)
+              << " moves and " << sum / solved << " us per cube (worst " << worst << " us)" << std::endl;
+    return failed ? 1 : 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        printUsage();
+        return 1;
+    }
+    LastLayerDatabase database;
+    if (!database.open(argv[1])) {
+        std::cerr << "Cannot read " << argv[1] << " (create it with rubik_lldb build)" << std::endl;
+        return 1;
+    }
+    HumanSolver solver(&database);
+
+    std::string command = argv[2];
+    if (command == "bench") {
+        std::uint64_t count = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 10000;
+        std::uint32_t seed = argc > 4 ? static_cast<std::uint32_t>(std::strtoul(argv[4], nullptr, 10)) : 1;
+        return bench(solver, count, seed);
+    }
+    return solveOne(solver, command);
+}
@@ -0,0 +1,187 @@
+// Last Layer Tool
+// Build, inspect and query the last-layer case database
+//
+//   rubik_lldb build <file>
+//   rubik_lldb info <file>
+//   rubik_lldb recognize <file> "<moves applied to a solved cube>"
+//   rubik_lldb check <file>
+//   rubik_lldb bench <file> [count]
+//
+// check solves every one of the 62208 slots and fails (exit 1) if a solution does not solve
+// its state, or if a well-known case from any side comes back longer than its standard
+// algorithm.
+
+#include "last_layer.h"
+#include "move_sequence.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+
+namespace {
+
+void printUsage() {
+    std::cerr << "Usage:\n"
+              << "  rubik_lldb build <file>\n"
+              << "  rubik_lldb info <file>\n"
+              << "  rubik_lldb recognize <file> \"<moves>\"\n"
+              << "  rubik_lldb check <file>\n"
+              << "  rubik_lldb bench <file> [count]\n";
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int build(const std::string& path) {
+    auto start = std::chrono::steady_clock::now();
+    LastLayerDatabase database;
+    database.build();
+    if (!database.save(path)) {
+        std::cerr << "Cannot write " << path << std::endl;
+        return 1;
+    }
+    std::cout << "Built " << database.size() << " cases (" << database.ollCases() << " OLL, "
+              << database.pllCases() << " PLL) in " << secondsSince(start) << " s" << std::endl;
+    return 0;
+}
+
+int info(const LastLayerDatabase& database) {
+    std::cout << "Cases: " << database.size() << "\nOLL classes:";
+    for (std::uint32_t i = 0; i < database.ollCases(); i++) std::cout << (i % 8 ? ", " : "\n  ") << database.ollName(i);
+    std::cout << "\nPLL cases:";
+    for (std::uint32_t i = 0; i < database.pllCases(); i++) std::cout << (i % 8 ? ", " : "\n  ") << database.pllName(i);
+    std::cout << std::endl;
+    return 0;
+}
+
+int recognize(const LastLayerDatabase& database, const std::string& text) {
+    std::vector<int> moves;
+    if (!parseSequence(text, moves)) {
+        std::cerr << "Invalid move sequence" << std::endl;
+        return 1;
+    }
+    CubieCube cube;
+    for (int move : moves) cube.applyMove(move);
+
+    LastLayerMatch match;
+    if (!database.recognize(cube, match)) {
+        std::cout << "First two layers are not solved" << std::endl;
+        return 1;
+    }
+    match.solution(moves);
+    std::cout << "Case " << match.caseId << "\nOLL: " << database.ollName(match.oll)
+              << "\nPLL: " << (match.pll == NO_LAST_LAYER_CLASS ? "-" : database.pllName(match.pll))
+              << "\nZBLL: " << (match.edgesOriented ? "yes" : "no")
+              << "\nSolution: " << sequenceToString(moves) << " (" << moves.size() << " moves)" << std::endl;
+    return 0;
+}
+
+struct KnownCase {
+    const char* name;
+    const char* algorithm;
+};
+
+const KnownCase KNOWN_CASES[] = {
+    {"T-perm", "R U R' U' R' F R2 U' R' U' R U R' F'"},
+    {"Sune", "R U R' U R U2 R'"},
+    {"Antisune", "R U2 R' U' R U' R'"},
+    {"Ua-perm", "R U' R U R U R U' R' U' R2"},
+    {"Line", "F R U R' U' F'"},
+};
+
+int check(const LastLayerDatabase& database) {
+    int failures = 0;
+    std::size_t totalLength = 0;
+    LastLayerMatch match;
+    std::vector<int> moves;
+    for (int index = 0; index < LAST_LAYER_STATES; index++) {
+        CubieCube state = lastLayerState(index);
+        if (!database.recognize(state, match)) {
+            failures++;
+            continue;
+        }
+        match.solution(moves);
+        for (int move : moves) state.applyMove(move);
+        if (!state.isSolved()) {
+            if (failures < 5) std::cerr << "Slot " << index << ": " << sequenceToString(moves) << " does not solve it\n";
+            failures++;
+        }
+        totalLength += moves.size();
+    }
+    std::cout << LAST_LAYER_STATES - failures << " / " << LAST_LAYER_STATES << " slots solved, average "
+              << static_cast<double>(totalLength) / LAST_LAYER_STATES << " moves" << std::endl;
+
+    // The state a standard algorithm solves, seen from all four sides (y = U^a * state * U^-a)
+    for (const KnownCase& known : KNOWN_CASES) {
+        std::vector<int> algorithm;
+        parseSequence(known.algorithm, algorithm);
+        for (int side = 0; side < 4; side++) {
+            CubieCube state;
+            for (int u = 0; u < side; u++) state.applyMove(UP * 3);
+            for (auto it = algorithm.rbegin(); it != algorithm.rend(); ++it) state.applyMove(inverseMove(*it));
+            for (int u = 0; u < side; u++) state.applyMove(UP * 3 + 2);
+            if (!database.recognize(state, match)) {
+                failures++;
+                continue;
+            }
+            match.solution(moves);
+            if (moves.size() > algorithm.size()) {
+                std::cerr << known.name << " from side " << side << ": " << sequenceToString(moves) << " ("
+                          << moves.size() << " moves, standard " << algorithm.size() << ")\n";
+                failures++;
+            }
+        }
+    }
+    std::cout << (failures == 0 ? "All checks passed" : "Checks failed") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
+
+// Tag random last-layer states: scramble the U layer with random algorithm-like sequences first
+int bench(const LastLayerDatabase& database, std::uint64_t count) {
+    const char* mixers[] = {"R U R' U R U2 R'", "F R U R' U' F'", "R U R' U' R' F R2 U' R' U' R U R' F'", "U", "U2"};
+    std::mt19937 rng(11);
+    std::vector<CubieCube> states(4096);
+    for (CubieCube& state : states) {
+        for (int i = 0; i < 8; i++) {
+            std::vector<int> moves;
+            parseSequence(mixers[rng() % 5], moves);
+            for (int move : moves) state.applyMove(move);
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::uint64_t checksum = 0;
+    LastLayerMatch match;
+    for (std::uint64_t n = 0; n < count; n++) {
+        if (database.recognize(states[n % states.size()], match)) checksum += match.caseId;
+    }
+    double seconds = secondsSince(start);
+    std::cout << count << " recognitions in " << seconds << " s (" << seconds * 1e9 / count
+              << " ns each, checksum " << checksum << ")" << std::endl;
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        printUsage();
+        return 1;
+    }
+    std::string command = argv[1];
+    if (command == "build") return build(argv[2]);
+
+    LastLayerDatabase database;
+    if (!database.open(argv[2])) {
+        std::cerr << "Cannot read " << argv[2] << std::endl;
+        return 1;
+    }
+    if (command == "info") return info(database);
+    if (command == "recognize" && argc > 3) return recognize(database, argv[3]);
+    if (command == "check") return check(database);
+    if (command == "bench") return bench(database, argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 10000000);
+    printUsage();
+    return 1;
+}
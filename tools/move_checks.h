@@ -0,0 +1,363 @@
+// Move Checks Header
+// Properties shared by rubik_verify and the libFuzzer entry: every move engine must match
+// RubikCube's hand-coded rotations, and the renderers' sticker mapping and the mouse picking
+// must follow the turns
+//
+// Each check returns false and describes the first violation in `failure`.
+
+#ifndef MOVE_CHECKS_H
+#define MOVE_CHECKS_H
+
+#include "batch_cube.h"
+#include "cube_picker.h"
+#include "cubie_cube.h"
+#include "move_sequence.h"
+#include "move_tables.h"
+#include "rubik_cube.h"
+#include <string>
+#include <vector>
+
+// The hand-coded rotations, indexed by face
+typedef void (RubikCube::*Rotation)();
+const Rotation CLOCKWISE_ROTATIONS[6] = {
+    &RubikCube::rotateR, &RubikCube::rotateL, &RubikCube::rotateU,
+    &RubikCube::rotateD, &RubikCube::rotateF, &RubikCube::rotateB
+};
+const Rotation COUNTER_CLOCKWISE_ROTATIONS[6] = {
+    &RubikCube::rotateRPrime, &RubikCube::rotateLPrime, &RubikCube::rotateUPrime,
+    &RubikCube::rotateDPrime, &RubikCube::rotateFPrime, &RubikCube::rotateBPrime
+};
+
+inline bool sameStickers(const RubikCube& a, const RubikCube& b) {
+    return a.getFaces() == b.getFaces();
+}
+
+inline bool fail(std::string& failure, const std::string& what, const std::vector<int>& moves) {
+    failure = what + " after \"" + sequenceToString(moves) + "\"";
+    return false;
+}
+
+// Differential check of one sequence: sticker model, cubie model, ranked encoding,
+// canonicalized sequence and the inverse sequence must all agree
+inline bool checkSequence(const std::vector<int>& moves, std::string& failure) {
+    RubikCube reference;
+    CubieCube cubie;
+    for (int move : moves) {
+        reference.applyMoveIndex(move);
+        cubie.applyMove(move);
+    }
+
+    RubikCube converted;
+    cubie.toFacelets(converted);
+    if (!sameStickers(reference, converted)) return fail(failure, "CubieCube differs from RubikCube", moves);
+    CubieCube parsed;
+    if (!CubieCube::fromFacelets(reference, parsed) || parsed != cubie) {
+        return fail(failure, "fromFacelets differs from CubieCube", moves);
+    }
+    if (!cubie.isValid()) return fail(failure, "CubieCube is not a valid state", moves);
+    if (reference.isSolved() != cubie.isSolved()) return fail(failure, "isSolved disagrees", moves);
+
+    std::uint8_t packed[RANKED_STATE_BYTES];
+    CubieCube unpacked;
+    cubie.encodeRanked(packed);
+    if (!CubieCube::decodeRanked(packed, unpacked) || unpacked != cubie) {
+        return fail(failure, "ranked encoding does not round-trip", moves);
+    }
+
+    std::vector<int> canonical = canonicalizeSequence(moves);
+    CubieCube simplified;
+    for (int move : canonical) simplified.applyMove(move);
+    if (simplified != cubie || canonical.size() > moves.size()) {
+        return fail(failure, "canonical sequence \"" + sequenceToString(canonical) + "\" differs", moves);
+    }
+
+    // The sticker model already agreed with the cubie model, so only the cheap one replays the inverse
+    for (auto it = moves.rbegin(); it != moves.rend(); ++it) cubie.applyMove(inverseMove(*it));
+    if (!cubie.isSolved()) return fail(failure, "inverse sequence does not solve", moves);
+    return true;
+}
+
+// Bit-sliced engine: every lane starts from its own state and must end where CubieCube does
+inline bool checkBatch(BatchCube& batch, const std::vector<CubieCube>& starts, const std::vector<int>& moves,
+                       std::string& failure) {
+    for (std::size_t lane = 0; lane < batch.size(); lane++) batch.load(lane, starts[lane]);
+    batch.applySequence(moves.data(), moves.size());
+    for (std::size_t lane = 0; lane < batch.size(); lane++) {
+        CubieCube expected = starts[lane];
+        for (int move : moves) expected.applyMove(move);
+        CubieCube actual;
+        batch.store(lane, actual);
+        if (actual != expected) return fail(failure, "BatchCube lane " + std::to_string(lane) + " differs", moves);
+    }
+    RubikCube expectedStickers, actualStickers;
+    CubieCube first = starts[0];
+    for (int move : moves) first.applyMove(move);
+    first.toFacelets(expectedStickers);
+    batch.store(0, actualStickers);
+    if (!sameStickers(expectedStickers, actualStickers)) return fail(failure, "BatchCube stickers differ", moves);
+    return true;
+}
+
+// Order of a sequence in the group (smallest k > 0 with sequence^k = identity), 0 past limit
+template <typename Cube, typename Apply>
+int sequenceOrder(const std::vector<int>& moves, int limit, Apply apply) {
+    Cube cube;
+    for (int k = 1; k <= limit; k++) {
+        for (int move : moves) apply(cube, move);
+        if (cube.isSolved()) return k;
+    }
+    return 0;
+}
+
+// Group relations: quarter turns have order 4, X X' = X' X = identity, X2 = X X, opposite
+// faces commute, and a few sequences of known order
+inline bool checkGroupRelations(std::string& failure) {
+    for (int face = 0; face < 6; face++) {
+        std::vector<int> quarter(1, face * 3);
+        RubikCube cube, twice;
+        for (int i = 0; i < 4; i++) {
+            (cube.*CLOCKWISE_ROTATIONS[face])();
+            if (cube.isSolved() != (i == 3)) return fail(failure, "quarter turn does not have order 4", quarter);
+        }
+        (cube.*CLOCKWISE_ROTATIONS[face])();
+        (cube.*COUNTER_CLOCKWISE_ROTATIONS[face])();
+        if (!cube.isSolved()) return fail(failure, "X X' is not the identity", quarter);
+        (cube.*COUNTER_CLOCKWISE_ROTATIONS[face])();
+        (cube.*CLOCKWISE_ROTATIONS[face])();
+        if (!cube.isSolved()) return fail(failure, "X' X is not the identity", quarter);
+
+        cube.applyMoveIndex(face * 3 + 1);
+        (twice.*CLOCKWISE_ROTATIONS[face])();
+        (twice.*CLOCKWISE_ROTATIONS[face])();
+        if (!sameStickers(cube, twice)) return fail(failure, "X2 differs from X X", std::vector<int>(1, face * 3 + 1));
+
+        for (int turns = 0; turns < 3; turns++) {
+            int move = face * 3 + turns;
+            int opposite = (face ^ 1) * 3 + (2 - turns);
+            RubikCube ab, ba;
+            ab.applyMoveIndex(move);
+            ab.applyMoveIndex(opposite);
+            ba.applyMoveIndex(opposite);
+            ba.applyMoveIndex(move);
+            if (!sameStickers(ab, ba)) return fail(failure, "opposite faces do not commute", {move, opposite});
+        }
+    }
+
+    struct KnownOrder {
+        const char* moves;
+        int order;
+    };
+    const KnownOrder orders[] = {
+        {"R U", 105}, {"R U R' U'", 6}, {"R2 U2", 6}, {"R L", 4}, {"R U2 D' B D'", 1260}, {"R2 L2 U2 D2 F2 B2", 2},
+    };
+    for (const KnownOrder& known : orders) {
+        std::vector<int> moves;
+        parseSequence(known.moves, moves);
+        int limit = known.order + 1;
+        int stickerOrder = sequenceOrder<RubikCube>(moves, limit, [](RubikCube& c, int m) { c.applyMoveIndex(m); });
+        int cubieOrder = sequenceOrder<CubieCube>(moves, limit, [](CubieCube& c, int m) { c.applyMove(m); });
+        if (stickerOrder != known.order || cubieOrder != known.order) {
+            return fail(failure, "order is not " + std::to_string(known.order), moves);
+        }
+    }
+    return true;
+}
+
+// Integer quarter rotation (right-handed, +90 degrees) of a grid vector about an axis
+inline void rotateQuarter(int* v, int axis) {
+    int x = v[0], y = v[1], z = v[2];
+    if (axis == 0) { v[1] = -z; v[2] = y; }
+    else if (axis == 1) { v[0] = z; v[2] = -x; }
+    else { v[0] = -y; v[1] = x; }
+}
+
+// Renderer consistency: animating a turn (slice rotated by sliceTurnSign * 90 degrees) must
+// carry every sticker exactly where the model's move puts it, so the final frame of the
+// animation and the next frame drawn from the new state look identical
+inline bool checkStickerMap(std::string& failure) {
+    for (int face = 0; face < 6; face++) {
+        for (int clockwise = 0; clockwise < 2; clockwise++) {
+            int move = face * 3 + (clockwise ? 0 : 2);
+            RubikCube before;
+            for (int f = 0; f < 6; f++) {
+                for (int row = 0; row < 3; row++) {
+                    for (int col = 0; col < 3; col++) before.setColor(f, row, col, f * 9 + row * 3 + col);
+                }
+            }
+            RubikCube after = before;
+            after.applyMoveIndex(move);
+
+            int axis = face / 2;
+            int layer = face % 2 == 0 ? 1 : -1;
+            int quarters = (sliceTurnSign(face) * (clockwise ? 1 : -1) + 4) % 4;
+            for (int x = -1; x <= 1; x++) {
+                for (int y = -1; y <= 1; y++) {
+                    for (int z = -1; z <= 1; z++) {
+                        for (int shown = 0; shown < 6; shown++) {
+                            int position[3] = {x, y, z};
+                            int normal[3] = {0, 0, 0};
+                            normal[shown / 2] = shown % 2 == 0 ? 1 : -1;
+                            if (position[shown / 2] != normal[shown / 2]) continue;  // Inner face
+
+                            StickerRef from = cubieSticker(x, y, z, shown);
+                            if (position[axis] == layer) {
+                                for (int q = 0; q < quarters; q++) {
+                                    rotateQuarter(position, axis);
+                                    rotateQuarter(normal, axis);
+                                }
+                            }
+                            int target = 0;
+                            while (normal[target / 2] != (target % 2 == 0 ? 1 : -1)) target++;
+                            StickerRef to = cubieSticker(position[0], position[1], position[2], target);
+                            if (after.getColor(to.face, to.row, to.col) != before.getColor(from.face, from.row, from.col)) {
+                                return fail(failure, "animated sticker lands on the wrong facelet", std::vector<int>(1, move));
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// Compile-time tables against the hand-coded rotations: facelet permutations move labelled
+// stickers like RubikCube, move cubes match fromFacelets, orientation tables match the setters
+inline bool checkMoveTables(std::string& failure) {
+    RubikCube labelled;
+    for (int f = 0; f < 6; f++) {
+        for (int cell = 0; cell < 9; cell++) labelled.setColor(f, cell / 3, cell % 3, f * 9 + cell);
+    }
+    for (int move = 0; move < NUM_MOVES; move++) {
+        std::vector<int> moves(1, move);
+        RubikCube turned = labelled;
+        turned.applyMoveIndex(move);
+        for (int i = 0; i < NUM_FACELETS; i++) {
+            if (turned.getColor(i / 9, i % 9 / 3, i % 3) != MOVE_TABLES.moveFacelets[move].from[i]) {
+                return fail(failure, "compile-time facelet permutation differs from RubikCube", moves);
+            }
+        }
+        RubikCube solved;
+        solved.applyMoveIndex(move);
+        CubieCube parsed;
+        if (!CubieCube::fromFacelets(solved, parsed) || parsed != MOVE_TABLES.moveCubes[move]) {
+            return fail(failure, "compile-time move cube differs from fromFacelets", moves);
+        }
+        CubieCube cube;
+        for (int twist = 0; twist < CORNER_ORIENTATIONS; twist++) {
+            cube.setCornerOrientation(twist);
+            cube.applyMove(move);
+            if (cube.cornerOrientation() != MOVE_TABLES.twistMove[twist * NUM_MOVES + move]) {
+                return fail(failure, "twist table entry " + std::to_string(twist) + " differs", moves);
+            }
+        }
+        for (int flip = 0; flip < EDGE_ORIENTATIONS; flip++) {
+            cube.setEdgeOrientation(flip);
+            cube.applyMove(move);
+            if (cube.edgeOrientation() != MOVE_TABLES.flipMove[flip * NUM_MOVES + move]) {
+                return fail(failure, "flip table entry " + std::to_string(flip) + " differs", moves);
+            }
+        }
+    }
+    return true;
+}
+
+// World-space center of the sticker a cubie shows on side `shown`
+inline void stickerCenter(const int* position, int shown, float* center) {
+    for (int i = 0; i < 3; i++) center[i] = static_cast<float>(position[i]);
+    center[shown / 2] += shown % 2 == 0 ? 0.5f : -0.5f;
+}
+
+// Grid position and side showing a facelet
+inline bool findSticker(int face, int row, int col, int* position, int& shown) {
+    for (int i = 0; i < 27 * 6; i++) {
+        int p[3] = {i / 54 - 1, i / 18 % 3 - 1, i / 6 % 3 - 1};
+        int s = i % 6;
+        int outward = s % 2 == 0 ? 1 : -1;
+        if (p[s / 2] != outward) continue;
+        StickerRef ref = cubieSticker(p[0], p[1], p[2], s);
+        if (ref.face == face && ref.row == row && ref.col == col) {
+            for (int k = 0; k < 3; k++) position[k] = p[k];
+            shown = s;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Mouse picking: a ray straight at each sticker picks it, and dragging across it in any
+// in-plane direction turns a layer that carries it along the drag (middle slices excepted)
+inline bool checkPicking(std::string& failure) {
+    const std::vector<int> none;
+    for (int i = 0; i < 27 * 6; i++) {
+        int position[3] = {i / 54 - 1, i / 18 % 3 - 1, i / 6 % 3 - 1};
+        int shown = i % 6;
+        int normalAxis = shown / 2;
+        float outward = shown % 2 == 0 ? 1.0f : -1.0f;
+        if (position[normalAxis] != static_cast<int>(outward)) continue;
+
+        float center[3];
+        stickerCenter(position, shown, center);
+        PickRay ray;
+        for (int k = 0; k < 3; k++) {
+            ray.origin[k] = center[k];
+            ray.direction[k] = 0.0f;
+        }
+        ray.origin[normalAxis] += outward * 5.0f;
+        ray.direction[normalAxis] = -outward;
+
+        StickerHit hit;
+        StickerRef expected = cubieSticker(position[0], position[1], position[2], shown);
+        if (!pickSticker(ray, hit) || hit.face != shown || hit.sticker.face != expected.face ||
+            hit.sticker.row != expected.row || hit.sticker.col != expected.col) {
+            return fail(failure, "ray at a sticker center picks another sticker", none);
+        }
+
+        for (int dragAxis = 0; dragAxis < 3; dragAxis++) {
+            if (dragAxis == normalAxis) continue;
+            for (int sign = -1; sign <= 1; sign += 2) {
+                PickRay moved = ray;
+                moved.origin[dragAxis] += sign * 0.5f;
+                int face = 0;
+                bool clockwise = false;
+                bool turned = dragTurn(hit, moved, face, clockwise);
+                int rotationAxis = 3 - normalAxis - dragAxis;
+                if (!turned) {
+                    if (position[rotationAxis] != 0) return fail(failure, "drag across a face layer does not turn", none);
+                    continue;
+                }
+
+                RubikCube before;
+                for (int f = 0; f < 6; f++) {
+                    for (int row = 0; row < 3; row++) {
+                        for (int col = 0; col < 3; col++) before.setColor(f, row, col, f * 9 + row * 3 + col);
+                    }
+                }
+                RubikCube after = before;
+                std::vector<int> move(1, face * 3 + (clockwise ? 0 : 2));
+                after.applyMoveIndex(move[0]);
+
+                int label = before.getColor(expected.face, expected.row, expected.col);
+                int landed[3] = {0, 0, 0};
+                int landedShown = -1;
+                for (int f = 0; f < 6 && landedShown < 0; f++) {
+                    for (int cell = 0; cell < 9; cell++) {
+                        if (after.getColor(f, cell / 3, cell % 3) == label) {
+                            findSticker(f, cell / 3, cell % 3, landed, landedShown);
+                            break;
+                        }
+                    }
+                }
+                float target[3];
+                if (landedShown < 0) return fail(failure, "picked sticker lost", move);
+                stickerCenter(landed, landedShown, target);
+                if ((target[dragAxis] - center[dragAxis]) * sign <= 0.0f) {
+                    return fail(failure, "drag turns the sticker against the drag direction", move);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+#endif // MOVE_CHECKS_H
@@ -0,0 +1,223 @@
+// NUMA Bench
+// Random pattern database lookups under each table placement and page size
+//
+//   rubik_numa_bench TABLE [--threads T] [--lookups N] [--placements LIST] [--pages LIST]
+//
+// LIST is comma-separated: placements from mapped, first-touch, interleave, replicate (default
+// all), page modes from off, thp, explicit (default all). Thread t is pinned to node
+// t % nodes, so with T >= nodes every node reads the table at once. Each configuration runs
+// two loops per thread, N lookups each:
+//   random   independent indexes; the core overlaps the misses, so this is throughput
+//   chained  the next index depends on the last distance, so every miss is paid in full
+// The distance sums must agree across configurations; a mismatch exits with status 1.
+//
+// Without libnuma (or on one node) the placements differ only in page size, which is still
+// the main cost of random lookups into a table much larger than the TLB reach.
+
+#include "pattern_database.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const char* const MAPPED = "mapped";
+
+struct BenchOptions {
+    std::string path;
+    int threads = 0;
+    std::uint64_t lookups = 4000000;
+    std::vector<std::string> placements = {MAPPED, "first-touch", "interleave", "replicate"};
+    std::vector<std::string> pages = {"off", "thp", "explicit"};
+};
+
+std::vector<std::string> splitList(const std::string& text) {
+    std::vector<std::string> items;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+bool parseOptions(int argc, char* argv[], BenchOptions& options) {
+    if (argc < 2) return false;
+    options.path = argv[1];
+    for (int i = 2; i < argc; i++) {
+        if (i + 1 >= argc) return false;
+        if (std::strcmp(argv[i], "--threads") == 0) {
+            options.threads = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--lookups") == 0) {
+            options.lookups = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--placements") == 0) {
+            options.placements = splitList(argv[++i]);
+        } else if (std::strcmp(argv[i], "--pages") == 0) {
+            options.pages = splitList(argv[++i]);
+        } else {
+            return false;
+        }
+    }
+    for (const std::string& name : options.placements) {
+        NumaPlacement placement;
+        if (name != MAPPED && !parseNumaPlacement(name, placement)) return false;
+    }
+    for (const std::string& name : options.pages) {
+        HugePageMode mode;
+        if (!parseHugePageMode(name, mode)) return false;
+    }
+    return options.threads >= 0 && options.lookups > 0 && !options.placements.empty() && !options.pages.empty();
+}
+
+std::uint64_t nextRandom(std::uint64_t& state) {
+    std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// Uniform index below entries (every kind has fewer than 2^32 entries)
+std::uint64_t scaleIndex(std::uint64_t random, std::uint64_t entries) {
+    return ((random >> 32) * entries) >> 32;
+}
+
+struct ThreadResult {
+    std::uint64_t randomSum;
+    std::uint64_t chainedSum;
+};
+
+struct RunResult {
+    double randomSeconds;
+    double chainedSeconds;
+    std::uint64_t randomSum;
+    std::uint64_t chainedSum;
+};
+
+// Runs body(thread, result) on every thread, each pinned to its node, and returns the wall time
+template <typename Body>
+double timeThreads(int threads, int nodes, std::vector<ThreadResult>& results, const Body& body) {
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] {
+            numaRunOnNode(t % nodes);
+            body(t, results[t]);
+        });
+    }
+    for (std::thread& worker : workers) worker.join();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+RunResult runLookups(const PatternDatabase& database, int threads, std::uint64_t lookups) {
+    std::uint64_t entries = database.size();
+    int nodes = std::max(1, numaNodeCount());
+    std::vector<ThreadResult> results(threads);
+    RunResult run = {};
+
+    run.randomSeconds = timeThreads(threads, nodes, results, [&](int thread, ThreadResult& result) {
+        std::uint64_t state = 0x5EED0000u + thread;
+        std::uint64_t sum = 0;
+        for (std::uint64_t i = 0; i < lookups; i++) sum += database.distance(scaleIndex(nextRandom(state), entries));
+        result.randomSum = sum;
+    });
+    run.chainedSeconds = timeThreads(threads, nodes, results, [&](int thread, ThreadResult& result) {
+        std::uint64_t state = 0xC4A10000u + thread;
+        std::uint64_t sum = 0;
+        int last = 0;
+        for (std::uint64_t i = 0; i < lookups; i++) {
+            state += static_cast<std::uint64_t>(last);
+            last = database.distance(scaleIndex(nextRandom(state), entries));
+            sum += static_cast<std::uint64_t>(last);
+        }
+        result.chainedSum = sum;
+    });
+    for (const ThreadResult& result : results) {
+        run.randomSum += result.randomSum;
+        run.chainedSum += result.chainedSum;
+    }
+    return run;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Usage: rubik_numa_bench TABLE [--threads T] [--lookups N] [--placements LIST] [--pages LIST]\n"
+                     "  placements: mapped,first-touch,interleave,replicate  pages: off,thp,explicit" << std::endl;
+        return 1;
+    }
+    if (options.threads == 0) options.threads = std::max(1u, std::thread::hardware_concurrency());
+
+    PatternDatabase probe;
+    if (!probe.open(options.path)) {
+        std::cerr << "Cannot open pattern database " << options.path << std::endl;
+        return 1;
+    }
+    double tableMb = (probe.size() + 1) / 2 / 1048576.0;
+    std::cout << patternName(probe.getKind()) << ": " << std::fixed << std::setprecision(1) << tableMb << " MB, "
+              << options.threads << " threads, " << options.lookups << " lookups per thread per loop" << std::endl;
+    std::cout << "NUMA: " << (numaAvailable() ? "libnuma" : "not available") << ", " << numaNodeCount() << " node(s)" << std::endl;
+    probe.close();
+
+    std::cout << std::left << std::setw(12) << "placement" << std::setw(10) << "pages" << std::right << std::setw(10)
+              << "load ms" << std::setw(10) << "huge MB" << std::setw(14) << "random M/s" << std::setw(14)
+              << "chained ns" << std::endl;
+
+    bool fellBack = false;
+    bool haveReference = false;
+    RunResult reference = {};
+    for (const std::string& placementName : options.placements) {
+        bool mapped = placementName == MAPPED;
+        // The mapping has no page mode of its own; run it once
+        std::vector<std::string> pageModes = mapped ? std::vector<std::string>{"file"} : options.pages;
+        for (const std::string& pageName : pageModes) {
+            PatternDatabase database;
+            PatternLoadOptions load;
+            auto loadStart = std::chrono::steady_clock::now();
+            bool ok;
+            if (mapped) {
+                // Checksumming reads every page, so the lookups do not time page-cache faults
+                ok = database.open(options.path, true);
+            } else {
+                parseNumaPlacement(placementName, load.placement);
+                parseHugePageMode(pageName, load.hugePages);
+                ok = database.load(options.path, load);
+            }
+            double loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStart).count();
+            if (!ok) {
+                std::cerr << "Loading " << options.path << " as " << placementName << " / " << pageName << " failed" << std::endl;
+                return 1;
+            }
+
+            RunResult run = runLookups(database, options.threads, options.lookups);
+            double total = static_cast<double>(options.lookups) * options.threads;
+            std::string obtained = mapped ? pageName : hugePageModeName(database.pageMode());
+            if (!mapped && obtained != pageName) {
+                obtained += "*";
+                fellBack = true;
+            }
+            std::cout << std::left << std::setw(12) << placementName << std::setw(10) << obtained << std::right
+                      << std::setprecision(1) << std::setw(10) << loadMs << std::setw(10)
+                      << database.hugePageBytes() / 1048576.0 << std::setprecision(2) << std::setw(14)
+                      << total / run.randomSeconds / 1e6 << std::setprecision(1) << std::setw(14)
+                      << run.chainedSeconds * 1e9 / options.lookups << std::endl;
+
+            if (!haveReference) {
+                reference = run;
+                haveReference = true;
+            } else if (run.randomSum != reference.randomSum || run.chainedSum != reference.chainedSum) {
+                std::cerr << "Distance sums differ from the first configuration" << std::endl;
+                return 1;
+            }
+        }
+    }
+    if (fellBack) std::cout << "* explicit huge pages unavailable (vm.nr_hugepages), fell back as shown" << std::endl;
+    return 0;
+}
@@ -0,0 +1,453 @@
+// Pattern Database Builder
+// Parallel, resumable breadth-first search that writes a mapped pattern database
+//
+//   rubik_pdb_build <corners|edges7|phase1> OUTPUT [--threads T] [--chunk N]
+//                   [--checkpoint FILE] [--interval SECONDS]
+//
+// The table itself is the BFS queue: 4 bits per entry in shared 32-bit words, 15 = unvisited.
+// Each depth is one pass over the table in chunks of N entries, handed to the threads through
+// an atomic counter. While the frontier is small a pass expands every entry at the current
+// depth and claims unvisited neighbours with a compare-and-swap on their word; once the
+// frontier outnumbers the unvisited entries it switches to the backward direction (an
+// unvisited entry with a neighbour at the current depth is one deeper), which only writes its
+// own nibble. Memory is the table (see pattern_database.h) plus one chunk buffer during I/O.
+//
+// Every --interval seconds (default 120, 0 = never) the threads stop at a chunk boundary and
+// the table is written to the checkpoint file (default OUTPUT.checkpoint) with the depth and
+// next chunk; starting again with the same arguments resumes from it. Chunks are idempotent
+// within a pass, so a kill at any point loses at most the chunks since the last checkpoint.
+
+#include "pattern_database.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const char CHECKPOINT_MAGIC[8] = {'R', 'B', 'K', 'P', 'D', 'B', 'C', 'K'};
+const std::uint32_t CHECKPOINT_VERSION = 1;
+const std::size_t CHECKPOINT_HEADER_SIZE = 168;
+const std::uint32_t UNVISITED = 0xF;
+
+struct BuildOptions {
+    PatternKind kind = PATTERN_CORNERS;
+    std::string output;
+    std::string checkpoint;
+    unsigned int threads = 0;            // 0 = hardware concurrency
+    std::uint32_t chunkEntries = 1u << 22;
+    double interval = 120.0;
+};
+
+bool parseOptions(int argc, char* argv[], BuildOptions& options) {
+    if (argc < 3 || !parsePatternKind(argv[1], options.kind)) return false;
+    options.output = argv[2];
+    options.checkpoint = options.output + ".checkpoint";
+    for (int i = 3; i < argc; i++) {
+        if (i + 1 >= argc) return false;
+        if (std::strcmp(argv[i], "--threads") == 0) {
+            options.threads = static_cast<unsigned int>(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--chunk") == 0) {
+            options.chunkEntries = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--checkpoint") == 0) {
+            options.checkpoint = argv[++i];
+        } else if (std::strcmp(argv[i], "--interval") == 0) {
+            options.interval = std::atof(argv[++i]);
+        } else {
+            return false;
+        }
+    }
+    // Chunks cover whole words so two threads never share one outside a compare-and-swap
+    return options.chunkEntries >= 8 && options.chunkEntries % 8 == 0 && options.interval >= 0.0;
+}
+
+void putU32(std::uint8_t* out, std::uint32_t value) {
+    for (int i = 0; i < 4; i++) out[i] = static_cast<std::uint8_t>(value >> (8 * i));
+}
+
+void putU64(std::uint8_t* out, std::uint64_t value) {
+    for (int i = 0; i < 8; i++) out[i] = static_cast<std::uint8_t>(value >> (8 * i));
+}
+
+std::uint32_t getU32(const std::uint8_t* in) {
+    std::uint32_t value = 0;
+    for (int i = 0; i < 4; i++) value |= static_cast<std::uint32_t>(in[i]) << (8 * i);
+    return value;
+}
+
+std::uint64_t getU64(const std::uint8_t* in) {
+    std::uint64_t value = 0;
+    for (int i = 0; i < 8; i++) value |= static_cast<std::uint64_t>(in[i]) << (8 * i);
+    return value;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Nibble table shared by all threads; entry i lives in bits 4 * (i % 8) of word i / 8
+class NibbleTable {
+private:
+    std::unique_ptr<std::atomic<std::uint32_t>[]> words;
+    std::uint64_t wordCount;
+
+public:
+    explicit NibbleTable(std::uint64_t entries)
+        : words(new std::atomic<std::uint32_t>[(entries + 7) / 8]), wordCount((entries + 7) / 8) {}
+
+    std::uint64_t size() const { return wordCount; }
+
+    std::uint32_t word(std::uint64_t w) const { return words[w].load(std::memory_order_relaxed); }
+    void setWord(std::uint64_t w, std::uint32_t value) { words[w].store(value, std::memory_order_relaxed); }
+
+    std::uint32_t get(std::uint64_t i) const { return (word(i >> 3) >> ((i & 7) * 4)) & 0xF; }
+
+    // Set an unvisited entry; false if another thread (or an earlier depth) got there first
+    bool claim(std::uint64_t i, std::uint32_t value) {
+        std::atomic<std::uint32_t>& slot = words[i >> 3];
+        int shift = static_cast<int>(i & 7) * 4;
+        std::uint32_t current = slot.load(std::memory_order_relaxed);
+        while (((current >> shift) & 0xF) == UNVISITED) {
+            std::uint32_t desired = (current & ~(0xFu << shift)) | (value << shift);
+            if (slot.compare_exchange_weak(current, desired, std::memory_order_relaxed)) return true;
+        }
+        return false;
+    }
+
+    // Little-endian bytes of words [first, first + bytes / 4), as in the file format
+    void copyOut(std::uint64_t first, std::uint8_t* out, std::size_t bytes) const {
+        for (std::size_t b = 0; b < bytes; b++) {
+            out[b] = static_cast<std::uint8_t>(word(first + b / 4) >> (8 * (b % 4)));
+        }
+    }
+
+    void copyIn(std::uint64_t first, const std::uint8_t* in, std::size_t bytes) {
+        for (std::size_t b = 0; b < bytes; b += 4) {
+            std::uint32_t value = 0xFFFFFFFFu;
+            for (std::size_t k = 0; k < 4 && b + k < bytes; k++) {
+                value = (value & ~(0xFFu << (8 * k))) | (static_cast<std::uint32_t>(in[b + k]) << (8 * k));
+            }
+            setWord(first + b / 4, value);
+        }
+    }
+};
+
+// Runs fn(chunk) for chunks [first, count) on all threads until done or until the deadline,
+// printing progress once a second; returns the first chunk not processed
+template <typename Fn>
+std::uint32_t runChunks(unsigned int threadCount, std::uint32_t first, std::uint32_t count, const char* label,
+                        std::chrono::steady_clock::time_point deadline, bool useDeadline, Fn fn) {
+    std::atomic<std::uint32_t> next(first);
+    std::atomic<std::uint32_t> done(0);
+    std::atomic<bool> stop(false);
+    std::atomic<unsigned int> running(threadCount);
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < threadCount; t++) {
+        threads.emplace_back([&]() {
+            while (!stop.load(std::memory_order_relaxed)) {
+                std::uint32_t chunk = next.fetch_add(1);
+                if (chunk >= count) break;
+                fn(chunk);
+                done++;
+            }
+            running--;
+        });
+    }
+
+    auto lastReport = std::chrono::steady_clock::now();
+    bool reported = false;
+    while (running.load() > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        auto now = std::chrono::steady_clock::now();
+        if (useDeadline && now >= deadline) stop = true;
+        if (std::chrono::duration<double>(now - lastReport).count() >= 1.0 && count > first) {
+            lastReport = now;
+            reported = true;
+            std::cout << "\r  " << label << " " << std::fixed << std::setprecision(1)
+                      << 100.0 * (first + done.load()) / count << "%   " << std::flush;
+        }
+    }
+    for (std::thread& thread : threads) thread.join();
+    // Blank the progress line so a checkpoint or depth message does not run into it
+    if (reported) std::cout << "\r" << std::string(std::strlen(label) + 12, ' ') << "\r" << std::flush;
+    return std::min(next.load(), count);
+}
+
+struct BuildState {
+    int depth;                    // Entries at this depth are being expanded
+    std::uint32_t nextChunk;      // First chunk of the current pass not yet processed
+    std::uint64_t counts[16];     // Entries per depth, known up to `depth`
+};
+
+// Checkpoint: header, table bytes, then FNV-1a over the header and every chunk's checksum
+bool writeCheckpoint(const BuildOptions& options, const NibbleTable& table, std::uint64_t entries,
+                     std::uint32_t chunkEntries, std::uint32_t chunkCount, const BuildState& state) {
+    std::uint8_t header[CHECKPOINT_HEADER_SIZE] = {};
+    std::memcpy(header, CHECKPOINT_MAGIC, 8);
+    putU32(header + 8, CHECKPOINT_VERSION);
+    putU32(header + 12, static_cast<std::uint32_t>(options.kind));
+    putU64(header + 16, entries);
+    putU32(header + 24, chunkEntries);
+    putU32(header + 28, static_cast<std::uint32_t>(state.depth));
+    putU32(header + 32, state.nextChunk);
+    for (int d = 0; d < 16; d++) putU64(header + 40 + 8 * d, state.counts[d]);
+
+    std::string temporary = options.checkpoint + ".tmp";
+    std::FILE* file = std::fopen(temporary.c_str(), "wb");
+    if (!file) return false;
+    std::vector<std::uint8_t> digest(header, header + CHECKPOINT_HEADER_SIZE);
+    std::vector<std::uint8_t> buffer(chunkEntries / 2);
+    bool ok = std::fwrite(header, 1, sizeof(header), file) == sizeof(header);
+    for (std::uint32_t chunk = 0; ok && chunk < chunkCount; chunk++) {
+        std::uint64_t firstWord = static_cast<std::uint64_t>(chunk) * (chunkEntries / 8);
+        std::size_t bytes = static_cast<std::size_t>(std::min<std::uint64_t>(chunkEntries / 2, (table.size() - firstWord) * 4));
+        table.copyOut(firstWord, buffer.data(), bytes);
+        std::uint8_t sum[4];
+        putU32(sum, patternChecksum(buffer.data(), bytes));
+        digest.insert(digest.end(), sum, sum + 4);
+        ok = std::fwrite(buffer.data(), 1, bytes, file) == bytes;
+    }
+    std::uint8_t trailer[4];
+    putU32(trailer, patternChecksum(digest.data(), digest.size()));
+    ok = ok && std::fwrite(trailer, 1, 4, file) == 4;
+    ok = (std::fclose(file) == 0) && ok;
+    if (!ok) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+#ifdef _WIN32
+    std::remove(options.checkpoint.c_str());
+#endif
+    return std::rename(temporary.c_str(), options.checkpoint.c_str()) == 0;
+}
+
+// 1 = resumed, 0 = no checkpoint, -1 = checkpoint unusable (wrong kind or corrupt)
+int readCheckpoint(const BuildOptions& options, NibbleTable& table, std::uint64_t entries,
+                   std::uint32_t& chunkEntries, BuildState& state) {
+    std::FILE* file = std::fopen(options.checkpoint.c_str(), "rb");
+    if (!file) return 0;
+    std::uint8_t header[CHECKPOINT_HEADER_SIZE];
+    bool ok = std::fread(header, 1, sizeof(header), file) == sizeof(header) &&
+              std::memcmp(header, CHECKPOINT_MAGIC, 8) == 0 && getU32(header + 8) == CHECKPOINT_VERSION &&
+              getU32(header + 12) == static_cast<std::uint32_t>(options.kind) && getU64(header + 16) == entries;
+    std::uint32_t savedChunk = ok ? getU32(header + 24) : 0;
+    ok = ok && savedChunk >= 8 && savedChunk % 8 == 0;
+    std::uint32_t chunkCount = ok ? static_cast<std::uint32_t>((entries + savedChunk - 1) / savedChunk) : 0;
+
+    std::vector<std::uint8_t> digest(header, header + CHECKPOINT_HEADER_SIZE);
+    std::vector<std::uint8_t> buffer(ok ? savedChunk / 2 : 0);
+    for (std::uint32_t chunk = 0; ok && chunk < chunkCount; chunk++) {
+        std::uint64_t firstWord = static_cast<std::uint64_t>(chunk) * (savedChunk / 8);
+        std::size_t bytes = static_cast<std::size_t>(std::min<std::uint64_t>(savedChunk / 2, (table.size() - firstWord) * 4));
+        ok = std::fread(buffer.data(), 1, bytes, file) == bytes;
+        if (!ok) break;
+        table.copyIn(firstWord, buffer.data(), bytes);
+        std::uint8_t sum[4];
+        putU32(sum, patternChecksum(buffer.data(), bytes));
+        digest.insert(digest.end(), sum, sum + 4);
+    }
+    std::uint8_t trailer[4];
+    ok = ok && std::fread(trailer, 1, 4, file) == 4 && getU32(trailer) == patternChecksum(digest.data(), digest.size());
+    std::fclose(file);
+    if (!ok) return -1;
+
+    chunkEntries = savedChunk;
+    state.depth = static_cast<int>(getU32(header + 28));
+    state.nextChunk = getU32(header + 32);
+    for (int d = 0; d < 16; d++) state.counts[d] = getU64(header + 40 + 8 * d);
+    return state.depth <= PATTERN_MAX_DEPTH && state.nextChunk <= chunkCount ? 1 : -1;
+}
+
+// Spot check of the written file: solved is 0, and one move changes the distance by at most 1
+bool verifyDatabase(const std::string& path, PatternKind kind, double& seconds) {
+    auto start = std::chrono::steady_clock::now();
+    PatternDatabase database;
+    if (!database.open(path, true) || database.getKind() != kind) return false;
+    if (database.distance(CubieCube()) != 0) return false;
+    CubieCube cube;
+    std::uint32_t seed = 12345;
+    for (int i = 0; i < 100000; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        int before = database.distance(cube);
+        cube.applyMove(static_cast<int>((seed >> 16) % NUM_MOVES));
+        if (std::abs(database.distance(cube) - before) > 1) return false;
+    }
+    seconds = secondsSince(start);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    BuildOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Usage: rubik_pdb_build <corners|edges7|phase1> OUTPUT [--threads T] [--chunk N]\n"
+                     "                       [--checkpoint FILE] [--interval SECONDS]\n"
+                     "  N is a multiple of 8 (default 4194304); --interval 0 disables checkpoints" << std::endl;
+        return 1;
+    }
+    if (options.threads == 0) options.threads = std::max(1u, std::thread::hardware_concurrency());
+
+    auto buildStart = std::chrono::steady_clock::now();
+    std::uint64_t entries = patternSize(options.kind);
+    patternPrepare(options.kind);
+    NibbleTable table(entries);
+    std::cout << patternName(options.kind) << ": " << entries << " entries, " << std::fixed << std::setprecision(1)
+              << table.size() * 4 / 1048576.0 << " MB table, " << options.threads << " threads" << std::endl;
+
+    BuildState state = {};
+    std::uint32_t chunkEntries = options.chunkEntries;
+    int resumed = options.interval > 0.0 ? readCheckpoint(options, table, entries, chunkEntries, state) : 0;
+    if (resumed < 0) {
+        std::cerr << "Checkpoint " << options.checkpoint << " does not match this build or is corrupt; "
+                  << "delete it to start over" << std::endl;
+        return 1;
+    }
+    std::uint32_t chunkCount = static_cast<std::uint32_t>((entries + chunkEntries - 1) / chunkEntries);
+    std::uint64_t wordsPerChunk = chunkEntries / 8;
+    auto wordRange = [&](std::uint32_t chunk, std::uint64_t& first, std::uint64_t& last) {
+        first = chunk * wordsPerChunk;
+        last = std::min(first + wordsPerChunk, table.size());
+    };
+
+    if (resumed > 0) {
+        std::cout << "Resuming from " << options.checkpoint << " at depth " << state.depth << ", chunk "
+                  << state.nextChunk << " of " << chunkCount << std::endl;
+    } else {
+        runChunks(options.threads, 0, chunkCount, "clear", buildStart, false, [&](std::uint32_t chunk) {
+            std::uint64_t first, last;
+            wordRange(chunk, first, last);
+            for (std::uint64_t w = first; w < last; w++) table.setWord(w, 0xFFFFFFFFu);
+        });
+        std::uint64_t solved = patternIndex(options.kind, CubieCube());
+        table.claim(solved, 0);
+        state.depth = 0;
+        state.nextChunk = 0;
+        state.counts[0] = 1;
+    }
+
+    std::uint64_t visited = 0;
+    for (int d = 0; d <= state.depth; d++) visited += state.counts[d];
+    auto lastCheckpoint = std::chrono::steady_clock::now();
+    auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(options.interval));
+    bool checkpoints = options.interval > 0.0;
+
+    while (visited < entries) {
+        if (state.depth >= PATTERN_MAX_DEPTH) {
+            std::cerr << "\nDepth exceeds " << PATTERN_MAX_DEPTH << " with " << entries - visited << " entries left" << std::endl;
+            return 1;
+        }
+        const std::uint32_t current = static_cast<std::uint32_t>(state.depth);
+        const std::uint32_t reached = current + 1;
+        // Same decision on resume: it depends only on the counts stored in the checkpoint
+        const bool backward = state.counts[current] > entries - visited;
+        auto passStart = std::chrono::steady_clock::now();
+        char label[32];
+        std::snprintf(label, sizeof(label), "depth %2d", static_cast<int>(reached));
+
+        auto expand = [&](std::uint32_t chunk) {
+            std::uint64_t first, last, next[NUM_MOVES];
+            wordRange(chunk, first, last);
+            for (std::uint64_t w = first; w < last; w++) {
+                std::uint32_t word = table.word(w);
+                for (int k = 0; k < 8; k++) {
+                    std::uint32_t value = (word >> (4 * k)) & 0xF;
+                    std::uint64_t index = w * 8 + k;
+                    if (index >= entries) break;
+                    if (backward) {
+                        if (value != UNVISITED) continue;
+                        patternSuccessors(options.kind, index, next);
+                        for (int move = 0; move < NUM_MOVES; move++) {
+                            if (table.get(next[move]) == current) {
+                                table.claim(index, reached);
+                                break;
+                            }
+                        }
+                    } else {
+                        if (value != current) continue;
+                        patternSuccessors(options.kind, index, next);
+                        for (int move = 0; move < NUM_MOVES; move++) table.claim(next[move], reached);
+                    }
+                }
+            }
+        };
+
+        // One pass, cut at checkpoint deadlines
+        while (true) {
+            state.nextChunk = runChunks(options.threads, state.nextChunk, chunkCount, label,
+                                        lastCheckpoint + interval, checkpoints, expand);
+            if (state.nextChunk >= chunkCount) break;
+            auto saveStart = std::chrono::steady_clock::now();
+            if (!writeCheckpoint(options, table, entries, chunkEntries, chunkCount, state)) {
+                std::cerr << "\nCannot write checkpoint " << options.checkpoint << std::endl;
+                return 1;
+            }
+            lastCheckpoint = std::chrono::steady_clock::now();
+            std::cout << "\r  checkpoint at chunk " << state.nextChunk << " (" << std::setprecision(1)
+                      << secondsSince(saveStart) << " s)" << std::endl;
+        }
+
+        // Count the new depth (also covers entries claimed by a pass interrupted before a resume)
+        std::vector<std::uint64_t> found(chunkCount, 0);
+        runChunks(options.threads, 0, chunkCount, "count", buildStart, false, [&](std::uint32_t chunk) {
+            std::uint64_t first, last, count = 0;
+            wordRange(chunk, first, last);
+            for (std::uint64_t w = first; w < last; w++) {
+                std::uint32_t word = table.word(w);
+                for (int k = 0; k < 8; k++) count += ((word >> (4 * k)) & 0xF) == reached;
+            }
+            found[chunk] = count;
+        });
+        std::uint64_t added = 0;
+        for (std::uint64_t count : found) added += count;
+        if (added == 0) {
+            std::cerr << "\n" << entries - visited << " entries are unreachable" << std::endl;
+            return 1;
+        }
+
+        double passSeconds = secondsSince(passStart);
+        visited += added;
+        state.counts[reached] = added;
+        state.depth = static_cast<int>(reached);
+        state.nextChunk = 0;
+        std::cout << "\rdepth " << std::setw(2) << reached << "  " << (backward ? "backward" : "forward ") << std::setw(14)
+                  << added << " new  " << std::setprecision(2) << std::setw(6) << 100.0 * visited / entries << "% done  "
+                  << std::setw(7) << passSeconds << " s  " << std::setprecision(1) << std::setw(7)
+                  << entries / passSeconds / 1e6 << " M entries/s" << std::endl;
+
+        if (checkpoints && visited < entries && std::chrono::steady_clock::now() >= lastCheckpoint + interval) {
+            if (!writeCheckpoint(options, table, entries, chunkEntries, chunkCount, state)) {
+                std::cerr << "Cannot write checkpoint " << options.checkpoint << std::endl;
+                return 1;
+            }
+            lastCheckpoint = std::chrono::steady_clock::now();
+        }
+    }
+
+    auto writeStart = std::chrono::steady_clock::now();
+    bool written = writePatternDatabase(options.output, options.kind, chunkEntries, state.counts,
+        [&](std::uint32_t chunk, std::uint8_t* out, std::size_t bytes) { table.copyOut(chunk * wordsPerChunk, out, bytes); });
+    if (!written) {
+        std::cerr << "Cannot write " << options.output << std::endl;
+        return 1;
+    }
+    std::remove(options.checkpoint.c_str());
+    std::cout << "Wrote " << options.output << " in " << std::setprecision(1) << secondsSince(writeStart) << " s, max depth "
+              << state.depth << ", total " << secondsSince(buildStart) << " s" << std::endl;
+
+    double verifySeconds = 0.0;
+    if (!verifyDatabase(options.output, options.kind, verifySeconds)) {
+        std::cerr << "Verification of " << options.output << " failed" << std::endl;
+        return 1;
+    }
+    std::cout << "Checksums and distances verified in " << std::setprecision(2) << verifySeconds << " s" << std::endl;
+    return 0;
+}
@@ -0,0 +1,230 @@
+// Scramble Analysis
+// Generate many game scrambles in parallel and measure how well they mix
+//
+//   rubik_scramble_stats [--count N] [--moves N] [--threads N] [--seed S] [--short N]
+//
+// Each scramble uses the game's generator (scrambleMoves with a fresh 32-bit seed, as
+// RubikCube::scramble does). Threads draw seeds from their own mt19937 stream, fill local
+// histograms and merge them into shared atomic counters once at the end.
+
+#include "cube_search.h"
+#include "move_sequence.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const int MAX_SCRAMBLE_MOVES = 255;
+const int MAX_BOUND = 32;
+
+// Flat histogram layout shared by the thread-local and the merged counters
+enum BinOffsets {
+    BIN_SOLVED_PIECES = 0,                                   // 0..20 pieces home and oriented
+    BIN_LENGTH = BIN_SOLVED_PIECES + 21,                     // Length after cancelling moves
+    BIN_LOWER_BOUND = BIN_LENGTH + MAX_SCRAMBLE_MOVES + 1,   // Distance lower bound
+    BIN_CORNER_POSITION = BIN_LOWER_BOUND + MAX_BOUND,       // [position][corner]
+    BIN_EDGE_POSITION = BIN_CORNER_POSITION + 8 * 8,         // [position][edge]
+    BIN_CORNER_TWIST = BIN_EDGE_POSITION + 12 * 12,          // [position][twist]
+    BIN_EDGE_FLIP = BIN_CORNER_TWIST + 8 * 3,                // [position][flip]
+    BIN_PARITY = BIN_EDGE_FLIP + 12 * 2,                     // Corner permutation parity
+    BIN_COUNT = BIN_PARITY + 2
+};
+
+struct Options {
+    std::uint64_t count = 1000000;
+    int moves = 25;
+    unsigned int threads = 0;
+    unsigned int seed = 1;
+    int shortLength = 15;
+};
+
+int cornerParity(const CubieCube& cube) {
+    int parity = 0;
+    for (int i = 0; i < 8; i++) {
+        for (int j = i + 1; j < 8; j++) parity ^= static_cast<int>(cube.cp[j] < cube.cp[i]);
+    }
+    return parity;
+}
+
+void analyzeRange(const Options& options, unsigned int thread, std::uint64_t count,
+                  const CoordinateTables& tables, std::atomic<std::uint64_t>* merged) {
+    std::seed_seq streamSeed{options.seed, thread};
+    std::mt19937 rng(streamSeed);
+    std::vector<std::uint64_t> bins(BIN_COUNT, 0);
+    std::vector<int> moves;
+    SequenceCanonicalizer canonicalizer;
+
+    for (std::uint64_t n = 0; n < count; n++) {
+        scrambleMoves(options.moves, rng(), moves);
+        CubieCube cube;
+        for (int move : moves) cube.applyMove(move);
+
+        int solvedPieces = 0;
+        for (int i = 0; i < 8; i++) {
+            solvedPieces += cube.cp[i] == i && cube.co[i] == 0;
+            bins[BIN_CORNER_POSITION + i * 8 + cube.cp[i]]++;
+            bins[BIN_CORNER_TWIST + i * 3 + cube.co[i]]++;
+        }
+        for (int i = 0; i < 12; i++) {
+            solvedPieces += cube.ep[i] == i && cube.eo[i] == 0;
+            bins[BIN_EDGE_POSITION + i * 12 + cube.ep[i]]++;
+            bins[BIN_EDGE_FLIP + i * 2 + cube.eo[i]]++;
+        }
+        bins[BIN_SOLVED_PIECES + solvedPieces]++;
+        canonicalizer.clear();
+        canonicalizer.push(moves);
+        bins[BIN_LENGTH + canonicalizer.size()]++;
+        bins[BIN_LOWER_BOUND + tables.lowerBound(cube)]++;
+        bins[BIN_PARITY + cornerParity(cube)]++;
+    }
+
+    for (int i = 0; i < BIN_COUNT; i++) {
+        if (bins[i]) merged[i].fetch_add(bins[i], std::memory_order_relaxed);
+    }
+}
+
+// Upper tail probability of chi-square (Wilson-Hilferty normal approximation)
+double chiSquarePValue(double chi2, int degrees) {
+    double k = degrees;
+    double z = (std::cbrt(chi2 / k) - (1.0 - 2.0 / (9.0 * k))) / std::sqrt(2.0 / (9.0 * k));
+    return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
+// Chi-square of rows of `width` bins each against a uniform distribution
+double chiSquareRows(const std::vector<std::uint64_t>& bins, int offset, int rows, int width) {
+    double chi2 = 0.0;
+    for (int r = 0; r < rows; r++) {
+        double total = 0.0;
+        for (int c = 0; c < width; c++) total += static_cast<double>(bins[offset + r * width + c]);
+        double expected = total / width;
+        if (expected <= 0.0) continue;
+        for (int c = 0; c < width; c++) {
+            double diff = static_cast<double>(bins[offset + r * width + c]) - expected;
+            chi2 += diff * diff / expected;
+        }
+    }
+    return chi2;
+}
+
+// Mean Shannon entropy (bits) of the rows
+double meanEntropy(const std::vector<std::uint64_t>& bins, int offset, int rows, int width) {
+    double sum = 0.0;
+    for (int r = 0; r < rows; r++) {
+        double total = 0.0;
+        for (int c = 0; c < width; c++) total += static_cast<double>(bins[offset + r * width + c]);
+        for (int c = 0; c < width && total > 0.0; c++) {
+            double p = static_cast<double>(bins[offset + r * width + c]) / total;
+            if (p > 0.0) sum -= p * std::log2(p);
+        }
+    }
+    return sum / rows;
+}
+
+void printHistogram(const char* title, const std::vector<std::uint64_t>& bins, int offset, int size, std::uint64_t total) {
+    int first = 0, last = size - 1;
+    while (first < size && bins[offset + first] == 0) first++;
+    while (last > first && bins[offset + last] == 0) last--;
+    std::uint64_t peak = 1;
+    for (int i = first; i <= last; i++) peak = std::max(peak, bins[offset + i]);
+
+    std::cout << "\n" << title << "\n";
+    for (int i = first; i <= last; i++) {
+        std::uint64_t value = bins[offset + i];
+        std::cout << std::setw(5) << i << " " << std::setw(7) << std::fixed << std::setprecision(3)
+                  << 100.0 * value / total << "% " << std::string(static_cast<std::size_t>(50 * value / peak), '#') << "\n";
+    }
+}
+
+void printTest(const char* name, double chi2, int degrees) {
+    double p = chiSquarePValue(chi2, degrees);
+    std::cout << "  " << std::left << std::setw(22) << name << std::right
+              << " chi2 " << std::setw(14) << std::setprecision(2) << chi2
+              << "  df " << std::setw(4) << degrees
+              << "  p " << std::scientific << std::setprecision(3) << p << std::fixed
+              << (p < 0.001 ? "  NOT UNIFORM" : "") << "\n";
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) return false;
+        const char* value = argv[++i];
+        if (std::strcmp(argv[i - 1], "--count") == 0) {
+            options.count = std::strtoull(value, nullptr, 10);
+        } else if (std::strcmp(argv[i - 1], "--moves") == 0) {
+            options.moves = std::min(MAX_SCRAMBLE_MOVES, std::max(0, std::atoi(value)));
+        } else if (std::strcmp(argv[i - 1], "--threads") == 0) {
+            options.threads = static_cast<unsigned int>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(argv[i - 1], "--seed") == 0) {
+            options.seed = static_cast<unsigned int>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(argv[i - 1], "--short") == 0) {
+            options.shortLength = std::atoi(value);
+        } else {
+            return false;
+        }
+    }
+    return options.count > 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Usage: rubik_scramble_stats [--count N] [--moves N] [--threads N] [--seed S] [--short N]" << std::endl;
+        return 1;
+    }
+    if (options.threads == 0) options.threads = std::max(1u, std::thread::hardware_concurrency());
+
+    auto start = std::chrono::steady_clock::now();
+    const CoordinateTables& tables = CoordinateTables::instance();
+    std::unique_ptr<std::atomic<std::uint64_t>[]> merged(new std::atomic<std::uint64_t>[BIN_COUNT]);
+    for (int i = 0; i < BIN_COUNT; i++) merged[i].store(0, std::memory_order_relaxed);
+
+    std::vector<std::thread> workers;
+    for (unsigned int t = 0; t < options.threads; t++) {
+        std::uint64_t share = options.count / options.threads + (t < options.count % options.threads ? 1 : 0);
+        workers.emplace_back(analyzeRange, std::cref(options), t, share, std::cref(tables), merged.get());
+    }
+    for (std::thread& worker : workers) worker.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<std::uint64_t> bins(BIN_COUNT);
+    for (int i = 0; i < BIN_COUNT; i++) bins[i] = merged[i].load(std::memory_order_relaxed);
+    std::uint64_t total = options.count;
+
+    std::cout << std::fixed << std::setprecision(2)
+              << total << " scrambles of " << options.moves << " moves on " << options.threads
+              << " threads in " << seconds << " s (" << total / seconds / 1e6 << " M scrambles/s)\n";
+
+    printHistogram("Pieces solved (home and oriented)", bins, BIN_SOLVED_PIECES, 21, total);
+    printHistogram("Length after cancellation", bins, BIN_LENGTH, MAX_SCRAMBLE_MOVES + 1, total);
+    printHistogram("Distance lower bound (max of twist / flip / corner permutation tables)", bins, BIN_LOWER_BOUND, MAX_BOUND, total);
+
+    std::uint64_t shortCount = 0;
+    for (int i = 0; i < options.shortLength && i <= MAX_SCRAMBLE_MOVES; i++) shortCount += bins[BIN_LENGTH + i];
+    std::cout << "\nShort scrambles (< " << options.shortLength << " moves after cancellation): "
+              << std::setprecision(3) << 100.0 * shortCount / total << "%\n";
+
+    std::cout << "\nPosition entropy (bits, uniform = max)\n"
+              << "  corners " << meanEntropy(bins, BIN_CORNER_POSITION, 8, 8) << " / " << std::log2(8.0) << "\n"
+              << "  edges   " << meanEntropy(bins, BIN_EDGE_POSITION, 12, 12) << " / " << std::log2(12.0) << "\n";
+
+    std::cout << "\nUniformity (chi-square against uniform)\n";
+    printTest("corner positions", chiSquareRows(bins, BIN_CORNER_POSITION, 8, 8), 8 * 7);
+    printTest("edge positions", chiSquareRows(bins, BIN_EDGE_POSITION, 12, 12), 12 * 11);
+    printTest("corner twist", chiSquareRows(bins, BIN_CORNER_TWIST, 8, 3), 8 * 2);
+    printTest("edge flip", chiSquareRows(bins, BIN_EDGE_FLIP, 12, 2), 12);
+    printTest("permutation parity", chiSquareRows(bins, BIN_PARITY, 1, 2), 1);
+    return 0;
+}
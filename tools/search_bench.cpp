@@ -0,0 +1,146 @@
+// Search Bench
+// Optimal solves with CubeSearch: nodes per second and heap allocations per solve
+//
+//   rubik_search "<scramble>" [--pdb FILE [--placement P] [--pages M]]
+//   rubik_search [--depth D] [--count N] [--seed S] [--pdb FILE [--placement P] [--pages M]]
+//
+// The bench solves N random scrambles of D moves and fails (exit 1) if any solve touched the
+// heap - the search hot path is meant to run entirely on preallocated stacks. --pdb adds a
+// corners table from rubik_pdb_build to the lower bound, mapped or loaded with a placement
+// (mapped, first-touch, interleave, replicate; default interleave) and page mode (off, thp,
+// explicit; default thp) as in rubik_numa_bench.
+
+#include "alloc_counter.h"
+#include "cube_search.h"
+#include "move_sequence.h"
+#include "pattern_database.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+
+namespace {
+
+struct BenchOptions {
+    int depth = 8;
+    int count = 200;
+    std::uint32_t seed = 1;
+    std::string pdbPath;
+    std::string placement = "interleave";
+    std::string pages = "thp";
+};
+
+bool parseOptions(int argc, char* argv[], int first, BenchOptions& options) {
+    for (int i = first; i < argc; i++) {
+        if (i + 1 >= argc) return false;
+        if (std::strcmp(argv[i], "--depth") == 0) {
+            options.depth = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--count") == 0) {
+            options.count = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--seed") == 0) {
+            options.seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--pdb") == 0) {
+            options.pdbPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--placement") == 0) {
+            options.placement = argv[++i];
+        } else if (std::strcmp(argv[i], "--pages") == 0) {
+            options.pages = argv[++i];
+        } else {
+            return false;
+        }
+    }
+    return options.depth >= 0 && options.depth <= MAX_SEARCH_DEPTH && options.count > 0;
+}
+
+int solveOne(const std::string& text, const PatternDatabase* corners) {
+    std::vector<int> moves;
+    if (!parseSequence(text, moves)) {
+        std::cerr << "Invalid scramble: " << text << std::endl;
+        return 1;
+    }
+    CubieCube cube;
+    for (int move : moves) cube.applyMove(move);
+
+    CubeSearch search(corners);
+    SearchResult result;
+    auto start = std::chrono::steady_clock::now();
+    bool solved = search.solve(cube, MAX_SEARCH_DEPTH, result);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (!solved) {
+        std::cout << "No solution within " << MAX_SEARCH_DEPTH << " moves (" << result.nodes << " nodes)" << std::endl;
+        return 1;
+    }
+    std::cout << sequenceToString(std::vector<int>(result.moves, result.moves + result.length)) << " ("
+              << result.length << " moves, " << result.nodes << " nodes, " << seconds * 1000.0 << " ms)" << std::endl;
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    bool single = argc > 1 && argv[1][0] != '-';
+    BenchOptions options;
+    if (!parseOptions(argc, argv, single ? 2 : 1, options)) {
+        std::cerr << "Usage: rubik_search \"<scramble>\" | rubik_search [--depth D] [--count N] [--seed S]\n"
+                     "  either form: [--pdb FILE [--placement mapped|first-touch|interleave|replicate] [--pages off|thp|explicit]]"
+                  << std::endl;
+        return 1;
+    }
+
+    PatternDatabase database;
+    const PatternDatabase* corners = nullptr;
+    if (!options.pdbPath.empty()) {
+        if (!openPatternDatabase(options.pdbPath, options.placement, options.pages, database)) {
+            std::cerr << "Cannot open " << options.pdbPath << " as " << options.placement << " / " << options.pages << std::endl;
+            return 1;
+        }
+        if (database.getKind() != PATTERN_CORNERS) {
+            std::cerr << options.pdbPath << " is a " << patternName(database.getKind())
+                      << " table; the search only uses corners" << std::endl;
+            return 1;
+        }
+        corners = &database;
+    }
+    if (single) return solveOne(argv[1], corners);
+    if (!allocationCountingEnabled()) {
+        std::cout << "Allocation counting compiled out (RUBIK_COUNT_ALLOCATIONS=OFF)" << std::endl;
+    }
+
+    // Scrambles and the solver (which builds the shared tables) are set up before timing
+    std::mt19937 rng(options.seed);
+    std::vector<CubieCube> cubes(static_cast<std::size_t>(options.count));
+    std::vector<int> moves;
+    for (CubieCube& cube : cubes) {
+        scrambleMoves(options.depth, rng(), moves);
+        for (int move : moves) cube.applyMove(move);
+    }
+    CubeSearch search(corners);
+    SearchResult result;
+
+    std::uint64_t nodes = 0, allocations = 0, totalLength = 0;
+    int failures = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const CubieCube& cube : cubes) {
+        AllocationScope scope;
+        bool solved = search.solve(cube, options.depth, result);
+        allocations += scope.count();
+        nodes += result.nodes;
+
+        CubieCube check = cube;
+        for (int i = 0; solved && i < result.length; i++) check.applyMove(result.moves[i]);
+        if (!solved || !check.isSolved()) {
+            failures++;
+            continue;
+        }
+        totalLength += static_cast<std::uint64_t>(result.length);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << options.count << " scrambles of " << options.depth << " moves in " << seconds << " s\n"
+              << "  average optimal length: " << static_cast<double>(totalLength) / (options.count - failures) << "\n"
+              << "  nodes: " << nodes << " (" << nodes / seconds / 1e6 << " M nodes/s)\n"
+              << "  heap allocations during solves: " << allocations << "\n"
+              << "  failures: " << failures << std::endl;
+    return failures == 0 && allocations == 0 ? 0 : 1;
+}
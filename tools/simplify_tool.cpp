@@ -0,0 +1,61 @@
+// Simplify Tool
+// Stream move sequences (one per line) from stdin and print their canonical form
+//
+//   rubik_simplify [--table DEPTH] [--window N] < solutions.txt
+//
+// Without a table only merging and reordering are applied; with --table the tail of every
+// sequence is also checked against optimal sequences up to DEPTH moves (5 by default).
+
+#include "move_sequence.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[]) {
+    int tableDepth = 0;
+    int window = 0;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--table") == 0) {
+            tableDepth = (i + 1 < argc && argv[i + 1][0] != '-') ? std::atoi(argv[++i]) : 5;
+        } else if (std::strcmp(argv[i], "--window") == 0 && i + 1 < argc) {
+            window = std::atoi(argv[++i]);
+        } else {
+            std::cerr << "Usage: rubik_simplify [--table DEPTH] [--window N] < sequences.txt" << std::endl;
+            return 1;
+        }
+    }
+
+    SequenceTable table;
+    SequenceCanonicalizer canonicalizer;
+    if (tableDepth > 0) {
+        auto start = std::chrono::steady_clock::now();
+        table.build(tableDepth);
+        std::cerr << "Table: " << table.size() << " states within " << table.maxDepth() << " moves in "
+                  << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() << " s" << std::endl;
+        canonicalizer.setTable(&table, window);
+    }
+
+    std::ios::sync_with_stdio(false);
+    std::string line;
+    std::vector<int> moves;
+    std::uint64_t movesIn = 0, movesOut = 0, lineNumber = 0;
+    int status = 0;
+    while (std::getline(std::cin, line)) {
+        lineNumber++;
+        if (!parseSequence(line, moves)) {
+            std::cerr << "Line " << lineNumber << ": invalid move" << std::endl;
+            std::cout << "\n";
+            status = 1;
+            continue;
+        }
+        canonicalizer.clear();
+        canonicalizer.push(moves);
+        std::cout << sequenceToString(canonicalizer.moves()) << "\n";
+        movesIn += moves.size();
+        movesOut += canonicalizer.size();
+    }
+    std::cerr << lineNumber << " sequences, " << movesIn << " -> " << movesOut << " moves" << std::endl;
+    return status;
+}
@@ -0,0 +1,579 @@
+// Solver Daemon
+// Long-lived local service that owns the solver tables once for every tool on the host
+//
+//   rubik_solverd [--socket PATH] [--lldb FILE] [--threads N] [--max-batch N] [--max-queue N]
+//                 [--pdb FILE [--placement P] [--pages M]]
+//   rubik_solverd stats [--socket PATH]
+//   rubik_solverd bench [--socket PATH] [--clients N] [--requests N]
+//
+// One I/O thread polls the listening socket and all connections, cuts complete frames
+// (see solver_service.h) and queues them. Worker threads take everything queued, up to
+// --max-batch requests, at once: all ESTIMATE states in a batch go through a single
+// DistanceEstimator::estimateBatch call, the rest are answered one by one. The daemon keeps
+// histograms of queue depth at arrival, batch size and per-type latency (arrival to reply
+// written), served by the STATS request and printed on exit (Ctrl+C / SIGTERM). A client that
+// stops reading its replies is dropped once a send blocks for a second. bench runs
+// N concurrent clients against a running daemon, each sending single-state ESTIMATE
+// requests with a SOLVE every 16th, and reports the round-trip rate. Requests that arrive
+// while --max-queue jobs are waiting are answered STATUS_UNAVAILABLE at once, so a client that
+// floods the daemon cannot grow its memory without bound. --pdb gives OPTIMAL searches a
+// corners pattern database as an extra lower bound, placed as in rubik_search; with
+// --placement replicate each worker is pinned to a node and reads that node's copy.
+
+#include "pattern_database.h"
+#include "solver_service.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace {
+
+const int QUEUE_BINS = 65;     // Depth 0..63, then 64+
+const int BATCH_BINS = 65;
+const int LATENCY_BINS = 24;   // Powers of two microseconds: <1, <2, <4, ... >= 4 s
+const int OPTIMAL_MAX_DEPTH = 11;  // Deeper optimal searches would stall a worker for seconds or more
+const int SEND_TIMEOUT_MS = 1000;  // A client that reads nothing this long is dropped
+
+const char* const REQUEST_NAMES[REQUEST_TYPE_COUNT] = {"?", "solve", "optimal", "validate", "estimate", "stats"};
+
+volatile std::sig_atomic_t stopRequested = 0;
+
+void onSignal(int) {
+    stopRequested = 1;
+}
+
+struct DaemonOptions {
+    std::string socketPath = DEFAULT_SOLVER_SOCKET;
+    std::string lastLayerPath = "last_layer.db";
+    unsigned int threads = 0;  // 0 = hardware concurrency
+    std::size_t maxBatch = 64;
+    std::size_t maxQueue = 4096;
+    std::string pdbPath;
+    std::string placement = "interleave";
+    std::string pages = "thp";
+    int clients = 8;        // bench
+    int requests = 10000;   // bench, per client
+};
+
+// Closed when the I/O thread and every queued job have let go of it, so a worker never
+// writes to a descriptor number that was already reused
+struct Connection {
+    int fd;
+    std::mutex writeMutex;
+    bool dropped;  // A send failed or timed out; guarded by writeMutex
+    std::vector<std::uint8_t> input;
+
+    explicit Connection(int socketFd) : fd(socketFd), dropped(false) {}
+    ~Connection() { ::close(fd); }
+};
+
+struct Job {
+    std::shared_ptr<Connection> connection;
+    SolverFrame frame;
+    std::chrono::steady_clock::time_point received;
+};
+
+class Metrics {
+private:
+    std::atomic<std::uint64_t> queueDepth[QUEUE_BINS];
+    std::atomic<std::uint64_t> batchSize[BATCH_BINS];
+    std::atomic<std::uint64_t> latency[REQUEST_TYPE_COUNT][LATENCY_BINS];
+    std::atomic<std::uint64_t> rejected;
+
+    static void printHistogram(std::ostringstream& out, const char* title, const std::atomic<std::uint64_t>* bins,
+                               int count, bool powers) {
+        std::uint64_t total = 0;
+        for (int i = 0; i < count; i++) total += bins[i].load(std::memory_order_relaxed);
+        if (total == 0) return;
+        out << title << " (" << total << ")\n";
+        for (int i = 0; i < count; i++) {
+            std::uint64_t value = bins[i].load(std::memory_order_relaxed);
+            if (value == 0) continue;
+            out << "  ";
+            if (powers) {
+                out << (i == 0 ? "< 1" : "< " + std::to_string(1ull << i)) << " us";
+            } else {
+                out << (i == count - 1 ? std::to_string(i) + "+" : std::to_string(i));
+            }
+            out << ": " << value << "\n";
+        }
+    }
+
+public:
+    Metrics() : rejected(0) {
+        for (auto& bin : queueDepth) bin.store(0);
+        for (auto& bin : batchSize) bin.store(0);
+        for (auto& type : latency) {
+            for (auto& bin : type) bin.store(0);
+        }
+    }
+
+    void recordQueueDepth(std::size_t depth) {
+        queueDepth[std::min<std::size_t>(depth, QUEUE_BINS - 1)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void recordRejected() {
+        rejected.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void recordBatch(std::size_t size) {
+        batchSize[std::min<std::size_t>(size, BATCH_BINS - 1)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void recordLatency(std::uint8_t type, double microseconds) {
+        int bin = 0;
+        while (bin < LATENCY_BINS - 1 && microseconds >= static_cast<double>(1ull << bin)) bin++;
+        latency[type < REQUEST_TYPE_COUNT ? type : 0][bin].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::string report() const {
+        std::ostringstream out;
+        printHistogram(out, "Queue depth at arrival", queueDepth, QUEUE_BINS, false);
+        printHistogram(out, "Batch size", batchSize, BATCH_BINS, false);
+        std::uint64_t full = rejected.load(std::memory_order_relaxed);
+        if (full > 0) out << "Rejected with a full queue: " << full << "\n";
+        for (int type = 0; type < REQUEST_TYPE_COUNT; type++) {
+            std::string title = std::string("Latency, ") + REQUEST_NAMES[type];
+            printHistogram(out, title.c_str(), latency[type], LATENCY_BINS, true);
+        }
+        return out.str();
+    }
+};
+
+struct Daemon {
+    DaemonOptions options;
+    LastLayerDatabase lastLayer;
+    HumanSolver humanSolver;
+    DistanceEstimator estimator;
+    PatternDatabase corners;
+    Metrics metrics;
+
+    std::mutex queueMutex;
+    std::condition_variable queueReady;
+    std::deque<Job> queue;
+    bool stopping = false;
+
+    Daemon() : humanSolver(&lastLayer) {}
+};
+
+bool readState(const std::vector<std::uint8_t>& body, std::size_t offset, CubieCube& cube) {
+    return body.size() >= offset + RANKED_STATE_BYTES && CubieCube::decodeRanked(body.data() + offset, cube) &&
+           cube.isValid();
+}
+
+void putU32(std::vector<std::uint8_t>& out, std::uint32_t value) {
+    for (int i = 0; i < 4; i++) out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+}
+
+// Everything but ESTIMATE (which the batch answers together)
+void answer(Daemon& daemon, CubeSearch& search, const SolverFrame& request, std::vector<std::uint8_t>& body) {
+    const std::vector<std::uint8_t>& in = request.body;
+    CubieCube cube;
+    switch (request.type) {
+        case REQUEST_SOLVE: {
+            if (in.size() != RANKED_STATE_BYTES || !readState(in, 0, cube)) break;
+            if (!daemon.lastLayer.isReady()) {
+                body.push_back(STATUS_UNAVAILABLE);
+                return;
+            }
+            std::vector<SolveStage> stages;
+            if (!daemon.humanSolver.solve(cube, stages)) {
+                body.push_back(STATUS_FAILED);
+                return;
+            }
+            body.push_back(STATUS_OK);
+            writeStages(stages, body);
+            return;
+        }
+        case REQUEST_OPTIMAL: {
+            if (in.size() != 1 + RANKED_STATE_BYTES || !readState(in, 1, cube)) break;
+            SearchResult result;
+            if (!search.solve(cube, std::min<int>(in[0], OPTIMAL_MAX_DEPTH), result)) {
+                body.push_back(STATUS_FAILED);
+                return;
+            }
+            body.push_back(STATUS_OK);
+            body.push_back(static_cast<std::uint8_t>(result.length));
+            body.insert(body.end(), result.moves, result.moves + result.length);
+            putU32(body, static_cast<std::uint32_t>(std::min<std::uint64_t>(result.nodes, 0xFFFFFFFFu)));
+            return;
+        }
+        case REQUEST_VALIDATE: {
+            if (in.size() != 54) break;
+            RubikCube stickers;
+            for (int i = 0; i < 54; i++) {
+                if (in[i] > BLUE) {
+                    body.push_back(STATUS_BAD_REQUEST);
+                    return;
+                }
+                stickers.setColor(i / 9, i / 3 % 3, i % 3, in[i]);
+            }
+            bool valid = CubieCube::fromFacelets(stickers, cube) && cube.isValid();
+            body.push_back(STATUS_OK);
+            body.push_back(valid ? 1 : 0);
+            if (valid) {
+                std::uint8_t state[RANKED_STATE_BYTES];
+                cube.encodeRanked(state);
+                body.insert(body.end(), state, state + RANKED_STATE_BYTES);
+            }
+            return;
+        }
+        case REQUEST_STATS: {
+            body.push_back(STATUS_OK);
+            std::string report = daemon.metrics.report();
+            body.insert(body.end(), report.begin(), report.end());
+            return;
+        }
+    }
+    body.clear();
+    body.push_back(STATUS_BAD_REQUEST);
+}
+
+void reply(Daemon& daemon, const Job& job, const std::vector<std::uint8_t>& body) {
+    std::vector<std::uint8_t> frame;
+    appendFrame(frame, job.frame.type, job.frame.id, body);
+    {
+        // Sends time out after SEND_TIMEOUT_MS (set at accept), so a client that stops reading
+        // costs a worker at most that long; it is then shut down and the I/O thread drops it
+        std::lock_guard<std::mutex> lock(job.connection->writeMutex);
+        const std::uint8_t* data = frame.data();
+        std::size_t left = frame.size();
+        while (left > 0 && !job.connection->dropped) {
+            ssize_t sent = ::send(job.connection->fd, data, left, MSG_NOSIGNAL);
+            if (sent < 0 && errno == EINTR) continue;
+            if (sent <= 0) {
+                job.connection->dropped = true;
+                ::shutdown(job.connection->fd, SHUT_RDWR);
+                break;
+            }
+            data += sent;
+            left -= static_cast<std::size_t>(sent);
+        }
+    }
+    double microseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - job.received).count();
+    daemon.metrics.recordLatency(job.frame.type, microseconds);
+}
+
+void worker(Daemon& daemon) {
+    CubeSearch search(daemon.corners.isOpen() ? &daemon.corners : nullptr);
+    std::vector<Job> batch;
+    std::vector<CubieCube> states;
+    std::vector<DistanceEstimate> estimates;
+    std::vector<std::size_t> firstState;  // Per job: offset into states, or -1 when not an estimate
+    std::vector<std::uint8_t> body;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(daemon.queueMutex);
+            daemon.queueReady.wait(lock, [&] { return daemon.stopping || !daemon.queue.empty(); });
+            if (daemon.stopping) return;
+            std::size_t take = std::min(daemon.queue.size(), daemon.options.maxBatch);
+            batch.assign(std::make_move_iterator(daemon.queue.begin()), std::make_move_iterator(daemon.queue.begin() + take));
+            daemon.queue.erase(daemon.queue.begin(), daemon.queue.begin() + take);
+        }
+        daemon.metrics.recordBatch(batch.size());
+
+        // Coalesce the estimate requests of the whole batch into one evaluation
+        states.clear();
+        firstState.assign(batch.size(), static_cast<std::size_t>(-1));
+        for (std::size_t j = 0; j < batch.size(); j++) {
+            const std::vector<std::uint8_t>& in = batch[j].frame.body;
+            if (batch[j].frame.type != REQUEST_ESTIMATE || in.size() < 2) continue;
+            std::size_t count = in[0] | static_cast<std::size_t>(in[1]) << 8;
+            if (count > SOLVER_MAX_ESTIMATES || in.size() != 2 + count * RANKED_STATE_BYTES) continue;
+            std::size_t first = states.size();
+            bool valid = true;
+            for (std::size_t i = 0; i < count && valid; i++) {
+                CubieCube cube;
+                valid = readState(in, 2 + i * RANKED_STATE_BYTES, cube);
+                states.push_back(cube);
+            }
+            if (valid) {
+                firstState[j] = first;
+            } else {
+                states.resize(first);
+            }
+        }
+        estimates.resize(states.size());
+        if (!states.empty()) daemon.estimator.estimateBatch(states.data(), states.size(), estimates.data());
+
+        for (std::size_t j = 0; j < batch.size(); j++) {
+            body.clear();
+            if (batch[j].frame.type == REQUEST_ESTIMATE) {
+                if (firstState[j] == static_cast<std::size_t>(-1)) {
+                    body.push_back(STATUS_BAD_REQUEST);
+                } else {
+                    const std::vector<std::uint8_t>& in = batch[j].frame.body;
+                    std::size_t count = in[0] | static_cast<std::size_t>(in[1]) << 8;
+                    body.push_back(STATUS_OK);
+                    writeEstimates(&estimates[firstState[j]], count, body);
+                }
+            } else {
+                answer(daemon, search, batch[j].frame, body);
+            }
+            reply(daemon, batch[j], body);
+        }
+        batch.clear();
+    }
+}
+
+int listenOn(const std::string& path) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Socket path too long: " << path << std::endl;
+        return -1;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size());
+
+    // A leftover socket file from a crashed daemon is removed; a live daemon is left alone
+    SolverClient probe;
+    if (probe.connect(path)) {
+        std::cerr << "Another daemon is already listening on " << path << std::endl;
+        return -1;
+    }
+    ::unlink(path.c_str());
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || ::bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(fd, 64) != 0) {
+        std::cerr << "Could not listen on " << path << ": " << std::strerror(errno) << std::endl;
+        if (fd >= 0) ::close(fd);
+        return -1;
+    }
+    ::chmod(path.c_str(), 0600);  // Local user only
+    return fd;
+}
+
+// Read what is available on a connection and queue its complete frames; false on hang-up
+bool readConnection(Daemon& daemon, const std::shared_ptr<Connection>& connection) {
+    std::uint8_t chunk[16384];
+    ssize_t received = ::recv(connection->fd, chunk, sizeof(chunk), 0);
+    if (received <= 0) return false;
+    connection->input.insert(connection->input.end(), chunk, chunk + received);
+
+    auto now = std::chrono::steady_clock::now();
+    SolverFrame frame;
+    bool malformed = false;
+    std::size_t queued = 0;
+    std::vector<Job> rejected;
+    {
+        std::lock_guard<std::mutex> lock(daemon.queueMutex);
+        while (takeFrame(connection->input, frame, malformed)) {
+            if (daemon.queue.size() >= daemon.options.maxQueue) {
+                rejected.push_back(Job{connection, std::move(frame), now});
+                continue;
+            }
+            daemon.metrics.recordQueueDepth(daemon.queue.size());
+            daemon.queue.push_back(Job{connection, std::move(frame), now});
+            queued++;
+        }
+    }
+    if (queued == 1) daemon.queueReady.notify_one();
+    if (queued > 1) daemon.queueReady.notify_all();
+    const std::vector<std::uint8_t> unavailable(1, STATUS_UNAVAILABLE);
+    for (const Job& job : rejected) {
+        daemon.metrics.recordRejected();
+        reply(daemon, job, unavailable);
+    }
+    return !malformed;
+}
+
+void serve(Daemon& daemon, int listenFd) {
+    std::map<int, std::shared_ptr<Connection>> connections;
+    std::vector<pollfd> fds;
+    while (!stopRequested) {
+        fds.clear();
+        fds.push_back(pollfd{listenFd, POLLIN, 0});
+        for (const auto& entry : connections) fds.push_back(pollfd{entry.first, POLLIN, 0});
+        if (::poll(fds.data(), fds.size(), 200) <= 0) continue;
+
+        if (fds[0].revents & POLLIN) {
+            int client = ::accept(listenFd, nullptr, nullptr);
+            if (client >= 0) {
+                timeval timeout{SEND_TIMEOUT_MS / 1000, (SEND_TIMEOUT_MS % 1000) * 1000};
+                ::setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+                connections[client] = std::make_shared<Connection>(client);
+            }
+        }
+        for (std::size_t i = 1; i < fds.size(); i++) {
+            if (!fds[i].revents) continue;
+            auto it = connections.find(fds[i].fd);
+            if (!(fds[i].revents & POLLIN) || !readConnection(daemon, it->second)) {
+                ::shutdown(fds[i].fd, SHUT_RDWR);
+                connections.erase(it);
+            }
+        }
+    }
+}
+
+bool parseOptions(int argc, char* argv[], int first, DaemonOptions& options) {
+    for (int i = first; i < argc; i++) {
+        if (i + 1 >= argc) return false;
+        if (std::strcmp(argv[i], "--socket") == 0) {
+            options.socketPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--lldb") == 0) {
+            options.lastLayerPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--threads") == 0) {
+            options.threads = static_cast<unsigned int>(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--max-batch") == 0) {
+            options.maxBatch = static_cast<std::size_t>(std::max(1, std::atoi(argv[++i])));
+        } else if (std::strcmp(argv[i], "--max-queue") == 0) {
+            options.maxQueue = static_cast<std::size_t>(std::max(1, std::atoi(argv[++i])));
+        } else if (std::strcmp(argv[i], "--pdb") == 0) {
+            options.pdbPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--placement") == 0) {
+            options.placement = argv[++i];
+        } else if (std::strcmp(argv[i], "--pages") == 0) {
+            options.pages = argv[++i];
+        } else if (std::strcmp(argv[i], "--clients") == 0) {
+            options.clients = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--requests") == 0) {
+            options.requests = std::max(1, std::atoi(argv[++i]));
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+int bench(const DaemonOptions& options) {
+    std::atomic<int> failures(0);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> clients;
+    for (int c = 0; c < options.clients; c++) {
+        clients.emplace_back([&options, &failures, c] {
+            SolverClient client;
+            if (!client.connect(options.socketPath)) {
+                failures++;
+                return;
+            }
+            std::mt19937 rng(static_cast<std::uint32_t>(c + 1));
+            std::vector<int> moves;
+            std::vector<DistanceEstimate> estimates;
+            std::vector<SolveStage> stages;
+            SolverStatus status;
+            for (int r = 0; r < options.requests; r++) {
+                scrambleMoves(25, rng(), moves);
+                CubieCube cube;
+                for (int move : moves) cube.applyMove(move);
+                bool ok = client.estimate(&cube, 1, estimates);
+                if (ok && r % 16 == 0) ok = client.solve(cube, stages, &status) || status == STATUS_UNAVAILABLE;
+                if (!ok) {
+                    failures++;
+                    return;
+                }
+            }
+        });
+    }
+    for (std::thread& thread : clients) thread.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::uint64_t total = static_cast<std::uint64_t>(options.clients) * options.requests;
+    std::cout << options.clients << " clients x " << options.requests << " requests in " << seconds << " s ("
+              << total / seconds << " requests/s), " << failures.load() << " failed clients" << std::endl;
+    return failures.load() == 0 ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string command = argc > 1 && argv[1][0] != '-' ? argv[1] : "";
+    DaemonOptions options;
+    if ((command != "" && command != "stats" && command != "bench") ||
+        !parseOptions(argc, argv, command.empty() ? 1 : 2, options)) {
+        std::cerr << "Usage:\n"
+                  << "  rubik_solverd [--socket PATH] [--lldb FILE] [--threads N] [--max-batch N] [--max-queue N]\n"
+                  << "                [--pdb FILE [--placement mapped|first-touch|interleave|replicate] [--pages off|thp|explicit]]\n"
+                  << "  rubik_solverd stats [--socket PATH]\n"
+                  << "  rubik_solverd bench [--socket PATH] [--clients N] [--requests N]\n";
+        return 1;
+    }
+    std::signal(SIGPIPE, SIG_IGN);
+
+    if (command == "bench") return bench(options);
+    if (command == "stats") {
+        SolverClient client;
+        std::string report;
+        if (!client.connect(options.socketPath) || !client.stats(report)) {
+            std::cerr << "No daemon on " << options.socketPath << std::endl;
+            return 1;
+        }
+        std::cout << (report.empty() ? "No requests yet\n" : report);
+        return 0;
+    }
+
+    Daemon daemon;
+    daemon.options = options;
+
+    if (daemon.lastLayer.open(daemon.options.lastLayerPath)) {
+        HumanSolver::warmUp();
+    } else {
+        std::cerr << "Warning: no last-layer database at " << daemon.options.lastLayerPath
+                  << "; SOLVE requests will be refused" << std::endl;
+    }
+    if (!options.pdbPath.empty()) {
+        if (!openPatternDatabase(options.pdbPath, options.placement, options.pages, daemon.corners)) {
+            std::cerr << "Cannot open " << options.pdbPath << " as " << options.placement << " / " << options.pages << std::endl;
+            return 1;
+        }
+        if (daemon.corners.getKind() != PATTERN_CORNERS) {
+            std::cerr << options.pdbPath << " is a " << patternName(daemon.corners.getKind())
+                      << " table; OPTIMAL searches only use corners" << std::endl;
+            return 1;
+        }
+    }
+    int listenFd = listenOn(daemon.options.socketPath);
+    if (listenFd < 0) return 1;
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+    unsigned int threads = daemon.options.threads ? daemon.options.threads : std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::thread> workers;
+    int nodes = std::max(1, numaNodeCount());
+    bool pin = daemon.corners.replicaCount() > 1;
+    for (unsigned int t = 0; t < threads; t++) {
+        workers.emplace_back([&daemon, pin, nodes, t] {
+            if (pin) numaRunOnNode(static_cast<int>(t) % nodes);
+            worker(daemon);
+        });
+    }
+    std::cout << "Listening on " << daemon.options.socketPath << " with " << threads << " workers" << std::endl;
+
+    serve(daemon, listenFd);
+
+    {
+        std::lock_guard<std::mutex> lock(daemon.queueMutex);
+        daemon.stopping = true;
+    }
+    daemon.queueReady.notify_all();
+    for (std::thread& thread : workers) thread.join();
+    ::close(listenFd);
+    ::unlink(daemon.options.socketPath.c_str());
+    std::cout << daemon.metrics.report();
+    return 0;
+}
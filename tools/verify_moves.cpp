@@ -0,0 +1,176 @@
+// Verify Moves Tool
+// Property-based differential checks of every move implementation against RubikCube
+//
+//   rubik_verify [--cases N] [--length L] [--threads T] [--seed S]
+//
+// Runs the fixed checks (group relations, compile-time move tables, renderer sticker mapping,
+// mouse picking) once and times picking over random screen rays, then N random sequences of
+// 0..L moves through checkSequence on all threads; every 64th case also drives a 64-lane
+// BatchCube from 64 different random states. Exits non-zero on the first failure
+// and prints the seed and sequence that reproduce it.
+
+#include "move_checks.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+
+namespace {
+
+const std::size_t BATCH_LANES = 64;
+const int BATCH_EVERY = 64;
+
+struct VerifyOptions {
+    std::uint64_t cases = 1000000;
+    int length = 24;
+    unsigned int threads = 0;  // 0 = hardware concurrency
+    std::uint32_t seed = 1;
+};
+
+struct SharedState {
+    std::atomic<std::uint64_t> nextBlock{0};
+    std::atomic<std::uint64_t> moves{0};
+    std::atomic<bool> failed{false};
+    std::mutex mutex;
+    std::string failure;
+};
+
+const std::uint64_t BLOCK_CASES = 4096;
+
+void randomSequence(std::mt19937& rng, int maxLength, std::vector<int>& moves) {
+    moves.resize(rng() % static_cast<std::uint32_t>(maxLength + 1));
+    for (int& move : moves) move = static_cast<int>(rng() % NUM_MOVES);
+}
+
+// Blocks of cases are handed out through an atomic counter; case n always uses seed + n,
+// so a failure reproduces with the same seed regardless of the thread count
+void worker(const VerifyOptions& options, SharedState& shared) {
+    BatchCube batch(BATCH_LANES);
+    std::vector<CubieCube> starts(BATCH_LANES);
+    std::vector<int> moves, scramble;
+    std::string failure;
+    std::uint64_t movesDone = 0;
+
+    while (!shared.failed.load(std::memory_order_relaxed)) {
+        std::uint64_t first = shared.nextBlock.fetch_add(1) * BLOCK_CASES;
+        if (first >= options.cases) break;
+        std::uint64_t last = std::min(first + BLOCK_CASES, options.cases);
+        for (std::uint64_t n = first; n < last; n++) {
+            std::mt19937 rng(options.seed + static_cast<std::uint32_t>(n));
+            randomSequence(rng, options.length, moves);
+            bool ok = checkSequence(moves, failure);
+            movesDone += moves.size();
+
+            if (ok && n % BATCH_EVERY == 0) {
+                for (CubieCube& start : starts) {
+                    randomSequence(rng, options.length, scramble);
+                    start = CubieCube();
+                    for (int move : scramble) start.applyMove(move);
+                }
+                ok = checkBatch(batch, starts, moves, failure);
+                movesDone += moves.size() * BATCH_LANES;
+            }
+            if (!ok) {
+                std::lock_guard<std::mutex> lock(shared.mutex);
+                if (!shared.failed.exchange(true)) {
+                    shared.failure = "case " + std::to_string(n) + " (seed " + std::to_string(options.seed) + "): " + failure;
+                }
+                break;
+            }
+        }
+    }
+    shared.moves += movesDone;
+}
+
+// Rays from an orbiting camera at distance 8 towards random points around the cube
+void timePicking() {
+    const int RAYS = 200000;
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::vector<PickRay> rays(RAYS);
+    for (PickRay& ray : rays) {
+        float angle = unit(rng) * 3.14159265f, height = unit(rng) * 4.0f;
+        ray.origin[0] = 8.0f * std::sin(angle);
+        ray.origin[1] = height;
+        ray.origin[2] = 8.0f * std::cos(angle);
+        for (int k = 0; k < 3; k++) ray.direction[k] = unit(rng) * 2.0f - ray.origin[k];
+    }
+
+    int hits = 0;
+    StickerHit hit;
+    auto start = std::chrono::steady_clock::now();
+    for (const PickRay& ray : rays) hits += pickSticker(ray, hit) ? 1 : 0;
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Picking: " << ns / RAYS << " ns per ray (" << hits << " of " << RAYS << " hit a sticker)" << std::endl;
+}
+
+bool parseOptions(int argc, char* argv[], VerifyOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) return false;
+        if (std::strcmp(argv[i], "--cases") == 0) {
+            options.cases = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--length") == 0) {
+            options.length = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--threads") == 0) {
+            options.threads = static_cast<unsigned int>(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--seed") == 0) {
+            options.seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            return false;
+        }
+    }
+    return options.length >= 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    VerifyOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Usage: rubik_verify [--cases N] [--length L] [--threads T] [--seed S]" << std::endl;
+        return 1;
+    }
+    if (options.threads == 0) options.threads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::string failure;
+    if (!checkGroupRelations(failure)) {
+        std::cerr << "Group relations: " << failure << std::endl;
+        return 1;
+    }
+    if (!checkMoveTables(failure)) {
+        std::cerr << "Move tables: " << failure << std::endl;
+        return 1;
+    }
+    if (!checkStickerMap(failure)) {
+        std::cerr << "Sticker map: " << failure << std::endl;
+        return 1;
+    }
+    if (!checkPicking(failure)) {
+        std::cerr << "Picking: " << failure << std::endl;
+        return 1;
+    }
+    std::cout << "Group relations, move tables, renderer sticker mapping and picking: ok" << std::endl;
+    timePicking();
+
+    auto start = std::chrono::steady_clock::now();
+    SharedState shared;
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < options.threads; t++) {
+        threads.emplace_back(worker, std::cref(options), std::ref(shared));
+    }
+    for (std::thread& thread : threads) thread.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (shared.failed) {
+        std::cerr << "FAILED " << shared.failure << std::endl;
+        return 1;
+    }
+    std::cout << options.cases << " random sequences (" << shared.moves.load() << " moves) on " << options.threads
+              << " threads in " << seconds << " s (" << options.cases / seconds << " cases/s): ok" << std::endl;
+    return 0;
+}
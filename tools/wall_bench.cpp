@@ -0,0 +1,125 @@
+// Wall Bench
+// CPU cost per frame of the cube wall: parallel update, then frustum culling and LOD split
+//
+//   rubik_wall_bench [--cubes N] [--frames F] [--threads T] [--distance D]
+//
+// Simulates F frames at 60 Hz with the camera D units in front of the wall, orbiting slowly so
+// the visible set changes, and prints update / cull times against the 16.7 ms frame budget.
+
+#include "cube_wall.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+constexpr float FRAME_SECONDS = 1.0f / 60.0f;
+
+struct BenchOptions {
+    int cubes = 500;
+    int frames = 600;
+    int threads = 0;
+    float distance = 60.0f;
+};
+
+bool parseOptions(int argc, char* argv[], BenchOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) return false;
+        if (std::strcmp(argv[i], "--cubes") == 0) {
+            options.cubes = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--frames") == 0) {
+            options.frames = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--threads") == 0) {
+            options.threads = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--distance") == 0) {
+            options.distance = static_cast<float>(std::atof(argv[++i]));
+        } else {
+            return false;
+        }
+    }
+    return options.cubes > 0 && options.frames > 0 && options.threads >= 0 && options.distance > 0.0f;
+}
+
+// Same projection as Renderer (45 degree fov) and a camera at angle around the Y axis
+void cameraMatrices(float distance, float angle, float farPlane, float projection[16], float view[16]) {
+    float nearPlane = 0.1f;
+    float f = 1.0f / std::tan(45.0f * 3.14159265f / 360.0f);
+    float aspect = 1400.0f / 1000.0f;
+    std::fill(projection, projection + 16, 0.0f);
+    projection[0] = f / aspect;
+    projection[5] = f;
+    projection[10] = (farPlane + nearPlane) / (nearPlane - farPlane);
+    projection[11] = -1.0f;
+    projection[14] = 2.0f * farPlane * nearPlane / (nearPlane - farPlane);
+
+    // Rotation about Y by -angle, then translate by -camera
+    float c = std::cos(angle), s = std::sin(angle);
+    float camera[3] = {distance * s, 0.0f, distance * c};
+    std::fill(view, view + 16, 0.0f);
+    view[0] = c;   view[8] = -s;
+    view[5] = 1.0f;
+    view[2] = s;   view[10] = c;
+    view[15] = 1.0f;
+    for (int r = 0; r < 3; r++) {
+        view[12 + r] = -(view[r] * camera[0] + view[4 + r] * camera[1] + view[8 + r] * camera[2]);
+    }
+}
+
+double percentile(std::vector<double> values, double fraction) {
+    std::sort(values.begin(), values.end());
+    return values[std::min(values.size() - 1, static_cast<std::size_t>(fraction * values.size()))];
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Usage: rubik_wall_bench [--cubes N] [--frames F] [--threads T] [--distance D]" << std::endl;
+        return 1;
+    }
+
+    auto buildStart = std::chrono::steady_clock::now();
+    CubeWall wall(options.cubes, 1, options.threads);
+    double buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - buildStart).count();
+    std::cout << wall.size() << " cubes (" << wall.getColumns() << " x " << wall.getRows() << "), "
+              << wall.threadCount() << " threads, built in " << std::fixed << std::setprecision(2) << buildMs << " ms" << std::endl;
+
+    std::vector<double> updateMs, cullMs;
+    double detailed = 0.0, distant = 0.0, culled = 0.0;
+    WallView visible;
+    float projection[16], view[16];
+    float farPlane = options.distance + wall.getExtent() * 2.0f;
+    for (int frame = 0; frame < options.frames; frame++) {
+        auto start = std::chrono::steady_clock::now();
+        wall.update(FRAME_SECONDS);
+        auto updated = std::chrono::steady_clock::now();
+        cameraMatrices(options.distance, 0.6f * std::sin(frame * FRAME_SECONDS * 0.5f), farPlane, projection, view);
+        wall.cull(projection, view, WALL_LOD_DISTANCE, visible);
+        auto culledAt = std::chrono::steady_clock::now();
+
+        updateMs.push_back(std::chrono::duration<double, std::milli>(updated - start).count());
+        cullMs.push_back(std::chrono::duration<double, std::milli>(culledAt - updated).count());
+        detailed += visible.detailed.size();
+        distant += visible.distant.size();
+        culled += visible.culled;
+    }
+
+    double seconds = options.frames * FRAME_SECONDS;
+    std::cout << "update  p50 " << percentile(updateMs, 0.5) << " ms  p99 " << percentile(updateMs, 0.99) << " ms" << std::endl;
+    std::cout << "cull    p50 " << percentile(cullMs, 0.5) << " ms  p99 " << percentile(cullMs, 0.99) << " ms" << std::endl;
+    std::cout << std::setprecision(1) << "per frame: " << detailed / options.frames << " detailed, "
+              << distant / options.frames << " boxes, " << culled / options.frames << " culled" << std::endl;
+    std::cout << "draws: 2 instanced calls, " << std::setprecision(0)
+              << (detailed * 27 * 36 + distant * 36) / options.frames << " vertices per frame" << std::endl;
+    std::cout << "moves: " << wall.getMovesApplied() << " (" << wall.getMovesApplied() / seconds << "/s simulated)" << std::endl;
+
+    double worst = percentile(updateMs, 0.99) + percentile(cullMs, 0.99);
+    std::cout << std::setprecision(2) << "CPU p99 " << worst << " ms of the 16.67 ms frame budget" << std::endl;
+    return 0;
+}